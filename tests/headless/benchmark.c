@@ -0,0 +1,1098 @@
+// Headless benchmark for The Debuginator.
+//
+// Builds synthetic menus of increasing size and times the things a game does at startup, every
+// frame and every keystroke. Results are printed to stdout as one JSON object per line, so they
+// can be diffed or fed into whatever tracks performance over time. Some results also check that
+// things work, and if one of those fails it's printed to stderr and the exit code is 1. Features
+// with more to check than fits in a result have test programs of their own, like staging.c.
+//
+// Usage: benchmark [--sizes 1000,10000,...] [--frames N] [--moves N] [--filter-rounds N]
+
+#define DEBUGINATOR_IMPLEMENTATION
+#include "headless.h"
+
+#define DEBUGINATOR_VERTICES_IMPLEMENTATION
+#include "../../the_debuginator_vertices.h"
+
+#define BENCHMARK_PATH_STRIDE 128
+#define BENCHMARK_LEAVES_PER_FOLDER 24
+#define BENCHMARK_MAX_LOAD_KEYS 2000
+#define BENCHMARK_MAX_FLAT_LEAVES 10000
+#define BENCHMARK_PRESET_ITEMS 200
+#define BENCHMARK_STAGED_ENTITIES 1000
+#define BENCHMARK_STAGED_ITEMS_PER_ENTITY 8
+#define BENCHMARK_STAGING_AREAS 2
+
+static const char* s_systems[] = {
+	"Rendering", "Physics", "Audio", "AI", "Gameplay", "Network", "UI", "Animation",
+	"Particles", "Streaming", "Camera", "Input", "Weather", "Vehicles", "Economy", "Quests",
+};
+
+static const char* s_groups[] = {
+	"Shadows", "Lighting", "Navmesh", "Collision", "Spawning", "Debug", "Profiling", "Cheats",
+	"Terrain", "Foliage", "Water", "Characters", "Weapons", "Inventory", "Dialogue", "Cutscenes",
+	"Effects", "Decals", "Occlusion", "LOD",
+};
+
+static const char* s_verbs[] = {
+	"Show", "Draw", "Enable", "Disable", "Freeze", "Log", "Visualize", "Override", "Force", "Skip", "Toggle", "Limit",
+};
+
+static const char* s_nouns[] = {
+	"bounds", "normals", "wireframe", "paths", "targets", "timers", "budgets", "stats",
+	"spheres", "cascades", "probes", "contacts", "velocities", "states", "queues", "handles",
+};
+
+static const char* s_quality_titles[] = { "Off", "Low", "Medium", "High" };
+static int s_quality_values[] = { 0, 1, 2, 3 };
+static bool s_bool_sink;
+
+#define BENCHMARK_COUNTOF(array) ((int)(sizeof(array) / sizeof(array[0])))
+
+// Printable ASCII in a 16 wide grid, with the same metrics as headless_text_size.
+static DebuginatorGlyph s_glyphs['~' - ' ' + 1];
+static DebuginatorGlyphFont s_glyph_font;
+static DebuginatorVertexFonts s_vertex_fonts;
+
+static void benchmark_init_glyphs(void) {
+	for (int i = 0; i < BENCHMARK_COUNTOF(s_glyphs); ++i) {
+		DebuginatorGlyph* glyph = &s_glyphs[i];
+		glyph->advance = HEADLESS_CHAR_WIDTH;
+		if (i != 0) {
+			glyph->x0 = 1;
+			glyph->y0 = -HEADLESS_CHAR_HEIGHT * 0.75f;
+			glyph->x1 = HEADLESS_CHAR_WIDTH - 1;
+			glyph->y1 = HEADLESS_CHAR_HEIGHT * 0.25f;
+		}
+		glyph->u0 = (float)(i % 16) / 16;
+		glyph->v0 = (float)(i / 16) / 8;
+		glyph->u1 = glyph->u0 + 1 / 16.0f;
+		glyph->v1 = glyph->v0 + 1 / 8.0f;
+	}
+
+	s_glyph_font.glyphs = s_glyphs;
+	s_glyph_font.first_char = ' ';
+	s_glyph_font.num_glyphs = BENCHMARK_COUNTOF(s_glyphs);
+	s_glyph_font.ascent = HEADLESS_CHAR_HEIGHT * 0.75f;
+	s_glyph_font.line_height = HEADLESS_CHAR_HEIGHT;
+	for (int i = 0; i < DEBUGINATOR_NumDrawTypes; ++i) {
+		s_vertex_fonts.fonts[i] = &s_glyph_font;
+	}
+	s_vertex_fonts.white_u = 1.0f - 1 / 32.0f;
+	s_vertex_fonts.white_v = 1.0f - 1 / 16.0f;
+}
+
+// One quad per rect and per printable, non-space character.
+static int benchmark_expected_quads(const DebuginatorDrawCommandBuffer* buffer) {
+	int quads = 0;
+	for (int i = 0; i < buffer->command_count; ++i) {
+		const DebuginatorDrawCommand* command = &buffer->commands[i];
+		if (command->type == DEBUGINATOR_DrawCommandRect) {
+			++quads;
+		}
+		else if (command->type == DEBUGINATOR_DrawCommandText) {
+			for (const char* c = buffer->strings + command->data.text.offset; *c != '\0'; ++c) {
+				quads += *c > ' ' && *c <= '~' ? 1 : 0;
+			}
+		}
+	}
+	return quads;
+}
+
+typedef struct BenchmarkOptions {
+	int sizes[16];
+	int num_sizes;
+	int frames;
+	int moves;
+	int filter_rounds;
+} BenchmarkOptions;
+
+typedef struct SaveBuffer {
+	char* data;
+	size_t size;
+	size_t capacity;
+	int num_keys;
+} SaveBuffer;
+
+// Correctness flags in the results go through here, so that the benchmark fails if one of
+// them isn't what it should be and a smoke run catches it.
+static int s_num_failures;
+
+static const char* benchmark_expect(const char* name, int leaves, const char* flag, bool value, bool expected) {
+	if (value != expected) {
+		fprintf(stderr, "%s with %d leaves: %s is %s\n", name, leaves, flag, value ? "true" : "false");
+		++s_num_failures;
+	}
+	return value ? "true" : "false";
+}
+
+static void benchmark_report(const char* name, int leaves, long long ops, unsigned long long total_ns, const char* extra) {
+	double ns_per_op = ops > 0 ? (double)total_ns / (double)ops : 0.0;
+	printf("{\"case\":\"%s\",\"leaves\":%d,\"ops\":%lld,\"total_ms\":%.3f,\"ns_per_op\":%.1f%s%s}\n",
+		name, leaves, ops, (double)total_ns / 1e6, ns_per_op, extra[0] != '\0' ? "," : "", extra);
+	fflush(stdout);
+}
+
+// Leaves are put in folders of up to 24, and those folders are spread out over the
+// 16 "systems" at the top level, with as many 20-wide levels in between as needed.
+// So 1k leaves gives "System/Group/Item" and 1M gives "System/Group/Set/Set/Set/Item".
+static void benchmark_generate_path(char* path, int leaf_index, int num_leaves) {
+	int num_folders = (num_leaves + BENCHMARK_LEAVES_PER_FOLDER - 1) / BENCHMARK_LEAVES_PER_FOLDER;
+	int folders_per_system = (num_folders + BENCHMARK_COUNTOF(s_systems) - 1) / BENCHMARK_COUNTOF(s_systems);
+	int inner_levels = 1;
+	for (int capacity = BENCHMARK_COUNTOF(s_groups); capacity < folders_per_system; capacity *= BENCHMARK_COUNTOF(s_groups)) {
+		++inner_levels;
+	}
+
+	int folder_index = leaf_index / BENCHMARK_LEAVES_PER_FOLDER;
+	int item_index = leaf_index % BENCHMARK_LEAVES_PER_FOLDER;
+	int system_index = folder_index % BENCHMARK_COUNTOF(s_systems);
+	int inner_index = folder_index / BENCHMARK_COUNTOF(s_systems);
+
+	int length = sprintf(path, "%s", s_systems[system_index]);
+	for (int level = 0; level < inner_levels; ++level) {
+		int digit = inner_index % BENCHMARK_COUNTOF(s_groups);
+		inner_index /= BENCHMARK_COUNTOF(s_groups);
+		if (level == 0) {
+			length += sprintf(path + length, "/%s", s_groups[digit]);
+		}
+		else {
+			length += sprintf(path + length, "/Set %02d", digit);
+		}
+	}
+
+	// Unique within the folder since item_index < 2 * number of verbs.
+	const char* verb = s_verbs[item_index % BENCHMARK_COUNTOF(s_verbs)];
+	const char* noun = s_nouns[(item_index / BENCHMARK_COUNTOF(s_verbs) + folder_index * 3) % BENCHMARK_COUNTOF(s_nouns)];
+	sprintf(path + length, "/%s %s", verb, noun);
+}
+
+static void benchmark_create_leaf(struct TheDebuginator* debuginator, const char* path, int leaf_index) {
+	switch (leaf_index % 8) {
+		case 0:
+			debuginator_create_array_item(debuginator, NULL, path,
+				"Quality level for this system.", NULL, NULL,
+				s_quality_titles, (void*)s_quality_values, 4, sizeof(s_quality_values[0]));
+			break;
+		case 1:
+			debuginator_create_bool_item(debuginator, path, "Toggles the visualization for this system.", &s_bool_sink);
+			break;
+		default:
+			debuginator_create_bool_item(debuginator, path, NULL, &s_bool_sink);
+			break;
+	}
+}
+
+static bool benchmark_save_callback(const char* key, const char* value, void* userdata) {
+	SaveBuffer* buffer = (SaveBuffer*)userdata;
+	size_t key_length = strlen(key);
+	size_t value_length = strlen(value);
+	if (buffer->size + key_length + value_length + 2 > buffer->capacity) {
+		return false;
+	}
+
+	memcpy(buffer->data + buffer->size, key, key_length);
+	buffer->size += key_length;
+	buffer->data[buffer->size++] = '=';
+	memcpy(buffer->data + buffer->size, value, value_length);
+	buffer->size += value_length;
+	buffer->data[buffer->size++] = '\n';
+	buffer->num_keys++;
+	return true;
+}
+
+static int benchmark_count_items(DebuginatorItem* item) {
+	int count = 1;
+	if (item->is_folder) {
+		for (DebuginatorItem* child = item->folder.first_child; child != NULL; child = child->next_sibling) {
+			count += benchmark_count_items(child);
+		}
+	}
+	return count;
+}
+
+static void benchmark_size(const BenchmarkOptions* options, int num_leaves) {
+	char extra[256];
+
+	char* paths = (char*)malloc((size_t)num_leaves * BENCHMARK_PATH_STRIDE);
+	for (int i = 0; i < num_leaves; ++i) {
+		benchmark_generate_path(paths + (size_t)i * BENCHMARK_PATH_STRIDE, i, num_leaves);
+	}
+
+	// Generous, the point is to measure how much is actually used.
+	struct TheDebuginator* debuginator = headless_create((unsigned int)num_leaves * 512 + 16 * 1024 * 1024, false);
+
+	//
+	// Creation. The bools' default values come from their targets, which the previous size changed.
+	s_bool_sink = false;
+	unsigned long long start = headless_time_ns();
+	for (int i = 0; i < num_leaves; ++i) {
+		benchmark_create_leaf(debuginator, paths + (size_t)i * BENCHMARK_PATH_STRIDE, i);
+	}
+	unsigned long long create_ns = headless_time_ns() - start;
+	benchmark_report("create", num_leaves, num_leaves, create_ns, "");
+
+	//
+	// Memory
+	{
+		int num_items = benchmark_count_items(debuginator->root);
+		char* first_block = (char*)((((DEBUGINATOR_intptr)debuginator->memory_arena + DEBUGINATOR_ALLOCATOR_BLOCK_SIZE - 1) / DEBUGINATOR_ALLOCATOR_BLOCK_SIZE) * DEBUGINATOR_ALLOCATOR_BLOCK_SIZE);
+		size_t arena_used = (size_t)(debuginator->allocator_data.next_free_block - first_block);
+		size_t allocated = 0;
+		for (int i = 0; i < BENCHMARK_COUNTOF(debuginator->allocators); ++i) {
+			allocated += debuginator->allocators[i].stat_total_used;
+		}
+
+		printf("{\"case\":\"arena\",\"leaves\":%d,\"items\":%d,\"arena_bytes\":%llu,\"allocated_bytes\":%llu,\"arena_bytes_per_item\":%.1f,\"allocated_bytes_per_item\":%.1f}\n",
+			num_leaves, num_items, (unsigned long long)arena_used, (unsigned long long)allocated,
+			(double)arena_used / num_items, (double)allocated / num_items);
+	}
+
+	//
+	// Frames. Put the hot item in the middle of the menu so there's something above and below it.
+	debuginator_set_open(debuginator, true);
+	headless_run_frames(debuginator, 30);
+	DebuginatorItem* middle_item = debuginator_get_item(debuginator, NULL, paths + (size_t)(num_leaves / 2) * BENCHMARK_PATH_STRIDE, NULL);
+	debuginator_set_hot_item(debuginator, middle_item);
+	headless_run_frames(debuginator, 30);
+
+	{
+		HeadlessCallCounts calls_before = g_headless_calls;
+		start = headless_time_ns();
+		headless_run_frames(debuginator, options->frames);
+		unsigned long long frames_ns = headless_time_ns() - start;
+		sprintf(extra, "\"draw_rect_per_frame\":%.1f,\"draw_text_per_frame\":%.1f,\"text_size_per_frame\":%.1f,\"word_wrap_per_frame\":%.1f",
+			(double)(g_headless_calls.draw_rect - calls_before.draw_rect) / options->frames,
+			(double)(g_headless_calls.draw_text - calls_before.draw_text) / options->frames,
+			(double)(g_headless_calls.text_size - calls_before.text_size) / options->frames,
+			(double)(g_headless_calls.word_wrap - calls_before.word_wrap) / options->frames);
+		benchmark_report("update_draw", num_leaves, options->frames, frames_ns, extra);
+	}
+
+	{
+		// With the hot item expanded, which draws its description, and the mouse over it
+		// for the tooltip.
+		DebuginatorItem* described_item = debuginator_get_item(debuginator, NULL, paths + (size_t)(num_leaves / 2 / 8 * 8) * BENCHMARK_PATH_STRIDE, NULL);
+		debuginator_set_hot_item(debuginator, described_item);
+		debuginator_move_to_child(debuginator, true);
+		headless_run_frames(debuginator, 30);
+		DebuginatorVector2 mouse_pos = debuginator__vector2(debuginator->top_left.x + 100, debuginator->size.y * debuginator->focus_height + DEBUGINATOR_FILTER_HEIGHT + 4);
+		debuginator_set_mouse_cursor_pos(debuginator, &mouse_pos);
+
+		// Wait out the tooltip's delay and fade in, at 60 frames per second.
+		headless_run_frames(debuginator, (int)((DEBUGINATOR_TOOLTIP_FADEIN - DEBUGINATOR_TOOLTIP_DELAY) * 60) + 1);
+
+		HeadlessCallCounts calls_before = g_headless_calls;
+		start = headless_time_ns();
+		headless_run_frames(debuginator, options->frames);
+		unsigned long long frames_ns = headless_time_ns() - start;
+		sprintf(extra, "\"expanded\":%s,\"tooltip\":%s,\"word_wrap_per_frame\":%.1f",
+			benchmark_expect("update_draw_expanded", num_leaves, "expanded", described_item->leaf.is_expanded, true),
+			benchmark_expect("update_draw_expanded", num_leaves, "tooltip", debuginator->hot_mouse_item == described_item && debuginator->tooltip_timer > 0, true),
+			(double)(g_headless_calls.word_wrap - calls_before.word_wrap) / options->frames);
+		benchmark_report("update_draw_expanded", num_leaves, options->frames, frames_ns, extra);
+
+		debuginator_move_to_parent(debuginator);
+		mouse_pos = debuginator__vector2(-1000, -1000);
+		debuginator_set_mouse_cursor_pos(debuginator, &mouse_pos);
+		debuginator_set_hot_item(debuginator, middle_item);
+		headless_run_frames(debuginator, 30);
+	}
+
+	{
+		// The next dozen items with descriptions from the middle item's folder on, expanded, on a
+		// 4K screen with small items so that they're all on screen at once. That's more than the
+		// word wrap cache's minimum size, and none of them should be wrapped again.
+		DebuginatorItem* expanded_items[12];
+		int num_expanded = 0;
+		DebuginatorItem* item = debuginator__find_first_leaf(middle_item->parent);
+		for (; item != NULL && num_expanded < BENCHMARK_COUNTOF(expanded_items); item = debuginator__next_visible_item(item)) {
+			if (!item->is_folder && item->leaf.description[0] != '\0') {
+				item->leaf.is_expanded = true;
+				debuginator__invalidate_layout(debuginator, item);
+				expanded_items[num_expanded++] = item;
+			}
+		}
+
+		debuginator_set_size(debuginator, 500, 2160);
+		debuginator_set_screen_resolution(debuginator, 3840, 2160);
+		debuginator_set_item_height(debuginator, 16);
+		debuginator_set_hot_item(debuginator, expanded_items[0]);
+		headless_run_frames(debuginator, 30);
+
+		int on_screen = 0;
+		for (int i = 0; i < num_expanded; ++i) {
+			float top = debuginator->current_height_offset + debuginator__distance_to_item_uncached(debuginator, expanded_items[i]) - debuginator->item_height;
+			on_screen += top >= 0 && top + expanded_items[i]->total_height <= debuginator->size.y ? 1 : 0;
+		}
+
+		HeadlessCallCounts calls_before = g_headless_calls;
+		start = headless_time_ns();
+		headless_run_frames(debuginator, options->frames);
+		unsigned long long frames_ns = headless_time_ns() - start;
+		unsigned long long word_wraps = g_headless_calls.word_wrap - calls_before.word_wrap;
+		sprintf(extra, "\"expanded_on_screen\":%d,\"all_on_screen\":%s,\"word_wrap_per_frame\":%.1f,\"no_rewraps\":%s",
+			on_screen, benchmark_expect("update_draw_expanded_many", num_leaves, "all_on_screen", on_screen == num_expanded && on_screen >= 10, true),
+			(double)word_wraps / options->frames, benchmark_expect("update_draw_expanded_many", num_leaves, "no_rewraps", word_wraps == 0, true));
+		benchmark_report("update_draw_expanded_many", num_leaves, options->frames, frames_ns, extra);
+
+		for (int i = 0; i < num_expanded; ++i) {
+			expanded_items[i]->leaf.is_expanded = false;
+			debuginator__invalidate_layout(debuginator, expanded_items[i]);
+		}
+		debuginator_set_size(debuginator, 500, 1080);
+		debuginator_set_screen_resolution(debuginator, 1920, 1080);
+		debuginator_set_item_height(debuginator, 32);
+		debuginator_set_hot_item(debuginator, middle_item);
+		headless_run_frames(debuginator, 30);
+	}
+
+	{
+		// Hot key labels on the middle item's folder, and the search box in exact search mode.
+		// Setting the filter without debuginator_update_filter leaves the items as they are.
+		int first_sibling = num_leaves / 2 / BENCHMARK_LEAVES_PER_FOLDER * BENCHMARK_LEAVES_PER_FOLDER;
+		for (int i = 0; i < 8 && first_sibling + i < num_leaves; ++i) {
+			char key[8];
+			sprintf(key, "F%d", i + 1);
+			debuginator_assign_hot_key(debuginator, key, paths + (size_t)(first_sibling + i) * BENCHMARK_PATH_STRIDE, i % 2 == 0 ? 0 : DEBUGINATOR_NO_HOT_INDEX, NULL);
+		}
+		debuginator_set_filtering_enabled(debuginator, true);
+		debuginator_set_filter(debuginator, "show bounds");
+		headless_run_frames(debuginator, 30);
+
+		HeadlessCallCounts calls_before = g_headless_calls;
+		start = headless_time_ns();
+		headless_run_frames(debuginator, options->frames);
+		unsigned long long frames_ns = headless_time_ns() - start;
+		sprintf(extra, "\"hot_keys\":%d,\"text_size_per_frame\":%.1f",
+			debuginator->num_hot_keys, (double)(g_headless_calls.text_size - calls_before.text_size) / options->frames);
+		benchmark_report("update_draw_labels", num_leaves, options->frames, frames_ns, extra);
+
+		debuginator_clear_hot_keys(debuginator);
+		debuginator_set_filter(debuginator, "");
+		debuginator_set_filtering_enabled(debuginator, false);
+		headless_run_frames(debuginator, 30);
+	}
+
+	{
+		DebuginatorDrawCommandBuffer command_buffer;
+		memset(&command_buffer, 0, sizeof(command_buffer));
+		command_buffer.commands_capacity = 4096;
+		command_buffer.commands = (DebuginatorDrawCommand*)malloc(sizeof(DebuginatorDrawCommand) * (size_t)command_buffer.commands_capacity);
+		command_buffer.strings_capacity = 64 * 1024;
+		command_buffer.strings = (char*)malloc((size_t)command_buffer.strings_capacity);
+		debuginator_set_draw_command_buffer(debuginator, &command_buffer);
+
+		HeadlessCallCounts calls_before = g_headless_calls;
+		start = headless_time_ns();
+		headless_run_frames(debuginator, options->frames);
+		unsigned long long frames_ns = headless_time_ns() - start;
+		unsigned long long recorded_draw_calls = g_headless_calls.draw_rect + g_headless_calls.draw_text - calls_before.draw_rect - calls_before.draw_text;
+
+		// Submitting one frame should match what the callbacks would have gotten.
+		calls_before = g_headless_calls;
+		debuginator_submit_draw_commands(debuginator, &command_buffer);
+		sprintf(extra, "\"commands_per_frame\":%d,\"string_bytes_per_frame\":%d,\"overflowed\":%s,\"draw_calls_while_recording\":%llu,\"draw_calls_submitted\":%llu",
+			command_buffer.command_count, command_buffer.strings_size, benchmark_expect("update_draw_commands", num_leaves, "overflowed", command_buffer.overflowed, false), recorded_draw_calls,
+			g_headless_calls.draw_rect + g_headless_calls.draw_text - calls_before.draw_rect - calls_before.draw_text);
+		benchmark_report("update_draw_commands", num_leaves, options->frames, frames_ns, extra);
+
+		// A buffer that runs out of string space should keep the frame up to there, and nothing
+		// after it.
+		DebuginatorDrawCommandBuffer small_buffer = command_buffer;
+		small_buffer.commands = (DebuginatorDrawCommand*)malloc(sizeof(DebuginatorDrawCommand) * (size_t)small_buffer.commands_capacity);
+		small_buffer.strings_capacity = command_buffer.strings_size / 2;
+		debuginator_set_draw_command_buffer(debuginator, &small_buffer);
+		debuginator_draw(debuginator, 0);
+		bool overflow_is_prefix = small_buffer.overflowed && small_buffer.command_count < command_buffer.command_count
+			&& memcmp(small_buffer.commands, command_buffer.commands, sizeof(DebuginatorDrawCommand) * (size_t)small_buffer.command_count) == 0;
+		sprintf(extra, "\"commands\":%d,\"overflow_is_prefix\":%s", small_buffer.command_count,
+			benchmark_expect("draw_commands_overflow", num_leaves, "overflow_is_prefix", overflow_is_prefix, true));
+		benchmark_report("draw_commands_overflow", num_leaves, 1, 0, extra);
+		free(small_buffer.commands);
+		debuginator_set_draw_command_buffer(debuginator, &command_buffer);
+		debuginator_draw(debuginator, 0);
+
+		// The same frame as one vertex buffer.
+		DebuginatorVertexBuffer vertex_buffer;
+		memset(&vertex_buffer, 0, sizeof(vertex_buffer));
+		vertex_buffer.vertices_capacity = 64 * 1024;
+		vertex_buffer.vertices = (DebuginatorVertex*)malloc(sizeof(DebuginatorVertex) * (size_t)vertex_buffer.vertices_capacity);
+		vertex_buffer.indices_capacity = 96 * 1024;
+		vertex_buffer.indices = (unsigned int*)malloc(sizeof(unsigned int) * (size_t)vertex_buffer.indices_capacity);
+		start = headless_time_ns();
+		for (int i = 0; i < options->frames; ++i) {
+			debuginator_vertices_build(&command_buffer, &s_vertex_fonts, &vertex_buffer);
+		}
+		frames_ns = headless_time_ns() - start;
+		sprintf(extra, "\"quads_per_frame\":%d,\"matches_commands\":%s,\"overflowed\":%s",
+			vertex_buffer.vertex_count / 4,
+			benchmark_expect("build_vertices", num_leaves, "matches_commands", vertex_buffer.vertex_count / 4 == benchmark_expected_quads(&command_buffer), true),
+			benchmark_expect("build_vertices", num_leaves, "overflowed", vertex_buffer.overflowed, false));
+		benchmark_report("build_vertices", num_leaves, options->frames, frames_ns, extra);
+		free(vertex_buffer.vertices);
+		free(vertex_buffer.indices);
+
+		// Idle frames with retained drawing. Afterwards, the retained commands should be
+		// exactly what a full redraw gives.
+		debuginator_set_retained_drawing(debuginator, true);
+		int redraws = 0;
+		start = headless_time_ns();
+		for (int i = 0; i < options->frames; ++i) {
+			debuginator_update(debuginator, 1 / 60.0f);
+			redraws += debuginator_needs_redraw(debuginator) ? 1 : 0;
+			debuginator_draw(debuginator, 1 / 60.0f);
+		}
+		frames_ns = headless_time_ns() - start;
+
+		int retained_count = command_buffer.command_count;
+		DebuginatorDrawCommand* retained_commands = (DebuginatorDrawCommand*)malloc(sizeof(DebuginatorDrawCommand) * (size_t)retained_count);
+		memcpy(retained_commands, command_buffer.commands, sizeof(DebuginatorDrawCommand) * (size_t)retained_count);
+		debuginator_invalidate_draw_list(debuginator);
+		debuginator_draw(debuginator, 0);
+		bool matches_redraw = retained_count == command_buffer.command_count
+			&& memcmp(retained_commands, command_buffer.commands, sizeof(DebuginatorDrawCommand) * (size_t)retained_count) == 0;
+		free(retained_commands);
+
+		// And with the mouse resting on an item, whose highlight fades in.
+		DebuginatorVector2 mouse_pos = debuginator__vector2(debuginator->top_left.x + 100, debuginator->size.y * debuginator->focus_height + DEBUGINATOR_FILTER_HEIGHT + 4);
+		debuginator_set_mouse_cursor_pos(debuginator, &mouse_pos);
+		headless_run_frames(debuginator, 10);
+		retained_count = command_buffer.command_count;
+		retained_commands = (DebuginatorDrawCommand*)malloc(sizeof(DebuginatorDrawCommand) * (size_t)retained_count);
+		memcpy(retained_commands, command_buffer.commands, sizeof(DebuginatorDrawCommand) * (size_t)retained_count);
+		debuginator_invalidate_draw_list(debuginator);
+		debuginator_draw(debuginator, 0);
+		bool matches_redraw_with_mouse = retained_count == command_buffer.command_count
+			&& memcmp(retained_commands, command_buffer.commands, sizeof(DebuginatorDrawCommand) * (size_t)retained_count) == 0;
+		free(retained_commands);
+		mouse_pos = debuginator__vector2(-1000, -1000);
+		debuginator_set_mouse_cursor_pos(debuginator, &mouse_pos);
+
+		sprintf(extra, "\"redraws\":%d,\"matches_full_redraw\":%s,\"matches_full_redraw_with_mouse\":%s", redraws,
+			benchmark_expect("update_draw_retained", num_leaves, "matches_full_redraw", matches_redraw, true),
+			benchmark_expect("update_draw_retained", num_leaves, "matches_full_redraw_with_mouse", matches_redraw_with_mouse, true));
+		benchmark_report("update_draw_retained", num_leaves, options->frames, frames_ns, extra);
+
+		debuginator_set_retained_drawing(debuginator, false);
+		debuginator_set_draw_command_buffer(debuginator, NULL);
+		free(command_buffer.commands);
+		free(command_buffer.strings);
+	}
+
+	//
+	// Navigation
+	{
+		debuginator_set_hot_item(debuginator, middle_item);
+		start = headless_time_ns();
+		for (int i = 0; i < options->moves; ++i) {
+			debuginator_move_to_next_leaf(debuginator, false);
+		}
+		benchmark_report("move_next_leaf", num_leaves, options->moves, headless_time_ns() - start, "");
+
+		start = headless_time_ns();
+		for (int i = 0; i < options->moves; ++i) {
+			debuginator_move_to_prev_leaf(debuginator, false);
+		}
+		benchmark_report("move_prev_leaf", num_leaves, options->moves, headless_time_ns() - start, "");
+
+		start = headless_time_ns();
+		for (int i = 0; i < options->moves; ++i) {
+			debuginator_move_sibling_next(debuginator);
+		}
+		benchmark_report("move_sibling_next", num_leaves, options->moves, headless_time_ns() - start, "");
+
+		debuginator_set_hot_item(debuginator, middle_item);
+		start = headless_time_ns();
+		for (int i = 0; i < options->moves; ++i) {
+			debuginator_move_to_parent(debuginator);
+			debuginator_move_to_child(debuginator, false);
+		}
+		benchmark_report("move_parent_child", num_leaves, options->moves * 2LL, headless_time_ns() - start, "");
+	}
+
+	//
+	// Filtering, typing a query one letter at a time and then erasing it.
+	{
+		const char* query = "show bounds";
+		int query_length = (int)strlen(query);
+		char typed[DEBUGINATOR_FILTER_MAX_LENGTH];
+		long long keystrokes = 0;
+		start = headless_time_ns();
+		for (int round = 0; round < options->filter_rounds; ++round) {
+			for (int i = 1; i <= query_length; ++i, ++keystrokes) {
+				memcpy(typed, query, (size_t)i);
+				typed[i] = '\0';
+				debuginator_update_filter(debuginator, typed);
+			}
+			for (int i = query_length - 1; i >= 0; --i, ++keystrokes) {
+				typed[i] = '\0';
+				debuginator_update_filter(debuginator, typed);
+			}
+		}
+		benchmark_report("filter_keystroke", num_leaves, keystrokes, headless_time_ns() - start, "");
+	}
+
+	//
+	// Saving. Change a few percent of the items so there's something to save.
+	SaveBuffer save_buffer;
+	save_buffer.capacity = (size_t)num_leaves * 16 + 4096;
+	save_buffer.data = (char*)malloc(save_buffer.capacity);
+	save_buffer.size = 0;
+	save_buffer.num_keys = 0;
+	for (int i = 0; i < num_leaves; i += 37) {
+		DebuginatorItem* item = debuginator_get_item(debuginator, NULL, paths + (size_t)i * BENCHMARK_PATH_STRIDE, NULL);
+		item->leaf.hot_index = 1;
+		debuginator_activate(debuginator, item, false);
+	}
+
+	{
+		start = headless_time_ns();
+		bool saved = debuginator_save(debuginator, benchmark_save_callback, &save_buffer);
+		unsigned long long save_ns = headless_time_ns() - start;
+		sprintf(extra, "\"saved\":%s,\"keys\":%d,\"bytes\":%llu", benchmark_expect("save", num_leaves, "saved", saved, true), save_buffer.num_keys, (unsigned long long)save_buffer.size);
+		benchmark_report("save", num_leaves, num_leaves, save_ns, extra);
+	}
+
+	//
+	// The same in the binary format, sized up front with a query instead of a guess.
+	{
+		int needed = 0;
+		start = headless_time_ns();
+		debuginator_save_binary(debuginator, NULL, 0, &needed);
+		unsigned long long query_ns = headless_time_ns() - start;
+
+		char* binary = (char*)malloc((size_t)needed);
+		start = headless_time_ns();
+		debuginator_save_binary(debuginator, binary, needed, NULL);
+		unsigned long long save_ns = headless_time_ns() - start;
+		sprintf(extra, "\"bytes\":%d,\"query_ms\":%.3f", needed, (double)query_ns / 1e6);
+		benchmark_report("save_binary", num_leaves, num_leaves, save_ns, extra);
+
+		// Loading it back after a reset. Capped like load_item below.
+		if (save_buffer.num_keys <= BENCHMARK_MAX_LOAD_KEYS) {
+			debuginator_reset_items_recursively(debuginator, debuginator->root);
+			start = headless_time_ns();
+			debuginator_load_binary(debuginator, binary, needed);
+			benchmark_report("load_binary", num_leaves, save_buffer.num_keys, headless_time_ns() - start, "");
+		}
+
+		free(binary);
+	}
+
+	//
+	// Bulk loading the saved settings back in. Capped since loaded settings are kept in a
+	// single arena allocation.
+	{
+		const char* keys[BENCHMARK_MAX_LOAD_KEYS];
+		const char* values[BENCHMARK_MAX_LOAD_KEYS];
+		int num_keys = 0;
+		char* line = save_buffer.data;
+		char* end = save_buffer.data + save_buffer.size;
+		while (line < end && num_keys < BENCHMARK_MAX_LOAD_KEYS) {
+			char* separator = (char*)memchr(line, '=', (size_t)(end - line));
+			char* newline = (char*)memchr(line, '\n', (size_t)(end - line));
+			*separator = '\0';
+			*newline = '\0';
+			keys[num_keys] = line;
+			values[num_keys] = separator + 1;
+			++num_keys;
+			line = newline + 1;
+		}
+
+		start = headless_time_ns();
+		for (int i = 0; i < num_keys; ++i) {
+			debuginator_load_item(debuginator, keys[i], values[i]);
+		}
+		benchmark_report("load_item", num_leaves, num_keys, headless_time_ns() - start, "");
+	}
+
+	free(save_buffer.data);
+	headless_destroy(debuginator);
+	free(paths);
+}
+
+// What debuginator_get_item_at_y should return, by stepping through everything above y.
+static DebuginatorItem* benchmark_item_at_y_linear(DebuginatorItem* folder, float offset, float y, int item_height) {
+	for (DebuginatorItem* child = folder->folder.first_child; child != NULL && !folder->folder.is_collapsed; child = child->next_sibling) {
+		if (!debuginator__is_visible(child)) {
+			continue;
+		}
+
+		if (y < offset + child->total_height) {
+			if (child->is_folder && y >= offset + item_height) {
+				return benchmark_item_at_y_linear(child, offset + item_height, y, item_height);
+			}
+			return child;
+		}
+		offset += child->total_height;
+	}
+	return NULL;
+}
+
+// What debuginator__distance_to_item_uncached should return, by adding up every visible item
+// before it.
+static int benchmark_distance_linear(struct TheDebuginator* debuginator, DebuginatorItem* item) {
+	int distance = debuginator->item_height;
+	for (DebuginatorItem* ancestor = item; ancestor != debuginator->root; ancestor = ancestor->parent) {
+		for (DebuginatorItem* sibling = ancestor->parent->folder.first_child; sibling != ancestor; sibling = sibling->next_sibling) {
+			distance += debuginator__is_visible(sibling) ? sibling->total_height : 0;
+		}
+		distance += ancestor->parent != debuginator->root ? debuginator->item_height : 0;
+	}
+	return distance;
+}
+
+// A single folder with lots of leaves, scrolled all the way down, which is the worst case
+// for finding the first item to draw. Capped since adding to a folder is linear in its size.
+static void benchmark_flat_folder(const BenchmarkOptions* options, int num_leaves) {
+	num_leaves = num_leaves < BENCHMARK_MAX_FLAT_LEAVES ? num_leaves : BENCHMARK_MAX_FLAT_LEAVES;
+	struct TheDebuginator* debuginator = headless_create((unsigned int)num_leaves * 512 + 16 * 1024 * 1024, false);
+
+	char path[BENCHMARK_PATH_STRIDE];
+	for (int i = 0; i < num_leaves; ++i) {
+		sprintf(path, "Flat/Item %06d", i);
+		debuginator_create_bool_item(debuginator, path, NULL, &s_bool_sink);
+	}
+
+	debuginator_set_open(debuginator, true);
+	debuginator_set_hot_item(debuginator, debuginator_get_item(debuginator, NULL, path, NULL));
+	headless_run_frames(debuginator, 60);
+
+	HeadlessCallCounts calls_before = g_headless_calls;
+	unsigned long long start = headless_time_ns();
+	for (int i = 0; i < options->frames; ++i) {
+		debuginator_draw(debuginator, 1 / 60.0f);
+	}
+	unsigned long long frames_ns = headless_time_ns() - start;
+
+	char extra[256];
+	sprintf(extra, "\"draw_rect_per_frame\":%.1f,\"draw_text_per_frame\":%.1f",
+		(double)(g_headless_calls.draw_rect - calls_before.draw_rect) / options->frames,
+		(double)(g_headless_calls.draw_text - calls_before.draw_text) / options->frames);
+	benchmark_report("draw_flat_folder", num_leaves, options->frames, frames_ns, extra);
+
+	// Expanding and collapsing items all over the folder. Only the height index entries after
+	// the item move, which should give the same index as building it again.
+	DebuginatorItem* folder = debuginator_get_item(debuginator, NULL, "Flat", NULL);
+	unsigned long long toggle_ns = 0;
+	for (int i = 0; i < options->frames; ++i) {
+		sprintf(path, "Flat/Item %06d", (int)((long long)i * num_leaves / options->frames));
+		DebuginatorItem* item = debuginator_get_item(debuginator, NULL, path, NULL);
+		start = headless_time_ns();
+		debuginator_set_hot_item(debuginator, item);
+		debuginator_move_to_child(debuginator, true);
+		debuginator_update(debuginator, 1 / 60.0f);
+		if (i % 2 == 0) {
+			debuginator_move_to_parent(debuginator);
+			debuginator_update(debuginator, 1 / 60.0f);
+		}
+		toggle_ns += headless_time_ns() - start;
+	}
+
+	bool index_matches = false;
+	DebuginatorHeightIndex* index = folder->folder.height_index;
+	if (index != NULL && !index->is_dirty) {
+		int count = index->count;
+		DebuginatorHeightIndexEntry* entries = (DebuginatorHeightIndexEntry*)malloc(sizeof(DebuginatorHeightIndexEntry) * (size_t)count);
+		memcpy(entries, index->entries, sizeof(DebuginatorHeightIndexEntry) * (size_t)count);
+		debuginator__build_height_index(debuginator, folder);
+		index_matches = count == index->count && memcmp(entries, index->entries, sizeof(DebuginatorHeightIndexEntry) * (size_t)count) == 0;
+		free(entries);
+	}
+
+	// Finding the item at a y all over the folder, against stepping through all of them.
+	int num_queries = 1000;
+	bool rows_match = true;
+	unsigned long long query_ns = 0;
+	float top = debuginator->current_height_offset;
+	float height = (float)debuginator_total_height(debuginator);
+	for (int i = 0; i < num_queries; ++i) {
+		float y = top + height * i / num_queries + 0.5f;
+		start = headless_time_ns();
+		DebuginatorItem* item = debuginator_get_item_at_y(debuginator, y, NULL);
+		query_ns += headless_time_ns() - start;
+		rows_match = rows_match && item == benchmark_item_at_y_linear(debuginator->root, top, y, debuginator->item_height);
+	}
+
+	// How far down items are, which scrolling to the hot item needs after every change.
+	bool distances_match = true;
+	unsigned long long distance_ns = 0;
+	for (int i = 0; i < num_queries; ++i) {
+		sprintf(path, "Flat/Item %06d", (int)((long long)i * num_leaves / num_queries));
+		DebuginatorItem* item = debuginator_get_item(debuginator, NULL, path, NULL);
+		start = headless_time_ns();
+		int distance = debuginator__distance_to_item_uncached(debuginator, item);
+		distance_ns += headless_time_ns() - start;
+		distances_match = distances_match && distance == benchmark_distance_linear(debuginator, item);
+	}
+
+	sprintf(extra, "\"index_matches_rebuild\":%s,\"query_ms\":%.3f,\"rows_match\":%s,\"distance_ms\":%.3f,\"distances_match\":%s",
+		benchmark_expect("toggle_flat_folder", num_leaves, "index_matches_rebuild", index_matches, true), (double)query_ns / 1e6,
+		benchmark_expect("toggle_flat_folder", num_leaves, "rows_match", rows_match, true), (double)distance_ns / 1e6,
+		benchmark_expect("toggle_flat_folder", num_leaves, "distances_match", distances_match, true));
+	benchmark_report("toggle_flat_folder", num_leaves, options->frames, toggle_ns, extra);
+
+	headless_destroy(debuginator);
+}
+
+typedef struct CallbackCounts {
+	int calls;
+} CallbackCounts;
+
+static CallbackCounts s_callback_counts;
+
+static void benchmark_count_callback(DebuginatorItem* item, void* value, const char* value_title, void* app_userdata) {
+	(void)item;
+	(void)value;
+	(void)value_title;
+	(void)app_userdata;
+	++s_callback_counts.calls;
+}
+
+// Two presets setting the same 200 items, one after the other, like a quick change of mind.
+// Right away, that's 400 callbacks in the middle of input handling. Put off, it's 200. That
+// they get the values that stuck is checked in callbacks.c.
+static void benchmark_presets(const BenchmarkOptions* options) {
+	struct TheDebuginator* debuginator = headless_create(16 * 1024 * 1024, false);
+
+	static char paths[BENCHMARK_PRESET_ITEMS][BENCHMARK_PATH_STRIDE];
+	static const char* path_list[BENCHMARK_PRESET_ITEMS];
+	static const char* high_titles[BENCHMARK_PRESET_ITEMS];
+	static const char* low_titles[BENCHMARK_PRESET_ITEMS];
+	for (int i = 0; i < BENCHMARK_PRESET_ITEMS; ++i) {
+		sprintf(paths[i], "Presets/Quality %03d", i);
+		path_list[i] = paths[i];
+		high_titles[i] = "High";
+		low_titles[i] = "Low";
+		debuginator_create_array_item(debuginator, NULL, paths[i], NULL, benchmark_count_callback, NULL,
+			s_quality_titles, (void*)s_quality_values, 4, sizeof(s_quality_values[0]));
+	}
+
+	DebuginatorItem* high_preset = debuginator_create_preset_item(debuginator, "Presets High", path_list, high_titles, NULL, BENCHMARK_PRESET_ITEMS);
+	DebuginatorItem* low_preset = debuginator_create_preset_item(debuginator, "Presets Low", path_list, low_titles, NULL, BENCHMARK_PRESET_ITEMS);
+
+	char extra[256];
+	memset(&s_callback_counts, 0, sizeof(s_callback_counts));
+	unsigned long long start = headless_time_ns();
+	for (int i = 0; i < options->frames; ++i) {
+		debuginator_activate(debuginator, high_preset, false);
+		debuginator_activate(debuginator, low_preset, false);
+	}
+	unsigned long long activate_ns = headless_time_ns() - start;
+	sprintf(extra, "\"callbacks_per_op\":%.1f", (double)s_callback_counts.calls / options->frames);
+	benchmark_report("activate_presets", BENCHMARK_PRESET_ITEMS, options->frames, activate_ns, extra);
+
+	static DebuginatorItem* pending_items[BENCHMARK_PRESET_ITEMS * 2];
+	DebuginatorCallbackBuffer callback_buffer;
+	memset(&callback_buffer, 0, sizeof(callback_buffer));
+	callback_buffer.items = pending_items;
+	callback_buffer.capacity = BENCHMARK_COUNTOF(pending_items);
+	debuginator_set_callback_buffer(debuginator, &callback_buffer);
+
+	memset(&s_callback_counts, 0, sizeof(s_callback_counts));
+	unsigned long long run_ns = 0;
+	int pending_after_activate = 0;
+	start = headless_time_ns();
+	for (int i = 0; i < options->frames; ++i) {
+		debuginator_activate(debuginator, high_preset, false);
+		debuginator_activate(debuginator, low_preset, false);
+		pending_after_activate = callback_buffer.count;
+		unsigned long long run_start = headless_time_ns();
+		debuginator_run_callbacks(debuginator);
+		run_ns += headless_time_ns() - run_start;
+	}
+	activate_ns = headless_time_ns() - start - run_ns;
+
+	sprintf(extra, "\"callbacks_per_op\":%.1f,\"pending_after_activate\":%d,\"run_ms\":%.3f",
+		(double)s_callback_counts.calls / options->frames, pending_after_activate, (double)run_ns / 1e6);
+	benchmark_report("activate_presets_deferred", BENCHMARK_PRESET_ITEMS, options->frames, activate_ns, extra);
+
+	debuginator_set_callback_buffer(debuginator, NULL);
+	headless_destroy(debuginator);
+}
+
+// What a game thread polling its settings pays per read. That it reads what was activated is
+// checked in published.c.
+static void benchmark_published_values(const BenchmarkOptions* options) {
+	struct TheDebuginator* debuginator = headless_create(4 * 1024 * 1024, false);
+
+	DebuginatorPublishedValue published_bool;
+	DebuginatorPublishedValue published_quality;
+	memset(&published_bool, 0, sizeof(published_bool));
+	memset(&published_quality, 0, sizeof(published_quality));
+	DebuginatorItem* bool_item = debuginator_create_published_bool_item(debuginator, "Published/Bool", NULL, &published_bool);
+	DebuginatorItem* quality_item = debuginator_create_array_item(debuginator, NULL, "Published/Quality", NULL, debuginator_publish_value, &published_quality,
+		s_quality_titles, (void*)s_quality_values, 4, sizeof(s_quality_values[0]));
+
+	long long reads = 0;
+	int sum = 0;
+	unsigned long long read_ns = 0;
+	for (int i = 0; i < options->frames; ++i) {
+		bool_item->leaf.hot_index = (size_t)(i % 2);
+		debuginator_activate(debuginator, bool_item, false);
+		quality_item->leaf.hot_index = (size_t)(i % 4);
+		debuginator_activate(debuginator, quality_item, false);
+
+		unsigned long long start = headless_time_ns();
+		for (int read = 0; read < options->moves; ++read, ++reads) {
+			sum += debuginator_read_int(&published_quality) + (debuginator_read_bool(&published_bool) ? 1 : 0);
+		}
+		read_ns += headless_time_ns() - start;
+	}
+
+	char extra[256];
+	sprintf(extra, "\"sum\":%d", sum);
+	benchmark_report("read_published", 2, reads * 2, read_ns, extra);
+
+	headless_destroy(debuginator);
+}
+
+static void benchmark_create_entity(struct TheDebuginator* debuginator, const char* folder, int entity_index) {
+	char path[BENCHMARK_PATH_STRIDE];
+	for (int i = 0; i < BENCHMARK_STAGED_ITEMS_PER_ENTITY; ++i) {
+		sprintf(path, "%sEntity %04d/Setting %d", folder, entity_index, i);
+		if (i == 0) {
+			debuginator_create_array_item(debuginator, NULL, path, "Quality for this entity.", NULL, NULL,
+				s_quality_titles, (void*)s_quality_values, 4, sizeof(s_quality_values[0]));
+		}
+		else {
+			debuginator_create_bool_item(debuginator, path, NULL, NULL);
+		}
+	}
+}
+
+// Spawning lots of entities with a folder of items each. Staged, what the main thread pays is
+// only attaching them. The staging areas are built one after the other here, but each could be
+// on a thread of its own, like in staging.c, which also checks what ends up in the menu.
+static void benchmark_staging(void) {
+	struct TheDebuginator* debuginator = headless_create(64 * 1024 * 1024, false);
+	// For comparison, the usual way.
+	debuginator_create_folder_item(debuginator, NULL, "Direct");
+	unsigned long long start = headless_time_ns();
+	for (int i = 0; i < BENCHMARK_STAGED_ENTITIES; ++i) {
+		benchmark_create_entity(debuginator, "Direct/", i);
+	}
+	unsigned long long direct_ns = headless_time_ns() - start;
+
+	DebuginatorItem* entities = debuginator_create_folder_item(debuginator, NULL, "Entities");
+	struct TheDebuginator* staging = (struct TheDebuginator*)malloc(sizeof(struct TheDebuginator) * BENCHMARK_STAGING_AREAS);
+	unsigned long long main_ns = 0;
+	unsigned long long staging_ns = 0;
+	int entities_per_area = BENCHMARK_STAGED_ENTITIES / BENCHMARK_STAGING_AREAS;
+	for (int area = 0; area < BENCHMARK_STAGING_AREAS; ++area) {
+		start = headless_time_ns();
+		debuginator_create_staging(debuginator, &staging[area], 32);
+		main_ns += headless_time_ns() - start;
+	}
+
+	start = headless_time_ns();
+	for (int area = 0; area < BENCHMARK_STAGING_AREAS; ++area) {
+		for (int i = area * entities_per_area; i < (area + 1) * entities_per_area; ++i) {
+			benchmark_create_entity(&staging[area], "", i);
+		}
+		debuginator_finish_staging(&staging[area]);
+	}
+	staging_ns = headless_time_ns() - start;
+
+	start = headless_time_ns();
+	for (int area = 0; area < BENCHMARK_STAGING_AREAS; ++area) {
+		debuginator_attach_staging(debuginator, &staging[area], entities);
+	}
+	main_ns += headless_time_ns() - start;
+
+	char extra[256];
+	sprintf(extra, "\"direct_ms\":%.3f,\"staging_ms\":%.3f", (double)direct_ns / 1e6, (double)staging_ns / 1e6);
+	benchmark_report("attach_staging", BENCHMARK_STAGED_ENTITIES * BENCHMARK_STAGED_ITEMS_PER_ENTITY, BENCHMARK_STAGING_AREAS, main_ns, extra);
+
+	free(staging);
+	headless_destroy(debuginator);
+}
+
+// Loading a binary save before the items are created, which is how a game would do it at
+// startup, with a collapsed folder and hot keys that benchmark_size doesn't have. That it
+// loads everything back is checked in save_binary.c.
+static struct TheDebuginator* benchmark_create_roundtrip_menu(const char* paths, int num_leaves, const void* binary, int binary_size) {
+	struct TheDebuginator* debuginator = headless_create(8 * 1024 * 1024, false);
+	if (binary != NULL) {
+		debuginator_load_binary(debuginator, binary, binary_size);
+	}
+
+	for (int i = 0; i < num_leaves; ++i) {
+		debuginator_create_array_item(debuginator, NULL, paths + (size_t)i * BENCHMARK_PATH_STRIDE, NULL, NULL, NULL,
+			s_quality_titles, (void*)s_quality_values, 4, sizeof(s_quality_values[0]));
+	}
+	return debuginator;
+}
+
+static void benchmark_save_binary_roundtrip(void) {
+	int num_leaves = BENCHMARK_MAX_LOAD_KEYS;
+	char* paths = (char*)malloc((size_t)num_leaves * BENCHMARK_PATH_STRIDE);
+	for (int i = 0; i < num_leaves; ++i) {
+		benchmark_generate_path(paths + (size_t)i * BENCHMARK_PATH_STRIDE, i, num_leaves);
+	}
+
+	struct TheDebuginator* debuginator = benchmark_create_roundtrip_menu(paths, num_leaves, NULL, 0);
+	for (int i = 0; i < num_leaves; i += 7) {
+		DebuginatorItem* item = debuginator_get_item(debuginator, NULL, paths + (size_t)i * BENCHMARK_PATH_STRIDE, NULL);
+		item->leaf.hot_index = 1 + i % 3;
+		debuginator_activate(debuginator, item, false);
+	}
+	debuginator_set_collapsed(debuginator, debuginator_get_parent(debuginator_get_item(debuginator, NULL, paths, NULL)), true);
+	debuginator_assign_hot_key(debuginator, "F5", paths, 0, "High");
+	debuginator_assign_hot_key(debuginator, "F6", paths + BENCHMARK_PATH_STRIDE, DEBUGINATOR_NO_HOT_INDEX, NULL);
+
+	SaveBuffer original;
+	original.capacity = (size_t)num_leaves * 64;
+	original.data = (char*)malloc(original.capacity);
+	original.size = 0;
+	original.num_keys = 0;
+	debuginator_save(debuginator, benchmark_save_callback, &original);
+
+	int needed = 0;
+	debuginator_save_binary(debuginator, NULL, 0, &needed);
+	char* binary = (char*)malloc((size_t)needed);
+	debuginator_save_binary(debuginator, binary, needed, NULL);
+	headless_destroy(debuginator);
+
+	unsigned long long start = headless_time_ns();
+	struct TheDebuginator* loaded = benchmark_create_roundtrip_menu(paths, num_leaves, binary, needed);
+	unsigned long long load_ns = headless_time_ns() - start;
+
+	char extra[256];
+	sprintf(extra, "\"keys\":%d,\"text_bytes\":%llu,\"binary_bytes\":%d",
+		original.num_keys, (unsigned long long)original.size, needed);
+	benchmark_report("load_binary_then_create", num_leaves, num_leaves, load_ns, extra);
+
+	headless_destroy(loaded);
+	free(binary);
+	free(original.data);
+	free(paths);
+}
+
+#ifdef DEBUGINATOR_ENABLE_PROFILER
+#define BENCHMARK_PROFILED_ITEMS 16
+
+static double benchmark_get_time(void* app_userdata) {
+	(void)app_userdata;
+	return (double)headless_time_ns() / 1e9;
+}
+
+// Frames with the built-in profiler timing everything and tracing it to JSON, for what that
+// costs. That the stats and trace are right is checked in profiler.c.
+static void benchmark_profiler(const BenchmarkOptions* options) {
+	TheDebuginatorConfig config;
+	headless_config(&config, NULL, 4 * 1024 * 1024);
+	config.create_default_debuginator_items = false;
+	config.notifications_enabled = false;
+	config.get_time = benchmark_get_time;
+	struct TheDebuginator* debuginator = headless_create_from_config(&config);
+
+	static char paths[BENCHMARK_PROFILED_ITEMS][BENCHMARK_PATH_STRIDE];
+	static const char* path_list[BENCHMARK_PROFILED_ITEMS];
+	static const char* high_titles[BENCHMARK_PROFILED_ITEMS];
+	for (int i = 0; i < BENCHMARK_PROFILED_ITEMS; ++i) {
+		sprintf(paths[i], "Profiled/Quality %02d", i);
+		path_list[i] = paths[i];
+		high_titles[i] = "High";
+		debuginator_create_array_item(debuginator, NULL, paths[i], NULL, benchmark_count_callback, NULL,
+			s_quality_titles, (void*)s_quality_values, 4, sizeof(s_quality_values[0]));
+	}
+	DebuginatorItem* preset = debuginator_create_preset_item(debuginator, "Profiled/Preset", path_list, high_titles, NULL, BENCHMARK_PROFILED_ITEMS);
+
+	debuginator_set_open(debuginator, true);
+	headless_run_frames(debuginator, 30);
+
+	DebuginatorTraceJsonWriter writer;
+	int trace_capacity = options->frames * 16 * 1024;
+	char* trace = (char*)malloc((size_t)trace_capacity);
+	debuginator_trace_json_begin(&writer, trace, trace_capacity);
+	writer.pid = 1;
+	writer.tid = 1;
+	debuginator_set_trace_callback(debuginator, debuginator_trace_json_write, &writer);
+
+	unsigned long long start = headless_time_ns();
+	for (int i = 0; i < options->frames; ++i) {
+		debuginator_update(debuginator, 1 / 60.0f);
+		debuginator_update_filter(debuginator, i % 2 == 0 ? "quality 1" : "");
+		debuginator_activate(debuginator, preset, false);
+		debuginator_draw(debuginator, 1 / 60.0f);
+	}
+	unsigned long long frames_ns = headless_time_ns() - start;
+
+	debuginator_set_trace_callback(debuginator, NULL, NULL);
+	debuginator_trace_json_end(&writer);
+
+	char extra[256];
+	sprintf(extra, "\"trace_events\":%d,\"trace_bytes\":%d", writer.num_events, writer.size);
+	benchmark_report("profiled_frames", BENCHMARK_PROFILED_ITEMS, options->frames, frames_ns, extra);
+
+	free(trace);
+	headless_destroy(debuginator);
+}
+#endif
+
+static void benchmark_parse_sizes(BenchmarkOptions* options, const char* list) {
+	options->num_sizes = 0;
+	while (*list != '\0' && options->num_sizes < BENCHMARK_COUNTOF(options->sizes)) {
+		char* end;
+		long size = strtol(list, &end, 10);
+		if (end == list) {
+			break;
+		}
+		if (size > 0) {
+			options->sizes[options->num_sizes++] = (int)size;
+		}
+		list = *end == ',' ? end + 1 : end;
+	}
+}
+
+int main(int argc, char** argv) {
+	BenchmarkOptions options;
+	memset(&options, 0, sizeof(options));
+	benchmark_parse_sizes(&options, "1000,10000,100000,1000000");
+	options.frames = 120;
+	options.moves = 10000;
+	options.filter_rounds = 3;
+
+	for (int i = 1; i < argc; ++i) {
+		bool has_value = i + 1 < argc;
+		if (strcmp(argv[i], "--sizes") == 0 && has_value) {
+			benchmark_parse_sizes(&options, argv[++i]);
+		}
+		else if (strcmp(argv[i], "--frames") == 0 && has_value) {
+			options.frames = atoi(argv[++i]);
+		}
+		else if (strcmp(argv[i], "--moves") == 0 && has_value) {
+			options.moves = atoi(argv[++i]);
+		}
+		else if (strcmp(argv[i], "--filter-rounds") == 0 && has_value) {
+			options.filter_rounds = atoi(argv[++i]);
+		}
+		else {
+			fprintf(stderr, "Usage: %s [--sizes 1000,10000,...] [--frames N] [--moves N] [--filter-rounds N]\n", argv[0]);
+			return 1;
+		}
+	}
+
+	if (options.num_sizes == 0 || options.frames <= 0 || options.moves <= 0 || options.filter_rounds <= 0) {
+		fprintf(stderr, "Invalid arguments.\n");
+		return 1;
+	}
+
+	benchmark_init_glyphs();
+	for (int i = 0; i < options.num_sizes; ++i) {
+		benchmark_size(&options, options.sizes[i]);
+		benchmark_flat_folder(&options, options.sizes[i]);
+	}
+
+	benchmark_presets(&options);
+	benchmark_published_values(&options);
+	benchmark_staging();
+	benchmark_save_binary_roundtrip();
+#ifdef DEBUGINATOR_ENABLE_PROFILER
+	benchmark_profiler(&options);
+#endif
+
+	return s_num_failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,135 @@
+// Test for item callbacks, called right away and put off with debuginator_set_callback_buffer.
+//
+// Has two presets set the same items one after the other, and checks that each item's callback
+// is called once, with the value that stuck, and that a full buffer calls them right away
+// instead. Also checks that callbacks from activating items before the update are counted in
+// the frame that it ends.
+//
+// Usage: callbacks
+
+#define DEBUGINATOR_IMPLEMENTATION
+#include "headless.h"
+
+#define CALLBACKS_ITEMS 20
+
+static const char* s_quality_titles[] = { "Off", "Low", "Medium", "High" };
+static int s_quality_values[] = { 0, 1, 2, 3 };
+
+typedef struct CallbackItem {
+	int calls;
+	int last_value;
+} CallbackItem;
+
+static CallbackItem s_items[CALLBACKS_ITEMS];
+static int s_num_calls;
+
+static void callbacks_on_item_changed(DebuginatorItem* item, void* value, const char* value_title, void* app_userdata) {
+	(void)value_title;
+	(void)app_userdata;
+	CallbackItem* callback_item = (CallbackItem*)item->user_data;
+	++callback_item->calls;
+	callback_item->last_value = *(int*)value;
+	++s_num_calls;
+}
+
+static void callbacks_reset(void) {
+	memset(s_items, 0, sizeof(s_items));
+	s_num_calls = 0;
+}
+
+// Whether every item was called calls times, last with value.
+static bool callbacks_all_called(int calls, int value) {
+	for (int i = 0; i < CALLBACKS_ITEMS; ++i) {
+		if (s_items[i].calls != calls || s_items[i].last_value != value) {
+			return false;
+		}
+	}
+	return true;
+}
+
+int main(void) {
+	struct TheDebuginator* debuginator = headless_create(4 * 1024 * 1024, false);
+
+	char paths[CALLBACKS_ITEMS][32];
+	const char* path_list[CALLBACKS_ITEMS];
+	const char* high_titles[CALLBACKS_ITEMS];
+	const char* low_titles[CALLBACKS_ITEMS];
+	for (int i = 0; i < CALLBACKS_ITEMS; ++i) {
+		sprintf(paths[i], "Presets/Quality %02d", i);
+		path_list[i] = paths[i];
+		high_titles[i] = "High";
+		low_titles[i] = "Low";
+		debuginator_create_array_item(debuginator, NULL, paths[i], NULL, callbacks_on_item_changed, &s_items[i],
+			s_quality_titles, (void*)s_quality_values, 4, sizeof(s_quality_values[0]));
+	}
+
+	DebuginatorItem* high_preset = debuginator_create_preset_item(debuginator, "Presets High", path_list, high_titles, NULL, CALLBACKS_ITEMS);
+	DebuginatorItem* low_preset = debuginator_create_preset_item(debuginator, "Presets Low", path_list, low_titles, NULL, CALLBACKS_ITEMS);
+
+	// Right away, every change is a call.
+	callbacks_reset();
+	debuginator_activate(debuginator, high_preset, false);
+	debuginator_activate(debuginator, low_preset, false);
+	HEADLESS_CHECK(callbacks_all_called(2, 1));
+
+	// Put off, nothing's called until debuginator_run_callbacks, and then only with the low
+	// preset's value, since that was the latest.
+	DebuginatorItem* pending_items[CALLBACKS_ITEMS * 2];
+	DebuginatorCallbackBuffer callback_buffer;
+	memset(&callback_buffer, 0, sizeof(callback_buffer));
+	callback_buffer.items = pending_items;
+	callback_buffer.capacity = CALLBACKS_ITEMS * 2;
+	debuginator_set_callback_buffer(debuginator, &callback_buffer);
+
+	callbacks_reset();
+	debuginator_activate(debuginator, high_preset, false);
+	debuginator_activate(debuginator, low_preset, false);
+	HEADLESS_CHECK(s_num_calls == 0);
+	HEADLESS_CHECK(callback_buffer.count > 0);
+	debuginator_run_callbacks(debuginator);
+	HEADLESS_CHECK(callbacks_all_called(1, 1));
+	HEADLESS_CHECK(callback_buffer.count == 0);
+	HEADLESS_CHECK(!callback_buffer.overflowed);
+
+	// Changing the buffer runs what's pending in the old one.
+	callbacks_reset();
+	debuginator_activate(debuginator, high_preset, false);
+	debuginator_set_callback_buffer(debuginator, NULL);
+	HEADLESS_CHECK(callbacks_all_called(1, 3));
+
+	// When the buffer is full, the rest are called right away.
+	DebuginatorCallbackBuffer small_buffer;
+	memset(&small_buffer, 0, sizeof(small_buffer));
+	small_buffer.items = pending_items;
+	small_buffer.capacity = 4;
+	debuginator_set_callback_buffer(debuginator, &small_buffer);
+
+	callbacks_reset();
+	debuginator_activate(debuginator, low_preset, false);
+	debuginator_run_callbacks(debuginator);
+	HEADLESS_CHECK(small_buffer.overflowed);
+	HEADLESS_CHECK(callbacks_all_called(1, 1));
+	debuginator_set_callback_buffer(debuginator, NULL);
+
+	// A game activates items while handling input, before the update and draw. The frame that
+	// the update ends has those callbacks, and the preset's own, and reading it doesn't reset it.
+	DebuginatorFrameStats stats;
+	DebuginatorFrameStats stats_again;
+	headless_run_frames(debuginator, 2);
+	callbacks_reset();
+	debuginator_activate(debuginator, high_preset, false);
+	debuginator_update(debuginator, 1 / 60.0f);
+	debuginator_draw(debuginator, 1 / 60.0f);
+	debuginator_get_frame_stats(debuginator, &stats);
+	debuginator_get_frame_stats(debuginator, &stats_again);
+	HEADLESS_CHECK(stats.item_callbacks == s_num_calls + 1);
+	HEADLESS_CHECK(memcmp(&stats, &stats_again, sizeof(stats)) == 0);
+
+	// The next one has none.
+	headless_run_frames(debuginator, 1);
+	debuginator_get_frame_stats(debuginator, &stats);
+	HEADLESS_CHECK(stats.item_callbacks == 0);
+
+	headless_destroy(debuginator);
+	return g_headless_failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,128 @@
+// Test that debuginator_draw doesn't change the menu, only what it draws into.
+//
+// Points the mouse at a value of an expanded item with a description, clicks it, toggles a bool
+// and opens the search box, so that the tooltip, the activate animation, the bool's slider and
+// the search box all animate. Then closes the menu, so that the notifications show. Every frame
+// the Debuginator and its arena are compared before and after drawing, first with the draw
+// callbacks and then with a retained draw command buffer. Also checks that the mouse is over
+// what the update says it is.
+//
+// Usage: draw
+
+#define DEBUGINATOR_IMPLEMENTATION
+#include "headless.h"
+
+#define DRAW_ARENA_CAPACITY (4 * 1024 * 1024)
+#define DRAW_FRAMES 90
+
+static const char* s_quality_titles[] = { "Off", "Low", "Medium", "High" };
+static int s_quality_values[] = { 0, 1, 2, 3 };
+static bool s_bool_sink;
+
+static void draw_on_item_changed(DebuginatorItem* item, void* value, const char* value_title, void* app_userdata) {
+	(void)item;
+	(void)value;
+	(void)value_title;
+	(void)app_userdata;
+}
+
+// Everything but the parts that are drawing's own.
+static bool draw_frame_is_read_only(struct TheDebuginator* debuginator, struct TheDebuginator* before, char* arena_before) {
+	debuginator_update(debuginator, 1 / 60.0f);
+	memcpy(before, debuginator, sizeof(*debuginator));
+	memcpy(arena_before, debuginator->memory_arena, DRAW_ARENA_CAPACITY);
+	debuginator_draw(debuginator, 1 / 60.0f);
+
+	before->frame_stats = debuginator->frame_stats;
+	before->draw_list_state = debuginator->draw_list_state;
+	before->draw_list_valid = debuginator->draw_list_valid;
+	before->draw_list_animating = debuginator->draw_list_animating;
+	before->draw_list_mouse_highlight_alpha = debuginator->draw_list_mouse_highlight_alpha;
+	return memcmp(before, debuginator, sizeof(*debuginator)) == 0
+		&& memcmp(arena_before, debuginator->memory_arena, DRAW_ARENA_CAPACITY) == 0;
+}
+
+static void draw_run(struct TheDebuginator* debuginator, struct TheDebuginator* before, char* arena_before) {
+	DebuginatorItem* described_item = debuginator_get_item(debuginator, NULL, "Draw/Quality 10", NULL);
+	DebuginatorItem* bool_item = debuginator_get_item(debuginator, NULL, "Draw/Toggle 11", NULL);
+
+	debuginator_set_open(debuginator, true);
+	debuginator_set_hot_item(debuginator, described_item);
+	debuginator_move_to_child(debuginator, true);
+	headless_run_frames(debuginator, 30);
+
+	// The second value's row, below the title and the description.
+	float top = debuginator->current_height_offset + debuginator__distance_to_item_uncached(debuginator, described_item) - debuginator->item_height;
+	float value_y = top + debuginator->item_height * (2 + described_item->leaf.description_line_count + 0.5f);
+	DebuginatorVector2 mouse_pos = debuginator__vector2(debuginator->top_left.x + 50, value_y);
+	debuginator_set_mouse_cursor_pos(debuginator, &mouse_pos);
+	debuginator_update(debuginator, 1 / 60.0f);
+	int value_index = -1;
+	HEADLESS_CHECK(debuginator_get_item_at_mouse_cursor(debuginator, &value_index) == described_item);
+	HEADLESS_CHECK(value_index == 1);
+
+	debuginator_activate_item_at_mouse_cursor(debuginator);
+	HEADLESS_CHECK(described_item->leaf.active_index == 1);
+	debuginator_activate(debuginator, bool_item, true);
+	debuginator_set_filtering_enabled(debuginator, true);
+
+	bool read_only = true;
+	for (int frame = 0; frame < DRAW_FRAMES; ++frame) {
+		read_only = read_only && draw_frame_is_read_only(debuginator, before, arena_before);
+	}
+	HEADLESS_CHECK(read_only);
+	HEADLESS_CHECK(debuginator->tooltip_timer > 0);
+
+	debuginator_set_filtering_enabled(debuginator, false);
+	debuginator_set_open(debuginator, false);
+	HEADLESS_CHECK(debuginator->notification_count > 0);
+	for (int frame = 0; frame < DRAW_FRAMES; ++frame) {
+		read_only = read_only && draw_frame_is_read_only(debuginator, before, arena_before);
+	}
+	HEADLESS_CHECK(read_only);
+
+	mouse_pos = debuginator__vector2(-1000, -1000);
+	debuginator_set_mouse_cursor_pos(debuginator, &mouse_pos);
+	headless_run_frames(debuginator, 120);
+}
+
+int main(void) {
+	struct TheDebuginator* debuginator = headless_create(DRAW_ARENA_CAPACITY, false);
+	debuginator_set_notifications_enabled(debuginator, true);
+	for (int i = 0; i < 40; ++i) {
+		char path[64];
+		if (i % 2 == 0) {
+			snprintf(path, sizeof(path), "Draw/Quality %02d", i);
+			debuginator_create_array_item(debuginator, NULL, path,
+				"Quality level for this system, with a description long enough to need a few rows.", draw_on_item_changed, NULL,
+				s_quality_titles, (void*)s_quality_values, 4, sizeof(s_quality_values[0]));
+		}
+		else {
+			snprintf(path, sizeof(path), "Draw/Toggle %02d", i);
+			debuginator_create_bool_item(debuginator, path, NULL, &s_bool_sink);
+		}
+	}
+
+	struct TheDebuginator* before = (struct TheDebuginator*)malloc(sizeof(struct TheDebuginator));
+	char* arena_before = (char*)malloc(DRAW_ARENA_CAPACITY);
+	draw_run(debuginator, before, arena_before);
+
+	DebuginatorDrawCommandBuffer command_buffer;
+	memset(&command_buffer, 0, sizeof(command_buffer));
+	command_buffer.commands_capacity = 4096;
+	command_buffer.commands = (DebuginatorDrawCommand*)malloc(sizeof(DebuginatorDrawCommand) * (size_t)command_buffer.commands_capacity);
+	command_buffer.strings_capacity = 64 * 1024;
+	command_buffer.strings = (char*)malloc((size_t)command_buffer.strings_capacity);
+	debuginator_set_draw_command_buffer(debuginator, &command_buffer);
+	debuginator_set_retained_drawing(debuginator, true);
+	draw_run(debuginator, before, arena_before);
+	HEADLESS_CHECK(!command_buffer.overflowed);
+
+	debuginator_set_draw_command_buffer(debuginator, NULL);
+	free(command_buffer.commands);
+	free(command_buffer.strings);
+	free(arena_before);
+	free(before);
+	headless_destroy(debuginator);
+	return g_headless_failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,276 @@
+// Ranking and latency regression test for the search filter.
+//
+// Builds a menu from data/fuzzy_corpus.txt and runs every query in data/fuzzy_queries.txt.
+// For each query, all leaves are ranked with the reference scorer (debuginator__score_path,
+// ties broken by menu order) and the top results are compared against the expected ones.
+// It also checks that debuginator_update_filter picks the top ranked item as the hot item,
+// and times it. Per-query results are printed as one JSON object per line.
+//
+// Usage: fuzzy_ranking <data dir> [--repeat N] [--write-expected]
+//
+// --write-expected prints a new fuzzy_queries.txt based on the current scorer, for when a
+// ranking change is intentional. Review the diff carefully before checking it in.
+
+#define DEBUGINATOR_IMPLEMENTATION
+#include "headless.h"
+
+#define FUZZY_MAX_LINE 512
+#define FUZZY_MAX_EXPECTED 3
+
+typedef struct FuzzyLeaf {
+	DebuginatorItem* item;
+	char path[DEBUGINATOR_MAX_PATH_LENGTH];            // As in the corpus, "Folder/Item"
+	char filter_path[DEBUGINATOR_MAX_PATH_LENGTH];     // As seen by the filter, "Folder Item"
+	int title_start;
+	int score;
+} FuzzyLeaf;
+
+typedef struct FuzzyCorpus {
+	FuzzyLeaf* leaves;
+	int num_leaves;
+	int capacity;
+} FuzzyCorpus;
+
+static bool s_bool_sink;
+
+static char* fuzzy_read_line(char* line, FILE* file) {
+	if (fgets(line, FUZZY_MAX_LINE, file) == NULL) {
+		return NULL;
+	}
+
+	size_t length = strlen(line);
+	while (length > 0 && (line[length - 1] == '\n' || line[length - 1] == '\r')) {
+		line[--length] = '\0';
+	}
+	return line;
+}
+
+static FILE* fuzzy_open(const char* data_dir, const char* file_name) {
+	char path[1024];
+	snprintf(path, sizeof(path), "%s/%s", data_dir, file_name);
+	FILE* file = fopen(path, "r");
+	if (file == NULL) {
+		fprintf(stderr, "Couldn't open %s\n", path);
+	}
+	return file;
+}
+
+// Collects the leaves in menu order, which is the order the filter visits them in.
+static void fuzzy_collect_leaves(FuzzyCorpus* corpus, DebuginatorItem* folder, const char* path, const char* filter_path) {
+	for (DebuginatorItem* item = folder->folder.first_child; item != NULL; item = item->next_sibling) {
+		char item_path[DEBUGINATOR_MAX_PATH_LENGTH];
+		char item_filter_path[DEBUGINATOR_MAX_PATH_LENGTH];
+		snprintf(item_path, sizeof(item_path), "%s%s%s", path, path[0] != '\0' ? "/" : "", item->title);
+		snprintf(item_filter_path, sizeof(item_filter_path), "%s%s%s", filter_path, filter_path[0] != '\0' ? " " : "", item->title);
+
+		if (item->is_folder) {
+			fuzzy_collect_leaves(corpus, item, item_path, item_filter_path);
+			continue;
+		}
+
+		if (corpus->num_leaves == corpus->capacity) {
+			corpus->capacity = corpus->capacity == 0 ? 256 : corpus->capacity * 2;
+			corpus->leaves = (FuzzyLeaf*)realloc(corpus->leaves, sizeof(FuzzyLeaf) * (size_t)corpus->capacity);
+		}
+
+		FuzzyLeaf* leaf = &corpus->leaves[corpus->num_leaves++];
+		leaf->item = item;
+		strcpy(leaf->path, item_path);
+		strcpy(leaf->filter_path, item_filter_path);
+		leaf->title_start = (int)(strlen(item_filter_path) - strlen(item->title));
+		leaf->score = -1;
+	}
+}
+
+// Ranks all leaves for the query the same way debuginator_update_filter does. Returns the number
+// of matching leaves, and their indices in ranking order.
+static int fuzzy_rank(FuzzyCorpus* corpus, const char* query, int* ranking) {
+	bool exact_search = strchr(query, ' ') != NULL;
+	bool case_sensitive = false;
+	for (const char* c = query; *c != '\0'; ++c) {
+		case_sensitive = case_sensitive || ('A' <= *c && *c <= 'Z');
+	}
+
+	int num_matches = 0;
+	for (int i = 0; i < corpus->num_leaves; ++i) {
+		FuzzyLeaf* leaf = &corpus->leaves[i];
+		char lowercase[DEBUGINATOR_MAX_PATH_LENGTH];
+		int path_length = (int)strlen(leaf->filter_path);
+		for (int c = 0; c <= path_length; ++c) {
+			lowercase[c] = case_sensitive ? leaf->filter_path[c] : (char)DEBUGINATOR_tolower(leaf->filter_path[c]);
+		}
+
+		bool is_filtered;
+		leaf->score = debuginator__score_path(leaf->filter_path, lowercase, path_length, leaf->title_start, query, exact_search, &is_filtered);
+		if (is_filtered || leaf->score < 0) {
+			continue;
+		}
+
+		// Insertion sort, stable so equal scores stay in menu order.
+		int insert_at = num_matches;
+		while (insert_at > 0 && corpus->leaves[ranking[insert_at - 1]].score < leaf->score) {
+			ranking[insert_at] = ranking[insert_at - 1];
+			--insert_at;
+		}
+		ranking[insert_at] = i;
+		++num_matches;
+	}
+
+	return num_matches;
+}
+
+static void fuzzy_print_json_string(const char* string) {
+	putchar('"');
+	for (const char* c = string; *c != '\0'; ++c) {
+		if (*c == '"' || *c == '\\') {
+			putchar('\\');
+		}
+		putchar(*c);
+	}
+	putchar('"');
+}
+
+int main(int argc, char** argv) {
+	if (argc < 2) {
+		fprintf(stderr, "Usage: %s <data dir> [--repeat N] [--write-expected]\n", argv[0]);
+		return 1;
+	}
+
+	const char* data_dir = argv[1];
+	int repeat = 20;
+	bool write_expected = false;
+	for (int i = 2; i < argc; ++i) {
+		if (strcmp(argv[i], "--repeat") == 0 && i + 1 < argc) {
+			repeat = atoi(argv[++i]);
+		}
+		else if (strcmp(argv[i], "--write-expected") == 0) {
+			write_expected = true;
+		}
+		else {
+			fprintf(stderr, "Unknown argument %s\n", argv[i]);
+			return 1;
+		}
+	}
+
+	if (repeat <= 0) {
+		repeat = 1;
+	}
+
+	struct TheDebuginator* debuginator = headless_create(4 * 1024 * 1024, false);
+
+	char line[FUZZY_MAX_LINE];
+	FILE* corpus_file = fuzzy_open(data_dir, "fuzzy_corpus.txt");
+	if (corpus_file == NULL) {
+		return 1;
+	}
+
+	while (fuzzy_read_line(line, corpus_file) != NULL) {
+		if (line[0] != '\0' && line[0] != '#') {
+			debuginator_create_bool_item(debuginator, line, NULL, &s_bool_sink);
+		}
+	}
+	fclose(corpus_file);
+
+	FuzzyCorpus corpus;
+	memset(&corpus, 0, sizeof(corpus));
+	fuzzy_collect_leaves(&corpus, debuginator->root, "", "");
+	int* ranking = (int*)malloc(sizeof(int) * (size_t)corpus.num_leaves);
+
+	FILE* queries_file = fuzzy_open(data_dir, "fuzzy_queries.txt");
+	if (queries_file == NULL) {
+		return 1;
+	}
+
+	int num_queries = 0;
+	int num_failures = 0;
+	unsigned long long total_ns = 0;
+	while (fuzzy_read_line(line, queries_file) != NULL) {
+		if (line[0] == '\0' || line[0] == '#') {
+			if (write_expected) {
+				printf("%s\n", line);
+			}
+			continue;
+		}
+
+		// query<TAB>expected 1<TAB>expected 2...
+		const char* expected[FUZZY_MAX_EXPECTED];
+		int num_expected = 0;
+		char* query = line;
+		char* tab = strchr(line, '\t');
+		while (tab != NULL) {
+			*tab = '\0';
+			if (num_expected < FUZZY_MAX_EXPECTED) {
+				expected[num_expected++] = tab + 1;
+			}
+			tab = strchr(tab + 1, '\t');
+		}
+
+		int num_matches = fuzzy_rank(&corpus, query, ranking);
+		if (write_expected) {
+			printf("%s", query);
+			for (int i = 0; i < num_matches && i < FUZZY_MAX_EXPECTED; ++i) {
+				printf("\t%s", corpus.leaves[ranking[i]].path);
+			}
+			printf("\n");
+			continue;
+		}
+
+		++num_queries;
+		bool ranking_ok = num_expected == (num_matches < FUZZY_MAX_EXPECTED ? num_matches : FUZZY_MAX_EXPECTED);
+		for (int i = 0; ranking_ok && i < num_expected; ++i) {
+			ranking_ok = strcmp(corpus.leaves[ranking[i]].path, expected[i]) == 0;
+		}
+
+		// Time the real thing. Clearing the filter first makes every run a fresh search,
+		// rather than one that keeps the previous hot item.
+		unsigned long long query_ns = 0;
+		for (int i = 0; i < repeat; ++i) {
+			debuginator_update_filter(debuginator, "");
+			unsigned long long start = headless_time_ns();
+			debuginator_update_filter(debuginator, query);
+			query_ns += headless_time_ns() - start;
+		}
+		total_ns += query_ns;
+
+		DebuginatorItem* expected_hot_item = num_matches > 0 ? corpus.leaves[ranking[0]].item : NULL;
+		bool hot_item_ok = expected_hot_item != NULL
+			? debuginator->hot_item == expected_hot_item
+			: debuginator->hot_item->user_data == (void*)0x12345678; // "No items found"
+
+		printf("{\"query\":");
+		fuzzy_print_json_string(query);
+		printf(",\"matches\":%d,\"top\":", num_matches);
+		fuzzy_print_json_string(num_matches > 0 ? corpus.leaves[ranking[0]].path : "");
+		printf(",\"top_score\":%d,\"ns_per_filter\":%.1f,\"ranking_ok\":%s,\"hot_item_ok\":%s}\n",
+			num_matches > 0 ? corpus.leaves[ranking[0]].score : -1,
+			(double)query_ns / repeat, ranking_ok ? "true" : "false", hot_item_ok ? "true" : "false");
+
+		if (!ranking_ok) {
+			fprintf(stderr, "Ranking changed for \"%s\". Expected:\n", query);
+			for (int i = 0; i < num_expected; ++i) {
+				fprintf(stderr, "  %s\n", expected[i]);
+			}
+			fprintf(stderr, "Got:\n");
+			for (int i = 0; i < num_matches && i < FUZZY_MAX_EXPECTED; ++i) {
+				fprintf(stderr, "  %s (%d)\n", corpus.leaves[ranking[i]].path, corpus.leaves[ranking[i]].score);
+			}
+		}
+
+		if (!hot_item_ok) {
+			fprintf(stderr, "debuginator_update_filter picked \"%s\" for \"%s\".\n", debuginator->hot_item->title, query);
+		}
+
+		num_failures += (ranking_ok && hot_item_ok) ? 0 : 1;
+	}
+	fclose(queries_file);
+
+	if (!write_expected) {
+		printf("{\"queries\":%d,\"failures\":%d,\"leaves\":%d,\"ns_per_filter\":%.1f}\n",
+			num_queries, num_failures, corpus.num_leaves, num_queries > 0 ? (double)total_ns / ((double)num_queries * repeat) : 0.0);
+	}
+
+	free(ranking);
+	free(corpus.leaves);
+	headless_destroy(debuginator);
+	return num_failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,209 @@
+// Golden image test for drawing, and per-frame cost of the draw path.
+//
+// Renders a few scripted scenarios with the software rasterizer in raster.h and compares the
+// last frame of each against data/golden/<scenario>.ppm. Every scenario starts from a fresh
+// menu, with the default items and 10k more, so they don't depend on each other. Afterwards
+// it times more frames of the same scenario. Results are printed as one JSON object per line.
+//
+// Usage: golden <data dir> [--frames N] [--write-golden]
+//
+// If an image differs, the rendered one is written to <scenario>.actual.ppm in the current
+// directory. --write-golden replaces the golden images, for when a change in how things look
+// is intentional. Look at them before checking them in.
+
+#define DEBUGINATOR_IMPLEMENTATION
+#include "headless.h"
+#include "raster.h"
+
+#define GOLDEN_WIDTH 480
+#define GOLDEN_HEIGHT 270
+#define GOLDEN_NUM_ITEMS 10000
+#define GOLDEN_SETTLE_FRAMES 60
+#define GOLDEN_DT (1 / 60.0f)
+
+// Allowed difference per channel, so that small differences in float math between compilers
+// don't fail the test. Moving or changing anything is still caught.
+#define GOLDEN_TOLERANCE 8
+
+// Only what's on screen, and what's passed on the way there, should be looked at when drawing.
+// With 10k items, touching much more than a screenful means culling is broken.
+#define GOLDEN_MAX_ITEMS_VISITED 100
+
+typedef struct GoldenScenario {
+	const char* name;
+	void (*setup)(struct TheDebuginator* debuginator);
+	void (*every_frame)(struct TheDebuginator* debuginator); // While timing, can be NULL
+} GoldenScenario;
+
+static bool s_bool_sink;
+static const DebuginatorColor s_clear_color = { 40, 44, 52, 255 };
+
+static void golden_setup_open(struct TheDebuginator* debuginator) {
+	(void)debuginator;
+}
+
+static void golden_setup_scroll(struct TheDebuginator* debuginator) {
+	debuginator_set_hot_item(debuginator, debuginator_get_item(debuginator, NULL, "Items/Item 05000", NULL));
+}
+
+static void golden_scroll_every_frame(struct TheDebuginator* debuginator) {
+	debuginator_move_to_next_leaf(debuginator, false);
+}
+
+static void golden_setup_filter(struct TheDebuginator* debuginator) {
+	debuginator_set_filtering_enabled(debuginator, true);
+	debuginator_update_filter(debuginator, "item 042");
+}
+
+static void golden_setup_expand(struct TheDebuginator* debuginator) {
+	debuginator_set_hot_item(debuginator, debuginator_get_item(debuginator, NULL, "Items/Item 05000", NULL));
+	debuginator_move_to_child(debuginator, true);
+}
+
+static const GoldenScenario s_scenarios[] = {
+	{ "open", golden_setup_open, NULL },
+	{ "scroll", golden_setup_scroll, golden_scroll_every_frame },
+	{ "filter", golden_setup_filter, NULL },
+	{ "expand", golden_setup_expand, NULL },
+};
+
+static void golden_frame(struct TheDebuginator* debuginator, RasterTarget* target, unsigned long long* update_ns, unsigned long long* draw_ns) {
+	raster_clear(target, s_clear_color);
+	unsigned long long start = headless_time_ns();
+	debuginator_update(debuginator, GOLDEN_DT);
+	unsigned long long updated = headless_time_ns();
+	debuginator_draw(debuginator, GOLDEN_DT);
+	*update_ns += updated - start;
+	*draw_ns += headless_time_ns() - updated;
+}
+
+static struct TheDebuginator* golden_create(RasterTarget* target) {
+	TheDebuginatorConfig config;
+	raster_config(&config, NULL, 8 * 1024 * 1024, target);
+	config.item_height = 20;
+	config.quick_draw_size = 160;
+	config.notifications_enabled = false;
+	struct TheDebuginator* debuginator = headless_create_from_config(&config);
+
+	for (int i = 0; i < GOLDEN_NUM_ITEMS; ++i) {
+		char path[64];
+		snprintf(path, sizeof(path), "Items/Item %05d", i);
+		debuginator_create_bool_item(debuginator, path, i % 10 == 0 ? "Every tenth item has a description, long enough to need more than one line." : NULL, &s_bool_sink);
+	}
+
+	debuginator_set_open(debuginator, true);
+	return debuginator;
+}
+
+int main(int argc, char** argv) {
+	if (argc < 2) {
+		fprintf(stderr, "Usage: %s <data dir> [--frames N] [--write-golden]\n", argv[0]);
+		return 1;
+	}
+
+	const char* data_dir = argv[1];
+	int frames = 120;
+	bool write_golden = false;
+	for (int i = 2; i < argc; ++i) {
+		if (strcmp(argv[i], "--frames") == 0 && i + 1 < argc) {
+			frames = atoi(argv[++i]);
+		}
+		else if (strcmp(argv[i], "--write-golden") == 0) {
+			write_golden = true;
+		}
+		else {
+			fprintf(stderr, "Unknown argument %s\n", argv[i]);
+			return 1;
+		}
+	}
+
+	if (frames <= 0) {
+		frames = 1;
+	}
+
+	RasterTarget target;
+	raster_create(&target, GOLDEN_WIDTH, GOLDEN_HEIGHT);
+
+	int num_failures = 0;
+	for (int i = 0; i < (int)(sizeof(s_scenarios) / sizeof(s_scenarios[0])); ++i) {
+		const GoldenScenario* scenario = &s_scenarios[i];
+		struct TheDebuginator* debuginator = golden_create(&target);
+		scenario->setup(debuginator);
+
+		unsigned long long update_ns = 0;
+		unsigned long long draw_ns = 0;
+		for (int frame = 0; frame < GOLDEN_SETTLE_FRAMES; ++frame) {
+			golden_frame(debuginator, &target, &update_ns, &draw_ns);
+		}
+
+		char path[1024];
+		snprintf(path, sizeof(path), "%s/golden/%s.ppm", data_dir, scenario->name);
+		int differing_pixels = 0;
+		if (write_golden) {
+			if (!raster_write_ppm(&target, path)) {
+				fprintf(stderr, "Couldn't write %s\n", path);
+				differing_pixels = -1;
+			}
+		}
+		else {
+			RasterTarget golden;
+			if (raster_read_ppm(&golden, path)) {
+				differing_pixels = raster_compare(&target, &golden, GOLDEN_TOLERANCE);
+				raster_destroy(&golden);
+			}
+			else {
+				fprintf(stderr, "Couldn't read %s\n", path);
+				differing_pixels = -1;
+			}
+
+			if (differing_pixels != 0) {
+				char actual_path[256];
+				snprintf(actual_path, sizeof(actual_path), "%s.actual.ppm", scenario->name);
+				raster_write_ppm(&target, actual_path);
+				fprintf(stderr, "%s doesn't match %s, see %s\n", scenario->name, path, actual_path);
+			}
+		}
+
+		// The animations have settled, so this is the cost of an ordinary frame.
+		HeadlessCallCounts calls_before = g_headless_calls;
+		update_ns = 0;
+		draw_ns = 0;
+		for (int frame = 0; frame < frames; ++frame) {
+			if (scenario->every_frame != NULL) {
+				scenario->every_frame(debuginator);
+			}
+			golden_frame(debuginator, &target, &update_ns, &draw_ns);
+		}
+
+		double draw_calls_per_frame = (double)(g_headless_calls.draw_rect + g_headless_calls.draw_text - calls_before.draw_rect - calls_before.draw_text) / frames;
+		DebuginatorFrameStats stats;
+		debuginator_get_frame_stats(debuginator, &stats);
+		bool culled = stats.items_visited <= GOLDEN_MAX_ITEMS_VISITED;
+		if (!culled) {
+			fprintf(stderr, "%s visited %d items in a frame, more than %d\n", scenario->name, stats.items_visited, GOLDEN_MAX_ITEMS_VISITED);
+		}
+
+		// And without rasterizing, which is what The Debuginator itself costs.
+		unsigned long long no_raster_update_ns = 0;
+		unsigned long long no_raster_draw_ns = 0;
+		debuginator->draw_rect = headless_draw_rect;
+		debuginator->draw_text = headless_draw_text;
+		debuginator->draw_image = headless_draw_image;
+		for (int frame = 0; frame < frames; ++frame) {
+			if (scenario->every_frame != NULL) {
+				scenario->every_frame(debuginator);
+			}
+			golden_frame(debuginator, &target, &no_raster_update_ns, &no_raster_draw_ns);
+		}
+
+		printf("{\"scenario\":\"%s\",\"frames\":%d,\"ns_per_update\":%.1f,\"ns_per_draw\":%.1f,\"ns_per_draw_no_raster\":%.1f,\"draw_calls_per_frame\":%.1f,\"items_visited\":%d,\"items_drawn\":%d,\"differing_pixels\":%d}\n",
+			scenario->name, frames, (double)update_ns / frames, (double)draw_ns / frames, (double)no_raster_draw_ns / frames,
+			draw_calls_per_frame, stats.items_visited, stats.items_drawn, differing_pixels);
+
+		num_failures += differing_pixels != 0 || !culled ? 1 : 0;
+		headless_destroy(debuginator);
+	}
+
+	raster_destroy(&target);
+	return num_failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,207 @@
+#ifndef DEBUGINATOR_HEADLESS_H
+#define DEBUGINATOR_HEADLESS_H
+
+// Shared setup for the headless test programs (benchmark etc.). These run without a window
+// or renderer, so they build on any platform with a C99 compiler. Includes The Debuginator,
+// so define DEBUGINATOR_IMPLEMENTATION before including this in one of your source files.
+//
+// Text is measured as if it was drawn with a monospaced font, so word wrapping and
+// everything that depends on it behaves like it would in a real app.
+
+// For clock_gettime, and the threads and shared memory that queue.c uses, with -std=c99.
+#if !defined(_WIN32) && !defined(_POSIX_C_SOURCE)
+#define _POSIX_C_SOURCE 200112L
+#endif
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#ifndef __cplusplus
+#include <stdbool.h>
+#endif
+
+#ifdef _WIN32
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#include <windows.h>
+#else
+#include <time.h>
+#endif
+
+// The Debuginator uses the bounds checked _s functions, which only MSVC has.
+#ifndef _MSC_VER
+#define DEBUGINATOR_strcpy_s(dest, dest_size, src) snprintf((dest), (size_t)(dest_size), "%s", (src))
+#define DEBUGINATOR_strncpy_s(dest, dest_size, src, count) snprintf((dest), (size_t)(dest_size), "%.*s", (int)(count), (src))
+#define DEBUGINATOR_sprintf_s snprintf
+#endif
+
+// Not every program uses every helper.
+#if defined(__GNUC__) || defined(__clang__)
+#define HEADLESS_MAYBE_UNUSED __attribute__((unused))
+#else
+#define HEADLESS_MAYBE_UNUSED
+#endif
+
+#ifndef HEADLESS_CHAR_WIDTH
+#define HEADLESS_CHAR_WIDTH 8.0f
+#endif
+
+#ifndef HEADLESS_CHAR_HEIGHT
+#define HEADLESS_CHAR_HEIGHT 16.0f
+#endif
+
+typedef struct HeadlessCallCounts {
+	unsigned long long draw_text;
+	unsigned long long draw_rect;
+	unsigned long long draw_image;
+	unsigned long long word_wrap;
+	unsigned long long text_size;
+} HeadlessCallCounts;
+
+static HeadlessCallCounts g_headless_calls;
+
+#include "../../the_debuginator.h"
+
+// Monotonic time in nanoseconds.
+static HEADLESS_MAYBE_UNUSED unsigned long long headless_time_ns(void) {
+#ifdef _WIN32
+	LARGE_INTEGER frequency;
+	LARGE_INTEGER counter;
+	QueryPerformanceFrequency(&frequency);
+	QueryPerformanceCounter(&counter);
+	return (unsigned long long)((double)counter.QuadPart * 1e9 / (double)frequency.QuadPart);
+#else
+	struct timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return (unsigned long long)ts.tv_sec * 1000000000ull + (unsigned long long)ts.tv_nsec;
+#endif
+}
+
+
+static void headless_draw_text(const char* text, DebuginatorVector2* position, DebuginatorColor* color, DebuginatorFont* font, void* userdata) {
+	(void)text; (void)position; (void)color; (void)font; (void)userdata;
+	++g_headless_calls.draw_text;
+}
+
+static void headless_draw_rect(DebuginatorVector2* position, DebuginatorVector2* size, DebuginatorColor* color, void* userdata) {
+	(void)position; (void)size; (void)color; (void)userdata;
+	++g_headless_calls.draw_rect;
+}
+
+static void headless_draw_image(DebuginatorVector2* position, DebuginatorVector2* size, DebuginatorImageHandle handle, void* userdata) {
+	(void)position; (void)size; (void)handle; (void)userdata;
+	++g_headless_calls.draw_image;
+}
+
+static DebuginatorVector2 headless_text_size(const char* text, DebuginatorFont* font, void* userdata) {
+	(void)font; (void)userdata;
+	++g_headless_calls.text_size;
+	DebuginatorVector2 size;
+	size.x = (float)strlen(text) * HEADLESS_CHAR_WIDTH;
+	size.y = HEADLESS_CHAR_HEIGHT;
+	return size;
+}
+
+// Greedy wrapping on spaces. Row lengths include the trailing space, and new lines are
+// skipped at the start of rows, which is how The Debuginator steps through the rows.
+static void headless_word_wrap(const char* text, DebuginatorFont* font, float max_width, int* row_count, int* row_lengths, int row_lengths_buffer_size, void* app_userdata) {
+	(void)font; (void)app_userdata;
+	++g_headless_calls.word_wrap;
+	*row_count = 0;
+	int max_chars = (int)(max_width / HEADLESS_CHAR_WIDTH);
+	if (max_chars < 1) {
+		max_chars = 1;
+	}
+
+	const char* row_start = text;
+	while (*row_start != '\0' && *row_count < row_lengths_buffer_size) {
+		int length = 0;
+		int last_break = -1;
+		while (row_start[length] != '\0' && row_start[length] != '\n' && length < max_chars) {
+			if (row_start[length] == ' ') {
+				last_break = length;
+			}
+			++length;
+		}
+
+		if (length == max_chars && row_start[length] != '\0' && row_start[length] != '\n' && last_break > 0) {
+			length = last_break + 1;
+		}
+
+		row_lengths[(*row_count)++] = length;
+		row_start += length;
+		while (*row_start == '\n') {
+			++row_start;
+		}
+	}
+}
+
+// Fills in the callbacks and a sensible panel size. The caller owns the arena, unless it's
+// created with headless_create_from_config.
+static void headless_config(TheDebuginatorConfig* config, char* memory_arena, unsigned int memory_arena_capacity) {
+	static int s_app_user_data;
+	debuginator_get_default_config(config);
+	config->memory_arena = memory_arena;
+	config->memory_arena_capacity = memory_arena_capacity;
+	config->draw_text = headless_draw_text;
+	config->draw_rect = headless_draw_rect;
+	config->draw_image = headless_draw_image;
+	config->word_wrap = headless_word_wrap;
+	config->text_size = headless_text_size;
+	config->app_user_data = &s_app_user_data;
+	config->size.x = 500;
+	config->size.y = 1080;
+	config->screen_resolution.x = 1920;
+	config->screen_resolution.y = 1080;
+}
+
+// Creates a Debuginator from config, with its arena of config->memory_arena_capacity bytes
+// allocated together with it, so that headless_destroy frees both. For when the defaults from
+// headless_config need changing, otherwise use headless_create.
+static HEADLESS_MAYBE_UNUSED struct TheDebuginator* headless_create_from_config(TheDebuginatorConfig* config) {
+	struct TheDebuginator* debuginator = (struct TheDebuginator*)malloc(sizeof(struct TheDebuginator) + config->memory_arena_capacity);
+	config->memory_arena = (char*)(debuginator + 1);
+	debuginator_create(config, debuginator);
+	return debuginator;
+}
+
+// A Debuginator set up with headless_config and without notifications. The items under
+// Debuginator/ are only created if default_items is set.
+static HEADLESS_MAYBE_UNUSED struct TheDebuginator* headless_create(unsigned int arena_capacity, bool default_items) {
+	TheDebuginatorConfig config;
+	headless_config(&config, NULL, arena_capacity);
+	config.create_default_debuginator_items = default_items;
+	config.notifications_enabled = false;
+	return headless_create_from_config(&config);
+}
+
+static HEADLESS_MAYBE_UNUSED void headless_destroy(struct TheDebuginator* debuginator) {
+	free(debuginator);
+}
+
+// Runs frames at 60 fps.
+static HEADLESS_MAYBE_UNUSED void headless_run_frames(struct TheDebuginator* debuginator, int frames) {
+	for (int i = 0; i < frames; ++i) {
+		debuginator_update(debuginator, 1 / 60.0f);
+		debuginator_draw(debuginator, 1 / 60.0f);
+	}
+}
+
+// For the tests. Prints the condition if it's false, and counts it, so that main can return
+// g_headless_failures == 0 ? 0 : 1.
+static HEADLESS_MAYBE_UNUSED int g_headless_failures;
+
+#define HEADLESS_CHECK(condition) headless_check((condition), #condition, __FILE__, __LINE__)
+
+static HEADLESS_MAYBE_UNUSED void headless_check(bool condition, const char* text, const char* file, int line) {
+	if (!condition) {
+		fprintf(stderr, "%s(%d): failed: %s\n", file, line, text);
+		++g_headless_failures;
+	}
+}
+
+#endif // DEBUGINATOR_HEADLESS_H
@@ -0,0 +1,233 @@
+// Test for the built-in profiler, DEBUGINATOR_ENABLE_PROFILER.
+//
+// Runs frames that update, filter, activate items and draw, with the profiler timing them and
+// tracing it to JSON. Checks that the zones that ran got a time, and that the trace is
+// something chrome://tracing can open, with every zone ending where it should, including when
+// the trace's buffer runs out partway through a frame.
+//
+// Usage: profiler
+
+#define DEBUGINATOR_ENABLE_PROFILER
+#define DEBUGINATOR_IMPLEMENTATION
+#include "headless.h"
+
+#define PROFILER_ITEMS 16
+#define PROFILER_FRAMES 10
+#define PROFILER_COUNTOF(array) ((int)(sizeof(array) / sizeof(array[0])))
+
+static const char* s_quality_titles[] = { "Off", "Low", "Medium", "High" };
+static int s_quality_values[] = { 0, 1, 2, 3 };
+
+static double profiler_get_time(void* app_userdata) {
+	(void)app_userdata;
+	return (double)headless_time_ns() / 1e9;
+}
+
+static void profiler_on_item_changed(DebuginatorItem* item, void* value, const char* value_title, void* app_userdata) {
+	(void)item;
+	(void)value;
+	(void)value_title;
+	(void)app_userdata;
+}
+
+static const char* profiler_json_skip_space(const char* c) {
+	while (*c == ' ' || *c == '\n' || *c == '\r' || *c == '\t') {
+		++c;
+	}
+	return c;
+}
+
+static const char* profiler_json_string(const char* c) {
+	if (*c++ != '"') {
+		return NULL;
+	}
+
+	for (; *c != '"'; ++c) {
+		if ((unsigned char)*c < ' ') {
+			return NULL;
+		}
+		if (*c == '\\') {
+			++c;
+			if (*c == 'u') {
+				for (int i = 0; i < 4; ++i) {
+					++c;
+					if (*c == '\0' || strchr("0123456789abcdefABCDEF", *c) == NULL) {
+						return NULL;
+					}
+				}
+			}
+			else if (*c == '\0' || strchr("\"\\/bfnrt", *c) == NULL) {
+				return NULL;
+			}
+		}
+	}
+	return c + 1;
+}
+
+// Just enough JSON to tell if the trace would load. Returns where the value ends, or NULL.
+static const char* profiler_json_value(const char* c) {
+	c = profiler_json_skip_space(c);
+	if (*c == '{' || *c == '[') {
+		bool is_object = *c == '{';
+		char close = is_object ? '}' : ']';
+		c = profiler_json_skip_space(c + 1);
+		if (*c == close) {
+			return c + 1;
+		}
+
+		while (true) {
+			if (is_object) {
+				c = profiler_json_string(c);
+				if (c == NULL) {
+					return NULL;
+				}
+				c = profiler_json_skip_space(c);
+				if (*c++ != ':') {
+					return NULL;
+				}
+			}
+
+			c = profiler_json_value(c);
+			if (c == NULL) {
+				return NULL;
+			}
+			c = profiler_json_skip_space(c);
+			if (*c == close) {
+				return c + 1;
+			}
+			if (*c++ != ',') {
+				return NULL;
+			}
+			c = profiler_json_skip_space(c);
+		}
+	}
+
+	if (*c == '"') {
+		return profiler_json_string(c);
+	}
+
+	const char* literals[] = { "true", "false", "null" };
+	for (int i = 0; i < PROFILER_COUNTOF(literals); ++i) {
+		if (strncmp(c, literals[i], strlen(literals[i])) == 0) {
+			return c + strlen(literals[i]);
+		}
+	}
+
+	char* end;
+	strtod(c, &end);
+	return end != c ? end : NULL;
+}
+
+// Every zone that begins has to end, innermost first.
+static bool profiler_trace_is_balanced(const char* json, int* out_num_events) {
+	const char* names[32];
+	size_t name_lengths[32];
+	int depth = 0;
+	*out_num_events = 0;
+	for (const char* c = strstr(json, "\"ph\":\""); c != NULL; c = strstr(c + 1, "\"ph\":\"")) {
+		char phase = c[6];
+		const char* name = strstr(c, "\"name\":\"");
+		if (name == NULL) {
+			return false;
+		}
+		name += 8;
+		size_t name_length = strcspn(name, "\"");
+		++*out_num_events;
+		if (phase == 'B' && depth < PROFILER_COUNTOF(names)) {
+			names[depth] = name;
+			name_lengths[depth++] = name_length;
+		}
+		else if (phase == 'E' && depth > 0 && name_lengths[depth - 1] == name_length && strncmp(names[depth - 1], name, name_length) == 0) {
+			--depth;
+		}
+		else {
+			return false;
+		}
+	}
+	return depth == 0;
+}
+
+// Whether the trace is one JSON value and nothing else.
+static bool profiler_trace_is_valid(const char* trace) {
+	const char* end = profiler_json_value(trace);
+	return end != NULL && *profiler_json_skip_space(end) == '\0';
+}
+
+int main(void) {
+	TheDebuginatorConfig config;
+	headless_config(&config, NULL, 4 * 1024 * 1024);
+	config.create_default_debuginator_items = false;
+	config.notifications_enabled = false;
+	config.get_time = profiler_get_time;
+	struct TheDebuginator* debuginator = headless_create_from_config(&config);
+
+	char paths[PROFILER_ITEMS][32];
+	const char* path_list[PROFILER_ITEMS];
+	const char* high_titles[PROFILER_ITEMS];
+	for (int i = 0; i < PROFILER_ITEMS; ++i) {
+		sprintf(paths[i], "Profiled/Quality %02d", i);
+		path_list[i] = paths[i];
+		high_titles[i] = "High";
+		debuginator_create_array_item(debuginator, NULL, paths[i], NULL, profiler_on_item_changed, NULL,
+			s_quality_titles, (void*)s_quality_values, 4, sizeof(s_quality_values[0]));
+	}
+	DebuginatorItem* preset = debuginator_create_preset_item(debuginator, "Profiled/Preset", path_list, high_titles, NULL, PROFILER_ITEMS);
+
+	debuginator_set_open(debuginator, true);
+	headless_run_frames(debuginator, 30);
+
+	DebuginatorTraceJsonWriter writer;
+	int trace_capacity = PROFILER_FRAMES * 16 * 1024;
+	char* trace = (char*)malloc((size_t)trace_capacity);
+	debuginator_trace_json_begin(&writer, trace, trace_capacity);
+	writer.pid = 1;
+	writer.tid = 1;
+	debuginator_set_trace_callback(debuginator, debuginator_trace_json_write, &writer);
+
+	for (int i = 0; i < PROFILER_FRAMES; ++i) {
+		debuginator_update(debuginator, 1 / 60.0f);
+		debuginator_update_filter(debuginator, i % 2 == 0 ? "quality 1" : "");
+		debuginator_activate(debuginator, preset, false);
+		debuginator_draw(debuginator, 1 / 60.0f);
+	}
+
+	// The last frame's times are added to the stats when the next one starts.
+	debuginator_update(debuginator, 1 / 60.0f);
+	debuginator_set_trace_callback(debuginator, NULL, NULL);
+	HEADLESS_CHECK(debuginator_trace_json_end(&writer));
+
+	static const DebuginatorProfileZone zones[] = {
+		DEBUGINATOR_ProfileUpdate, DEBUGINATOR_ProfileUpdateFilter, DEBUGINATOR_ProfileDraw,
+		DEBUGINATOR_ProfileDrawHierarchy, DEBUGINATOR_ProfileItemCallbacks, DEBUGINATOR_ProfileLayout,
+	};
+	for (int i = 0; i < PROFILER_COUNTOF(zones); ++i) {
+		DebuginatorProfileStats stats;
+		debuginator_get_profile_stats(debuginator, zones[i], &stats);
+		if (stats.num_frames == 0 || stats.max_ms <= 0) {
+			fprintf(stderr, "Zone %s wasn't timed\n", debuginator_get_profile_zone_name(zones[i]));
+			++g_headless_failures;
+		}
+	}
+
+	HEADLESS_CHECK(profiler_trace_is_valid(trace));
+	int num_events = 0;
+	HEADLESS_CHECK(profiler_trace_is_balanced(trace, &num_events));
+	HEADLESS_CHECK(num_events == writer.num_events);
+	HEADLESS_CHECK(num_events > 0);
+
+	// When the buffer runs out partway through a frame, the trace stops after the last event
+	// that fit, and can still be opened.
+	char small_trace[700];
+	debuginator_trace_json_begin(&writer, small_trace, (int)sizeof(small_trace));
+	debuginator_set_trace_callback(debuginator, debuginator_trace_json_write, &writer);
+	debuginator_update(debuginator, 1 / 60.0f);
+	debuginator_activate(debuginator, preset, false);
+	debuginator_draw(debuginator, 1 / 60.0f);
+	debuginator_set_trace_callback(debuginator, NULL, NULL);
+	HEADLESS_CHECK(!debuginator_trace_json_end(&writer));
+	HEADLESS_CHECK(profiler_trace_is_valid(small_trace));
+
+	free(trace);
+	headless_destroy(debuginator);
+	return g_headless_failures == 0 ? 0 : 1;
+}
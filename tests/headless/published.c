@@ -0,0 +1,71 @@
+// Test for published values, which other threads read with debuginator_read_bool etc.
+//
+// Activates published items of different types and checks that what's read back is what was
+// activated, and that with a callback buffer it's only published once the callbacks run. Also
+// checks that one is 8 byte aligned after a smaller member, which 32 bit x86 wouldn't do by
+// itself.
+//
+// Usage: published
+
+#define DEBUGINATOR_IMPLEMENTATION
+#include "headless.h"
+
+static const char* s_quality_titles[] = { "Off", "Low", "Medium", "High" };
+static int s_quality_values[] = { 0, 1, 2, 3 };
+static const char* s_scale_titles[] = { "Half", "One", "Two" };
+static float s_scale_values[] = { 0.5f, 1.0f, 2.0f };
+
+typedef struct PublishedSettings {
+	int version;
+	DebuginatorPublishedValue value;
+} PublishedSettings;
+
+int main(void) {
+	struct TheDebuginator* debuginator = headless_create(4 * 1024 * 1024, false);
+
+	DebuginatorPublishedValue published_bool;
+	DebuginatorPublishedValue published_quality;
+	DebuginatorPublishedValue published_scale;
+	memset(&published_bool, 0, sizeof(published_bool));
+	memset(&published_quality, 0, sizeof(published_quality));
+	memset(&published_scale, 0, sizeof(published_scale));
+	DebuginatorItem* bool_item = debuginator_create_published_bool_item(debuginator, "Published/Bool", NULL, &published_bool);
+	DebuginatorItem* quality_item = debuginator_create_array_item(debuginator, NULL, "Published/Quality", NULL, debuginator_publish_value, &published_quality,
+		s_quality_titles, (void*)s_quality_values, 4, sizeof(s_quality_values[0]));
+	DebuginatorItem* scale_item = debuginator_create_array_item(debuginator, NULL, "Published/Scale", NULL, debuginator_publish_value, &published_scale,
+		s_scale_titles, (void*)s_scale_values, 3, sizeof(s_scale_values[0]));
+
+	HEADLESS_CHECK(!debuginator_read_bool(&published_bool));
+	HEADLESS_CHECK(offsetof(PublishedSettings, value) == 8);
+
+	for (int i = 0; i < 12; ++i) {
+		bool_item->leaf.hot_index = (size_t)(i % 2);
+		debuginator_activate(debuginator, bool_item, false);
+		quality_item->leaf.hot_index = (size_t)(i % 4);
+		debuginator_activate(debuginator, quality_item, false);
+		scale_item->leaf.hot_index = (size_t)(i % 3);
+		debuginator_activate(debuginator, scale_item, false);
+		HEADLESS_CHECK(debuginator_read_bool(&published_bool) == (i % 2 == 1));
+		HEADLESS_CHECK(debuginator_read_int(&published_quality) == s_quality_values[i % 4]);
+		HEADLESS_CHECK(debuginator_read_float(&published_scale) == s_scale_values[i % 3]);
+	}
+
+	// With a callback buffer, readers see the old value until the callbacks are run.
+	DebuginatorItem* pending_items[4];
+	DebuginatorCallbackBuffer callback_buffer;
+	memset(&callback_buffer, 0, sizeof(callback_buffer));
+	callback_buffer.items = pending_items;
+	callback_buffer.capacity = 4;
+	debuginator_set_callback_buffer(debuginator, &callback_buffer);
+
+	int before = debuginator_read_int(&published_quality);
+	quality_item->leaf.hot_index = (size_t)((before + 1) % 4);
+	debuginator_activate(debuginator, quality_item, false);
+	HEADLESS_CHECK(debuginator_read_int(&published_quality) == before);
+	debuginator_run_callbacks(debuginator);
+	HEADLESS_CHECK(debuginator_read_int(&published_quality) == s_quality_values[(before + 1) % 4]);
+	debuginator_set_callback_buffer(debuginator, NULL);
+
+	headless_destroy(debuginator);
+	return g_headless_failures == 0 ? 0 : 1;
+}
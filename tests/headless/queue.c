@@ -0,0 +1,596 @@
+// Test for the_debuginator_queue.h.
+//
+// Records every kind of operation into a queue, processes it, and checks that the menu ends
+// up the same as if the operations had been done directly. Then has several threads record
+// into a ring queue at once while the main thread drains it, with a ring small enough that
+// it wraps around and fills up, and checks that every item arrived intact. Does the same with a
+// double buffered queue and one producer thread, and with a shared queue that a child process
+// records into, and that draining gets past a record that a child died halfway through. Checks
+// that a change queue gets every item activated on another thread, and reports what was lost
+// when a reader falls behind. Also times recording and processing.
+// Results are printed as one JSON object per line.
+//
+// Usage: queue [--items N] [--threads N]
+
+#define DEBUGINATOR_IMPLEMENTATION
+#include "headless.h"
+
+#define DEBUGINATOR_QUEUE_IMPLEMENTATION
+#define DEBUGINATOR_QUEUE_CAN_PROCEES
+#define DEBUGINATOR_QUEUE_SHARED_MEMORY
+#include "../../the_debuginator_queue.h"
+
+#include "thread.h"
+
+#ifndef _WIN32
+#include <sys/wait.h>
+#include <unistd.h>
+#endif
+
+#define QUEUE_MAX_THREADS 16
+#define QUEUE_RING_CAPACITY (64 * 1024)
+
+static void* queue_allocate(void* userdata, int bytes) {
+	(void)userdata;
+	return malloc((size_t)bytes);
+}
+
+static void queue_deallocate(void* userdata, void* ptr) {
+	(void)userdata;
+	free(ptr);
+}
+
+static bool s_bool_sink;
+static bool s_bool_callback_sink;
+static float s_float_sink = 0.5f;
+static int s_callback_count;
+static const char* s_quality_titles[] = { "Off", "Low", "High" };
+static int s_quality_values[] = { 0, 1, 2 };
+static const char* s_preset_paths[] = { "Queue/Quality" };
+static const char* s_preset_titles[] = { "High" };
+
+static void queue_on_item_changed(DebuginatorItem* item, void* value, const char* value_title, void* app_userdata) {
+	(void)item;
+	(void)value;
+	(void)value_title;
+	(void)app_userdata;
+	++s_callback_count;
+}
+
+static void queue_test_operations(void) {
+	struct TheDebuginator* debuginator = headless_create(4 * 1024 * 1024, false);
+
+	// Starts out small so that it has to grow.
+	TheDebuginatorQueue* queue = debuginator_queue_create(1, queue_allocate, queue_deallocate, NULL);
+	DebuginatorColor start_color = { 10, 20, 30, 255 };
+	debuginator_queue_create_bool_item(queue, "Queue/Bool", NULL, &s_bool_sink);
+	debuginator_queue_create_bool_item_with_callback(queue, "Queue/Bool with callback", "Has a description.", &s_bool_callback_sink, queue_on_item_changed);
+	debuginator_queue_create_array_item(queue, "Queue/Quality", NULL, queue_on_item_changed, NULL, s_quality_titles, s_quality_values, 3, sizeof(s_quality_values[0]));
+	debuginator_queue_create_numberrange_float_item(queue, "Queue/Float", NULL, &s_float_sink, 0, 1);
+	debuginator_queue_create_colorpicker_item(queue, "Queue/Color", NULL, NULL, NULL, &start_color);
+	debuginator_queue_create_preset_item(queue, "Queue/Preset", s_preset_paths, s_preset_titles, 1);
+	debuginator_queue_create_bool_item(queue, "Queue/Removed/A", NULL, &s_bool_sink);
+	debuginator_queue_create_bool_item(queue, "Queue/Removed/B", NULL, &s_bool_sink);
+	debuginator_queue_remove_item_by_path(queue, "Queue/Removed");
+	debuginator_queue_set_default_value(queue, "Queue/Quality", "Low", 0);
+	debuginator_queue_load_item(queue, "Queue/Bool", "True");
+	debuginator_queue_assign_hot_key(queue, "F1", "Queue/Quality", 0, "High");
+	debuginator_queue_assign_hot_key(queue, "F2", "Queue/Bool", 0, NULL);
+	debuginator_queue_unassign_hot_key(queue, "F2");
+
+	// Strings aren't limited in length by the queue, only by The Debuginator.
+	char long_path[200];
+	char long_description[2000];
+	memset(long_description, 'x', sizeof(long_description) - 1);
+	long_description[sizeof(long_description) - 1] = '\0';
+	snprintf(long_path, sizeof(long_path), "Queue/%0180d", 7);
+	debuginator_queue_create_bool_item(queue, long_path, long_description, &s_bool_sink);
+
+	// Nothing happens until it's processed.
+	HEADLESS_CHECK(debuginator_get_item(debuginator, NULL, "Queue", NULL) == NULL);
+
+	// Records only take as much space as their strings need.
+	int size = 0;
+	unsigned char* data = debuginator_queue_data(queue, &size);
+	HEADLESS_CHECK(size % DEBUGINATOR_QUEUE_RECORD_ALIGNMENT == 0);
+	HEADLESS_CHECK(size < 15 * 128 + (int)sizeof(long_path) + (int)sizeof(long_description));
+	debuginator_queue_process(data, size, debuginator);
+	debuginator_queue_clear(queue);
+	debuginator_queue_data(queue, &size);
+	HEADLESS_CHECK(size == 0);
+
+	DebuginatorItem* bool_item = debuginator_get_item(debuginator, NULL, "Queue/Bool", NULL);
+	HEADLESS_CHECK(bool_item != NULL && bool_item->leaf.edit_type == DEBUGINATOR_EditTypeBoolean);
+	HEADLESS_CHECK(bool_item != NULL && bool_item->leaf.active_index == 1 && s_bool_sink);
+	HEADLESS_CHECK(bool_item != NULL && bool_item->leaf.hot_key_index == DEBUGINATOR_NO_HOT_INDEX);
+
+	DebuginatorItem* callback_item = debuginator_get_item(debuginator, NULL, "Queue/Bool with callback", NULL);
+	HEADLESS_CHECK(callback_item != NULL && callback_item->leaf.on_item_changed_callback == queue_on_item_changed);
+	HEADLESS_CHECK(callback_item != NULL && strcmp(callback_item->leaf.description, "Has a description.") == 0);
+
+	DebuginatorItem* quality_item = debuginator_get_item(debuginator, NULL, "Queue/Quality", NULL);
+	HEADLESS_CHECK(quality_item != NULL && quality_item->leaf.num_values == 3 && quality_item->leaf.values == s_quality_values);
+	HEADLESS_CHECK(quality_item != NULL && quality_item->leaf.default_index == 1);
+	HEADLESS_CHECK(quality_item != NULL && quality_item->leaf.hot_key_index != DEBUGINATOR_NO_HOT_INDEX);
+	HEADLESS_CHECK(debuginator->num_hot_keys == 1 && debuginator->hot_keys[0].value_index == 2);
+
+	DebuginatorItem* float_item = debuginator_get_item(debuginator, NULL, "Queue/Float", NULL);
+	HEADLESS_CHECK(float_item != NULL && float_item->leaf.edit_type == DEBUGINATOR_EditTypeNumberRange);
+	HEADLESS_CHECK(float_item != NULL && ((float*)float_item->leaf.values)[2] == 0.5f);
+
+	DebuginatorItem* color_item = debuginator_get_item(debuginator, NULL, "Queue/Color", NULL);
+	HEADLESS_CHECK(color_item != NULL && color_item->leaf.edit_type == DEBUGINATOR_EditTypeColorPicker);
+	HEADLESS_CHECK(color_item != NULL && ((DebuginatorColor*)color_item->leaf.values)->g == 20);
+
+	DebuginatorItem* preset_item = debuginator_get_item(debuginator, NULL, "Queue/Preset", NULL);
+	HEADLESS_CHECK(preset_item != NULL && preset_item->leaf.edit_type == DEBUGINATOR_EditTypePreset);
+
+	HEADLESS_CHECK(debuginator_get_item(debuginator, NULL, "Queue/Removed", NULL) == NULL);
+	HEADLESS_CHECK(s_callback_count == 0);
+
+	DebuginatorItem* long_item = debuginator_get_item(debuginator, NULL, long_path, NULL);
+	HEADLESS_CHECK(long_item != NULL && strcmp(long_item->leaf.description, long_description) == 0);
+
+	debuginator_queue_destroy(queue);
+	headless_destroy(debuginator);
+}
+
+typedef struct QueueProducer {
+	TheDebuginatorQueue* queue;
+	int thread_index;
+	int num_items;
+	int num_retries;
+	volatile unsigned int done;
+} QueueProducer;
+
+static void queue_producer_run(QueueProducer* producer) {
+	char path[64];
+	for (int i = 0; i < producer->num_items; ++i) {
+		snprintf(path, sizeof(path), "Threads/Thread %02d/Item %06d", producer->thread_index, i);
+		while (!debuginator_queue_create_bool_item(producer->queue, path, path, &s_bool_sink)) {
+			// Full, wait for the main thread to drain it.
+			++producer->num_retries;
+			thread_yield();
+		}
+
+		// So that the main thread gets to run in between, even on one core.
+		if (i % 256 == 255) {
+			thread_yield();
+		}
+	}
+
+	DEBUGINATOR_QUEUE_atomic_store(&producer->done, 1);
+}
+
+THREAD_FUNCTION(queue_producer_thread) {
+	queue_producer_run((QueueProducer*)userdata);
+	return THREAD_RETURN;
+}
+
+// Each thread's items are in the order they were recorded, and the descriptions are the paths,
+// so a torn record would show up as a mismatch.
+static int queue_count_intact(struct TheDebuginator* debuginator, int num_threads, int num_items_per_thread) {
+	int num_intact = 0;
+	char path[64];
+	for (int thread_index = 0; thread_index < num_threads; ++thread_index) {
+		snprintf(path, sizeof(path), "Threads/Thread %02d", thread_index);
+		DebuginatorItem* folder = debuginator_get_item(debuginator, NULL, path, NULL);
+		DebuginatorItem* item = folder != NULL ? folder->folder.first_child : NULL;
+		for (int i = 0; i < num_items_per_thread && item != NULL; ++i, item = item->next_sibling) {
+			snprintf(path, sizeof(path), "Threads/Thread %02d/Item %06d", thread_index, i);
+			num_intact += strcmp(item->leaf.description, path) == 0 && strcmp(item->title, path + 18) == 0 ? 1 : 0;
+		}
+	}
+	return num_intact;
+}
+
+static void queue_test_threads(int num_threads, int num_items_per_thread) {
+	int num_items = num_threads * num_items_per_thread;
+	struct TheDebuginator* debuginator = headless_create((unsigned int)num_items * 512 + 4 * 1024 * 1024, false);
+	TheDebuginatorQueue* queue = debuginator_queue_create_ring(QUEUE_RING_CAPACITY, queue_allocate, queue_deallocate, NULL);
+
+	QueueProducer producers[QUEUE_MAX_THREADS];
+	Thread threads[QUEUE_MAX_THREADS];
+	unsigned long long start = headless_time_ns();
+	for (int i = 0; i < num_threads; ++i) {
+		producers[i].queue = queue;
+		producers[i].thread_index = i;
+		producers[i].num_items = num_items_per_thread;
+		producers[i].num_retries = 0;
+		producers[i].done = 0;
+		thread_start(&threads[i], queue_producer_thread, &producers[i]);
+	}
+
+	// Like a frame loop, except that it drains as fast as it can.
+	int num_processed = 0;
+	int num_drains = 0;
+	while (num_processed < num_items) {
+		int num_drained = debuginator_queue_drain(queue, debuginator);
+		num_processed += num_drained;
+		++num_drains;
+		if (num_drained == 0) {
+			thread_yield();
+		}
+	}
+	unsigned long long total_ns = headless_time_ns() - start;
+
+	int num_retries = 0;
+	for (int i = 0; i < num_threads; ++i) {
+		thread_join(threads[i]);
+		num_retries += producers[i].num_retries;
+	}
+
+	HEADLESS_CHECK(num_processed == num_items);
+	HEADLESS_CHECK(debuginator_queue_drain(queue, debuginator) == 0);
+	HEADLESS_CHECK(debuginator_queue_dropped(queue) == num_retries);
+
+	HEADLESS_CHECK(queue_count_intact(debuginator, num_threads, num_items_per_thread) == num_items);
+
+	printf("{\"case\":\"queue_ring_threads\",\"threads\":%d,\"items\":%d,\"ring_bytes\":%d,\"drains\":%d,\"full_retries\":%d,\"ns_per_item\":%.1f}\n",
+		num_threads, num_items, QUEUE_RING_CAPACITY, num_drains, num_retries, (double)total_ns / num_items);
+
+	debuginator_queue_destroy(queue);
+	headless_destroy(debuginator);
+}
+
+static void queue_test_double_buffered(int num_items) {
+	struct TheDebuginator* debuginator = headless_create((unsigned int)num_items * 512 + 4 * 1024 * 1024, false);
+	TheDebuginatorQueue* queue = debuginator_queue_create_double_buffered(1024, queue_allocate, queue_deallocate, NULL);
+
+	QueueProducer producer;
+	producer.queue = queue;
+	producer.thread_index = 0;
+	producer.num_items = num_items;
+	producer.num_retries = 0;
+	producer.done = 0;
+	Thread thread;
+	unsigned long long start = headless_time_ns();
+	thread_start(&thread, queue_producer_thread, &producer);
+
+	// A frame loop. Whatever was recorded before the producer said it was done is in the
+	// buffer that the swap after it returns.
+	int num_swaps = 0;
+	int max_swap_bytes = 0;
+	unsigned long long process_ns = 0;
+	for (;;) {
+		bool done = DEBUGINATOR_QUEUE_atomic_load(&producer.done) != 0;
+		int size = 0;
+		unsigned char* data = debuginator_queue_swap(queue, &size);
+		unsigned long long process_start = headless_time_ns();
+		debuginator_queue_process(data, size, debuginator);
+		process_ns += headless_time_ns() - process_start;
+		max_swap_bytes = size > max_swap_bytes ? size : max_swap_bytes;
+		++num_swaps;
+		if (done) {
+			break;
+		}
+
+		thread_yield();
+	}
+	unsigned long long total_ns = headless_time_ns() - start;
+	thread_join(thread);
+
+	int size = 0;
+	debuginator_queue_swap(queue, &size);
+	HEADLESS_CHECK(size == 0);
+	HEADLESS_CHECK(producer.num_retries == 0);
+	HEADLESS_CHECK(queue_count_intact(debuginator, 1, num_items) == num_items);
+
+	printf("{\"case\":\"queue_double_buffered\",\"items\":%d,\"swaps\":%d,\"max_swap_bytes\":%d,\"ns_per_item\":%.1f,\"ns_per_process\":%.1f}\n",
+		num_items, num_swaps, max_swap_bytes, (double)total_ns / num_items, (double)process_ns / num_items);
+
+	debuginator_queue_destroy(queue);
+	headless_destroy(debuginator);
+}
+
+#ifndef _WIN32
+// Forked, so that the producer has an address space of its own, like a tool would.
+static void queue_test_shared(int num_items) {
+	char name[64];
+	snprintf(name, sizeof(name), "debuginator_queue_test_%d", (int)getpid());
+	HEADLESS_CHECK(debuginator_queue_open_shared(name, queue_allocate, queue_deallocate, NULL) == NULL);
+	TheDebuginatorQueue* queue = debuginator_queue_create_shared(name, QUEUE_RING_CAPACITY, queue_allocate, queue_deallocate, NULL);
+	HEADLESS_CHECK(queue != NULL);
+	if (queue == NULL) {
+		return;
+	}
+
+	struct TheDebuginator* debuginator = headless_create((unsigned int)num_items * 512 + 4 * 1024 * 1024, false);
+
+	unsigned long long start = headless_time_ns();
+	pid_t child = fork();
+	if (child == 0) {
+		TheDebuginatorQueue* child_queue = debuginator_queue_open_shared(name, queue_allocate, queue_deallocate, NULL);
+		if (child_queue == NULL) {
+			_exit(1);
+		}
+
+		char path[64];
+		for (int i = 0; i < num_items; ++i) {
+			// A pointer means nothing in the other process, so it's ignored there.
+			snprintf(path, sizeof(path), "Shared/Item %06d", i);
+			while (!debuginator_queue_create_bool_item(child_queue, path, path, i == 0 ? &s_bool_sink : NULL)) {
+				thread_yield();
+			}
+
+			if (i % 256 == 255) {
+				thread_yield();
+			}
+		}
+
+		while (!debuginator_queue_load_item(child_queue, "Shared/Item 000000", "True")) {
+			thread_yield();
+		}
+
+		debuginator_queue_destroy(child_queue);
+		_exit(0);
+	}
+
+	// Once it has exited, everything it recorded is committed, and the drain after that gets it.
+	int num_processed = 0;
+	int num_drains = 0;
+	int status = 1;
+	bool exited = child < 0;
+	while (!exited) {
+		exited = waitpid(child, &status, WNOHANG) == child;
+		int num_drained = debuginator_queue_drain(queue, debuginator);
+		num_processed += num_drained;
+		++num_drains;
+		if (num_drained == 0 && !exited) {
+			thread_yield();
+		}
+	}
+	unsigned long long total_ns = headless_time_ns() - start;
+
+	HEADLESS_CHECK(WIFEXITED(status) && WEXITSTATUS(status) == 0);
+	HEADLESS_CHECK(num_processed == num_items + 1);
+
+	int num_intact = 0;
+	DebuginatorItem* folder = debuginator_get_item(debuginator, NULL, "Shared", NULL);
+	DebuginatorItem* item = folder != NULL ? folder->folder.first_child : NULL;
+	char path[64];
+	for (int i = 0; i < num_items && item != NULL; ++i, item = item->next_sibling) {
+		snprintf(path, sizeof(path), "Shared/Item %06d", i);
+		num_intact += strcmp(item->leaf.description, path) == 0 && item->user_data == NULL ? 1 : 0;
+	}
+	HEADLESS_CHECK(num_intact == num_items);
+
+	DebuginatorItem* first_item = debuginator_get_item(debuginator, NULL, "Shared/Item 000000", NULL);
+	HEADLESS_CHECK(first_item != NULL && first_item->leaf.active_index == 1);
+
+	printf("{\"case\":\"queue_shared_process\",\"items\":%d,\"ring_bytes\":%d,\"drains\":%d,\"ns_per_item\":%.1f}\n",
+		num_items, QUEUE_RING_CAPACITY, num_drains, (double)total_ns / num_items);
+
+	// Removed with the owner's queue.
+	debuginator_queue_destroy(queue);
+	HEADLESS_CHECK(debuginator_queue_open_shared(name, queue_allocate, queue_deallocate, NULL) == NULL);
+	headless_destroy(debuginator);
+}
+
+// A child process that dies halfway through recording leaves a record that's reserved but never
+// committed. Draining skips it after a while, and gets to what the child recorded after it.
+static void queue_test_shared_stuck(void) {
+	char name[64];
+	snprintf(name, sizeof(name), "debuginator_queue_stuck_%d", (int)getpid());
+	TheDebuginatorQueue* queue = debuginator_queue_create_shared(name, QUEUE_RING_CAPACITY, queue_allocate, queue_deallocate, NULL);
+	HEADLESS_CHECK(queue != NULL);
+	if (queue == NULL) {
+		return;
+	}
+
+	struct TheDebuginator* debuginator = headless_create(4 * 1024 * 1024, false);
+	pid_t child = fork();
+	if (child == 0) {
+		TheDebuginatorQueue* child_queue = debuginator_queue_open_shared(name, queue_allocate, queue_deallocate, NULL);
+		bool recorded = child_queue != NULL
+			&& debuginator_queue__push(child_queue, DEBUGINATOR_QUEUE_CreateItem, sizeof(DebuginatorQueueItem)) != NULL
+			&& debuginator_queue_create_bool_item(child_queue, "Stuck/After", NULL, NULL);
+		_exit(recorded ? 0 : 1);
+	}
+
+	int status = 1;
+	HEADLESS_CHECK(child > 0 && waitpid(child, &status, 0) == child && WIFEXITED(status) && WEXITSTATUS(status) == 0);
+
+	int num_processed = 0;
+	for (int i = 0; i < DEBUGINATOR_QUEUE_STUCK_DRAINS - 1; ++i) {
+		num_processed += debuginator_queue_drain(queue, debuginator);
+	}
+	HEADLESS_CHECK(num_processed == 0);
+	HEADLESS_CHECK(debuginator_queue_dropped(queue) == 0);
+	HEADLESS_CHECK(debuginator_queue_drain(queue, debuginator) == 1);
+	HEADLESS_CHECK(debuginator_queue_dropped(queue) == 1);
+	HEADLESS_CHECK(debuginator_get_item(debuginator, NULL, "Stuck/After", NULL) != NULL);
+
+	debuginator_queue_destroy(queue);
+	headless_destroy(debuginator);
+}
+#endif
+
+typedef struct QueuePublisher {
+	struct TheDebuginator* debuginator;
+	int num_items;
+	volatile unsigned int done;
+} QueuePublisher;
+
+// Stands in for the menu thread, turning every item on.
+THREAD_FUNCTION(queue_publisher_thread) {
+	QueuePublisher* publisher = (QueuePublisher*)userdata;
+	DebuginatorItem* item = debuginator_get_item(publisher->debuginator, NULL, "Changes", NULL)->folder.first_child;
+	for (int i = 0; i < publisher->num_items; ++i, item = item->next_sibling) {
+		item->leaf.hot_index = 1;
+		debuginator_activate(publisher->debuginator, item, false);
+		if (i % 64 == 63) {
+			thread_yield();
+		}
+	}
+
+	DEBUGINATOR_QUEUE_atomic_store(&publisher->done, 1);
+	return THREAD_RETURN;
+}
+
+static void queue_test_changes(int num_items) {
+	struct TheDebuginator* debuginator = headless_create((unsigned int)num_items * 512 + 4 * 1024 * 1024, false);
+	unsigned int* ids = (unsigned int*)malloc((size_t)num_items * sizeof(unsigned int));
+	for (int i = 0; i < num_items; ++i) {
+		char path[64];
+		snprintf(path, sizeof(path), "Changes/Item %06d", i);
+		debuginator_create_bool_item(debuginator, path, NULL, NULL);
+		ids[i] = debuginator_queue_path_id(path);
+	}
+
+	// Plenty of room, so nothing is lost even if the reader only gets to run now and then.
+	TheDebuginatorQueue* queue = debuginator_queue_create_changes(debuginator, num_items, queue_allocate, queue_deallocate, NULL);
+	DebuginatorQueueChangeReader reader;
+	debuginator_queue_init_change_reader(queue, &reader);
+
+	QueuePublisher publisher;
+	publisher.debuginator = debuginator;
+	publisher.num_items = num_items;
+	publisher.done = 0;
+	Thread thread;
+	unsigned long long start = headless_time_ns();
+	thread_start(&thread, queue_publisher_thread, &publisher);
+
+	// Events come in the order that the items were activated.
+	int num_events = 0;
+	int num_intact = 0;
+	int num_reads = 0;
+	DebuginatorQueueChangeEvent events[64];
+	for (;;) {
+		bool done = DEBUGINATOR_QUEUE_atomic_load(&publisher.done) != 0;
+		int num_read = debuginator_queue_read_changes(queue, &reader, events, 64);
+		for (int i = 0; i < num_read; ++i, ++num_events) {
+			DebuginatorQueueChangeEvent* event = &events[i];
+			num_intact += num_events < num_items && event->item_id == ids[num_events] && event->value_index == 1 && event->value_size == 1 && event->value[0] == 1 ? 1 : 0;
+		}
+
+		++num_reads;
+		if (done && num_read == 0) {
+			break;
+		}
+
+		if (num_read == 0) {
+			thread_yield();
+		}
+	}
+	unsigned long long total_ns = headless_time_ns() - start;
+	thread_join(thread);
+
+	HEADLESS_CHECK(reader.lost == 0);
+	HEADLESS_CHECK(num_events == num_items);
+	HEADLESS_CHECK(num_intact == num_items);
+
+	// Action items have no value.
+	DebuginatorItem* action = debuginator_create_array_item(debuginator, NULL, "Changes Action", NULL, queue_on_item_changed, NULL, NULL, NULL, 0, 0);
+	debuginator_activate(debuginator, action, false);
+	HEADLESS_CHECK(debuginator_queue_read_changes(queue, &reader, events, 64) == 1);
+	HEADLESS_CHECK(events[0].item_id == debuginator_queue_path_id("Changes Action") && events[0].value_index == -1 && events[0].value_size == 0);
+
+	// A reader that doesn't keep up loses the oldest events, and is told how many.
+	DebuginatorQueueChangeReader slow_reader;
+	debuginator_queue_init_change_reader(queue, &slow_reader);
+	int capacity = (int)queue->changes->capacity;
+	int num_overflowing = 10;
+	for (int i = 0; i < capacity + num_overflowing; ++i) {
+		debuginator_activate(debuginator, action, false);
+	}
+
+	int num_slow_events = 0;
+	int num_read = 0;
+	while ((num_read = debuginator_queue_read_changes(queue, &slow_reader, events, 64)) > 0) {
+		num_slow_events += num_read;
+	}
+	HEADLESS_CHECK(slow_reader.lost == num_overflowing);
+	HEADLESS_CHECK(num_slow_events == capacity);
+
+	printf("{\"case\":\"queue_changes\",\"items\":%d,\"reads\":%d,\"lost_when_behind\":%d,\"ns_per_item\":%.1f}\n",
+		num_items, num_reads, slow_reader.lost, (double)total_ns / num_items);
+
+	// Stops publishing.
+	debuginator_queue_destroy(queue);
+	HEADLESS_CHECK(debuginator->item_changed_listener == NULL);
+
+#ifndef _WIN32
+	// Readers of a shared one open it by name.
+	char name[64];
+	snprintf(name, sizeof(name), "debuginator_changes_test_%d", (int)getpid());
+	queue = debuginator_queue_create_shared_changes(debuginator, name, 64, queue_allocate, queue_deallocate, NULL);
+	TheDebuginatorQueue* opened = debuginator_queue_open_shared_changes(name, queue_allocate, queue_deallocate, NULL);
+	HEADLESS_CHECK(queue != NULL && opened != NULL);
+	if (queue != NULL && opened != NULL) {
+		debuginator_queue_init_change_reader(opened, &reader);
+		debuginator_activate(debuginator, action, false);
+		HEADLESS_CHECK(debuginator_queue_read_changes(opened, &reader, events, 64) == 1);
+		HEADLESS_CHECK(events[0].item_id == debuginator_queue_path_id("Changes Action"));
+	}
+
+	if (opened != NULL) {
+		debuginator_queue_destroy(opened);
+	}
+	if (queue != NULL) {
+		debuginator_queue_destroy(queue);
+	}
+#endif
+	free(ids);
+	headless_destroy(debuginator);
+}
+
+static void queue_benchmark(int num_items) {
+	struct TheDebuginator* debuginator = headless_create((unsigned int)num_items * 512 + 4 * 1024 * 1024, false);
+	TheDebuginatorQueue* queue = debuginator_queue_create(16, queue_allocate, queue_deallocate, NULL);
+
+	char path[64];
+	unsigned long long start = headless_time_ns();
+	for (int i = 0; i < num_items; ++i) {
+		snprintf(path, sizeof(path), "Queue/Group %02d/Item %06d", i % 64, i);
+		debuginator_queue_create_bool_item(queue, path, NULL, &s_bool_sink);
+	}
+	unsigned long long record_ns = headless_time_ns() - start;
+
+	int size = 0;
+	unsigned char* data = debuginator_queue_data(queue, &size);
+	start = headless_time_ns();
+	debuginator_queue_process(data, size, debuginator);
+	unsigned long long process_ns = headless_time_ns() - start;
+
+	HEADLESS_CHECK(debuginator_get_item(debuginator, NULL, path, NULL) != NULL);
+	printf("{\"case\":\"queue_bool_items\",\"items\":%d,\"bytes\":%d,\"bytes_per_item\":%.1f,\"ns_per_record\":%.1f,\"ns_per_process\":%.1f}\n",
+		num_items, size, (double)size / num_items, (double)record_ns / num_items, (double)process_ns / num_items);
+
+	debuginator_queue_destroy(queue);
+	headless_destroy(debuginator);
+}
+
+int main(int argc, char** argv) {
+	int num_items = 10000;
+	int num_threads = 4;
+	for (int i = 1; i < argc; ++i) {
+		if (strcmp(argv[i], "--items") == 0 && i + 1 < argc) {
+			num_items = atoi(argv[++i]);
+		}
+		else if (strcmp(argv[i], "--threads") == 0 && i + 1 < argc) {
+			num_threads = atoi(argv[++i]);
+		}
+		else {
+			fprintf(stderr, "Usage: %s [--items N] [--threads N]\n", argv[0]);
+			return 1;
+		}
+	}
+
+	if (num_items <= 0) {
+		num_items = 1;
+	}
+
+	num_threads = num_threads < 1 ? 1 : (num_threads > QUEUE_MAX_THREADS ? QUEUE_MAX_THREADS : num_threads);
+
+	queue_test_operations();
+	queue_test_threads(num_threads, num_items / num_threads);
+	queue_test_double_buffered(num_items / num_threads);
+#ifndef _WIN32
+	queue_test_shared(num_items / num_threads);
+	queue_test_shared_stuck();
+#endif
+	queue_test_changes(num_items / num_threads);
+	queue_benchmark(num_items);
+	return g_headless_failures == 0 ? 0 : 1;
+}
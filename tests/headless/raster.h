@@ -0,0 +1,283 @@
+#ifndef DEBUGINATOR_RASTER_H
+#define DEBUGINATOR_RASTER_H
+
+// A small software rasterizer for the headless test programs. It implements the draw
+// callbacks into an RGBA framebuffer, with an embedded 5x9 bitmap font drawn in the same
+// 8x16 cells that headless_text_size measures. Include headless.h before this.
+//
+// It's made to be simple and deterministic rather than fast or pretty: rects are snapped
+// to whole pixels, alpha is blended per pixel and images are drawn as flat rects.
+
+#include <math.h>
+
+#define RASTER_GLYPH_WIDTH 5
+#define RASTER_GLYPH_HEIGHT 9
+#define RASTER_GLYPH_TOP 4 // From the top of the cell
+
+typedef struct RasterTarget {
+	int width;
+	int height;
+	unsigned char* pixels; // RGBA, rows top to bottom
+} RasterTarget;
+
+// Printable ASCII, one byte per row, most significant of the five bits is the leftmost pixel.
+// The bottom two rows are for descenders.
+static const unsigned char s_raster_font['~' - ' ' + 1][RASTER_GLYPH_HEIGHT] = {
+	{ 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00 }, // space
+	{ 0x04, 0x04, 0x04, 0x04, 0x04, 0x00, 0x04, 0x00, 0x00 }, // !
+	{ 0x0a, 0x0a, 0x0a, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00 }, // "
+	{ 0x0a, 0x0a, 0x1f, 0x0a, 0x1f, 0x0a, 0x0a, 0x00, 0x00 }, // #
+	{ 0x04, 0x0f, 0x14, 0x0e, 0x05, 0x1e, 0x04, 0x00, 0x00 }, // $
+	{ 0x18, 0x19, 0x02, 0x04, 0x08, 0x13, 0x03, 0x00, 0x00 }, // %
+	{ 0x0c, 0x12, 0x14, 0x08, 0x15, 0x12, 0x0d, 0x00, 0x00 }, // &
+	{ 0x04, 0x04, 0x04, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00 }, // '
+	{ 0x02, 0x04, 0x08, 0x08, 0x08, 0x04, 0x02, 0x00, 0x00 }, // (
+	{ 0x08, 0x04, 0x02, 0x02, 0x02, 0x04, 0x08, 0x00, 0x00 }, // )
+	{ 0x00, 0x04, 0x15, 0x0e, 0x15, 0x04, 0x00, 0x00, 0x00 }, // *
+	{ 0x00, 0x04, 0x04, 0x1f, 0x04, 0x04, 0x00, 0x00, 0x00 }, // +
+	{ 0x00, 0x00, 0x00, 0x00, 0x00, 0x0c, 0x0c, 0x04, 0x08 }, // ,
+	{ 0x00, 0x00, 0x00, 0x1f, 0x00, 0x00, 0x00, 0x00, 0x00 }, // -
+	{ 0x00, 0x00, 0x00, 0x00, 0x00, 0x0c, 0x0c, 0x00, 0x00 }, // .
+	{ 0x00, 0x01, 0x02, 0x04, 0x08, 0x10, 0x00, 0x00, 0x00 }, // /
+	{ 0x0e, 0x11, 0x13, 0x15, 0x19, 0x11, 0x0e, 0x00, 0x00 }, // 0
+	{ 0x04, 0x0c, 0x04, 0x04, 0x04, 0x04, 0x0e, 0x00, 0x00 }, // 1
+	{ 0x0e, 0x11, 0x01, 0x02, 0x04, 0x08, 0x1f, 0x00, 0x00 }, // 2
+	{ 0x1f, 0x02, 0x04, 0x02, 0x01, 0x11, 0x0e, 0x00, 0x00 }, // 3
+	{ 0x02, 0x06, 0x0a, 0x12, 0x1f, 0x02, 0x02, 0x00, 0x00 }, // 4
+	{ 0x1f, 0x10, 0x1e, 0x01, 0x01, 0x11, 0x0e, 0x00, 0x00 }, // 5
+	{ 0x06, 0x08, 0x10, 0x1e, 0x11, 0x11, 0x0e, 0x00, 0x00 }, // 6
+	{ 0x1f, 0x01, 0x02, 0x04, 0x08, 0x08, 0x08, 0x00, 0x00 }, // 7
+	{ 0x0e, 0x11, 0x11, 0x0e, 0x11, 0x11, 0x0e, 0x00, 0x00 }, // 8
+	{ 0x0e, 0x11, 0x11, 0x0f, 0x01, 0x02, 0x0c, 0x00, 0x00 }, // 9
+	{ 0x00, 0x0c, 0x0c, 0x00, 0x0c, 0x0c, 0x00, 0x00, 0x00 }, // :
+	{ 0x00, 0x0c, 0x0c, 0x00, 0x0c, 0x0c, 0x04, 0x08, 0x00 }, // ;
+	{ 0x02, 0x04, 0x08, 0x10, 0x08, 0x04, 0x02, 0x00, 0x00 }, // <
+	{ 0x00, 0x00, 0x1f, 0x00, 0x1f, 0x00, 0x00, 0x00, 0x00 }, // =
+	{ 0x08, 0x04, 0x02, 0x01, 0x02, 0x04, 0x08, 0x00, 0x00 }, // >
+	{ 0x0e, 0x11, 0x01, 0x02, 0x04, 0x00, 0x04, 0x00, 0x00 }, // ?
+	{ 0x0e, 0x11, 0x01, 0x0d, 0x15, 0x15, 0x0e, 0x00, 0x00 }, // @
+	{ 0x0e, 0x11, 0x11, 0x1f, 0x11, 0x11, 0x11, 0x00, 0x00 }, // A
+	{ 0x1e, 0x11, 0x11, 0x1e, 0x11, 0x11, 0x1e, 0x00, 0x00 }, // B
+	{ 0x0e, 0x11, 0x10, 0x10, 0x10, 0x11, 0x0e, 0x00, 0x00 }, // C
+	{ 0x1c, 0x12, 0x11, 0x11, 0x11, 0x12, 0x1c, 0x00, 0x00 }, // D
+	{ 0x1f, 0x10, 0x10, 0x1e, 0x10, 0x10, 0x1f, 0x00, 0x00 }, // E
+	{ 0x1f, 0x10, 0x10, 0x1e, 0x10, 0x10, 0x10, 0x00, 0x00 }, // F
+	{ 0x0e, 0x11, 0x10, 0x17, 0x11, 0x11, 0x0f, 0x00, 0x00 }, // G
+	{ 0x11, 0x11, 0x11, 0x1f, 0x11, 0x11, 0x11, 0x00, 0x00 }, // H
+	{ 0x0e, 0x04, 0x04, 0x04, 0x04, 0x04, 0x0e, 0x00, 0x00 }, // I
+	{ 0x07, 0x02, 0x02, 0x02, 0x02, 0x12, 0x0c, 0x00, 0x00 }, // J
+	{ 0x11, 0x12, 0x14, 0x18, 0x14, 0x12, 0x11, 0x00, 0x00 }, // K
+	{ 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x1f, 0x00, 0x00 }, // L
+	{ 0x11, 0x1b, 0x15, 0x15, 0x11, 0x11, 0x11, 0x00, 0x00 }, // M
+	{ 0x11, 0x11, 0x19, 0x15, 0x13, 0x11, 0x11, 0x00, 0x00 }, // N
+	{ 0x0e, 0x11, 0x11, 0x11, 0x11, 0x11, 0x0e, 0x00, 0x00 }, // O
+	{ 0x1e, 0x11, 0x11, 0x1e, 0x10, 0x10, 0x10, 0x00, 0x00 }, // P
+	{ 0x0e, 0x11, 0x11, 0x11, 0x15, 0x12, 0x0d, 0x00, 0x00 }, // Q
+	{ 0x1e, 0x11, 0x11, 0x1e, 0x14, 0x12, 0x11, 0x00, 0x00 }, // R
+	{ 0x0f, 0x10, 0x10, 0x0e, 0x01, 0x01, 0x1e, 0x00, 0x00 }, // S
+	{ 0x1f, 0x04, 0x04, 0x04, 0x04, 0x04, 0x04, 0x00, 0x00 }, // T
+	{ 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x0e, 0x00, 0x00 }, // U
+	{ 0x11, 0x11, 0x11, 0x11, 0x11, 0x0a, 0x04, 0x00, 0x00 }, // V
+	{ 0x11, 0x11, 0x11, 0x15, 0x15, 0x15, 0x0a, 0x00, 0x00 }, // W
+	{ 0x11, 0x11, 0x0a, 0x04, 0x0a, 0x11, 0x11, 0x00, 0x00 }, // X
+	{ 0x11, 0x11, 0x0a, 0x04, 0x04, 0x04, 0x04, 0x00, 0x00 }, // Y
+	{ 0x1f, 0x01, 0x02, 0x04, 0x08, 0x10, 0x1f, 0x00, 0x00 }, // Z
+	{ 0x0e, 0x08, 0x08, 0x08, 0x08, 0x08, 0x0e, 0x00, 0x00 }, // [
+	{ 0x00, 0x10, 0x08, 0x04, 0x02, 0x01, 0x00, 0x00, 0x00 }, // backslash
+	{ 0x0e, 0x02, 0x02, 0x02, 0x02, 0x02, 0x0e, 0x00, 0x00 }, // ]
+	{ 0x04, 0x0a, 0x11, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00 }, // ^
+	{ 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x1f, 0x00, 0x00 }, // _
+	{ 0x08, 0x04, 0x02, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00 }, // `
+	{ 0x00, 0x00, 0x0e, 0x01, 0x0f, 0x11, 0x0f, 0x00, 0x00 }, // a
+	{ 0x10, 0x10, 0x16, 0x19, 0x11, 0x11, 0x1e, 0x00, 0x00 }, // b
+	{ 0x00, 0x00, 0x0e, 0x10, 0x10, 0x11, 0x0e, 0x00, 0x00 }, // c
+	{ 0x01, 0x01, 0x0d, 0x13, 0x11, 0x11, 0x0f, 0x00, 0x00 }, // d
+	{ 0x00, 0x00, 0x0e, 0x11, 0x1f, 0x10, 0x0e, 0x00, 0x00 }, // e
+	{ 0x06, 0x09, 0x08, 0x1c, 0x08, 0x08, 0x08, 0x00, 0x00 }, // f
+	{ 0x00, 0x00, 0x0f, 0x11, 0x11, 0x0f, 0x01, 0x01, 0x0e }, // g
+	{ 0x10, 0x10, 0x16, 0x19, 0x11, 0x11, 0x11, 0x00, 0x00 }, // h
+	{ 0x04, 0x00, 0x0c, 0x04, 0x04, 0x04, 0x0e, 0x00, 0x00 }, // i
+	{ 0x02, 0x00, 0x06, 0x02, 0x02, 0x02, 0x02, 0x12, 0x0c }, // j
+	{ 0x10, 0x10, 0x12, 0x14, 0x18, 0x14, 0x12, 0x00, 0x00 }, // k
+	{ 0x0c, 0x04, 0x04, 0x04, 0x04, 0x04, 0x0e, 0x00, 0x00 }, // l
+	{ 0x00, 0x00, 0x1a, 0x15, 0x15, 0x11, 0x11, 0x00, 0x00 }, // m
+	{ 0x00, 0x00, 0x16, 0x19, 0x11, 0x11, 0x11, 0x00, 0x00 }, // n
+	{ 0x00, 0x00, 0x0e, 0x11, 0x11, 0x11, 0x0e, 0x00, 0x00 }, // o
+	{ 0x00, 0x00, 0x1e, 0x11, 0x11, 0x1e, 0x10, 0x10, 0x10 }, // p
+	{ 0x00, 0x00, 0x0f, 0x11, 0x11, 0x0f, 0x01, 0x01, 0x01 }, // q
+	{ 0x00, 0x00, 0x16, 0x19, 0x10, 0x10, 0x10, 0x00, 0x00 }, // r
+	{ 0x00, 0x00, 0x0e, 0x10, 0x0e, 0x01, 0x1e, 0x00, 0x00 }, // s
+	{ 0x08, 0x08, 0x1c, 0x08, 0x08, 0x09, 0x06, 0x00, 0x00 }, // t
+	{ 0x00, 0x00, 0x11, 0x11, 0x11, 0x13, 0x0d, 0x00, 0x00 }, // u
+	{ 0x00, 0x00, 0x11, 0x11, 0x11, 0x0a, 0x04, 0x00, 0x00 }, // v
+	{ 0x00, 0x00, 0x11, 0x11, 0x15, 0x15, 0x0a, 0x00, 0x00 }, // w
+	{ 0x00, 0x00, 0x11, 0x0a, 0x04, 0x0a, 0x11, 0x00, 0x00 }, // x
+	{ 0x00, 0x00, 0x11, 0x11, 0x11, 0x0f, 0x01, 0x01, 0x0e }, // y
+	{ 0x00, 0x00, 0x1f, 0x02, 0x04, 0x08, 0x1f, 0x00, 0x00 }, // z
+	{ 0x02, 0x04, 0x04, 0x08, 0x04, 0x04, 0x02, 0x00, 0x00 }, // {
+	{ 0x04, 0x04, 0x04, 0x04, 0x04, 0x04, 0x04, 0x00, 0x00 }, // |
+	{ 0x08, 0x04, 0x04, 0x02, 0x04, 0x04, 0x08, 0x00, 0x00 }, // }
+	{ 0x00, 0x00, 0x08, 0x15, 0x02, 0x00, 0x00, 0x00, 0x00 }, // ~
+};
+
+static void raster_create(RasterTarget* target, int width, int height) {
+	target->width = width;
+	target->height = height;
+	target->pixels = (unsigned char*)calloc((size_t)width * (size_t)height, 4);
+}
+
+static void raster_destroy(RasterTarget* target) {
+	free(target->pixels);
+	target->pixels = NULL;
+}
+
+static void raster_clear(RasterTarget* target, DebuginatorColor color) {
+	for (int i = 0; i < target->width * target->height; ++i) {
+		unsigned char* pixel = target->pixels + (size_t)i * 4;
+		pixel[0] = color.r;
+		pixel[1] = color.g;
+		pixel[2] = color.b;
+		pixel[3] = 255;
+	}
+}
+
+static void raster_blend_pixel(unsigned char* pixel, DebuginatorColor color) {
+	int alpha = color.a;
+	pixel[0] = (unsigned char)((color.r * alpha + pixel[0] * (255 - alpha) + 127) / 255);
+	pixel[1] = (unsigned char)((color.g * alpha + pixel[1] * (255 - alpha) + 127) / 255);
+	pixel[2] = (unsigned char)((color.b * alpha + pixel[2] * (255 - alpha) + 127) / 255);
+}
+
+// Fills the pixels whose centers are inside the rect.
+static void raster_fill(RasterTarget* target, float x, float y, float width, float height, DebuginatorColor color) {
+	int x0 = (int)floorf(x + 0.5f);
+	int y0 = (int)floorf(y + 0.5f);
+	int x1 = (int)floorf(x + width + 0.5f);
+	int y1 = (int)floorf(y + height + 0.5f);
+	x0 = x0 < 0 ? 0 : x0;
+	y0 = y0 < 0 ? 0 : y0;
+	x1 = x1 > target->width ? target->width : x1;
+	y1 = y1 > target->height ? target->height : y1;
+	for (int row = y0; row < y1; ++row) {
+		unsigned char* pixel = target->pixels + ((size_t)row * (size_t)target->width + (size_t)x0) * 4;
+		for (int column = x0; column < x1; ++column, pixel += 4) {
+			raster_blend_pixel(pixel, color);
+		}
+	}
+}
+
+static void raster_draw_rect(DebuginatorVector2* position, DebuginatorVector2* size, DebuginatorColor* color, void* userdata) {
+	++g_headless_calls.draw_rect;
+	raster_fill((RasterTarget*)userdata, position->x, position->y, size->x, size->y, *color);
+}
+
+// Like the SDL demo, position is where the text starts and the middle of the line.
+static void raster_draw_text(const char* text, DebuginatorVector2* position, DebuginatorColor* color, DebuginatorFont* font, void* userdata) {
+	(void)font;
+	++g_headless_calls.draw_text;
+	RasterTarget* target = (RasterTarget*)userdata;
+	int cell_x = (int)floorf(position->x + 0.5f);
+	int top = (int)floorf(position->y - HEADLESS_CHAR_HEIGHT / 2 + 0.5f) + RASTER_GLYPH_TOP;
+	for (const char* c = text; *c != '\0'; ++c, cell_x += (int)HEADLESS_CHAR_WIDTH) {
+		if (*c <= ' ' || *c > '~') {
+			continue;
+		}
+
+		const unsigned char* glyph = s_raster_font[*c - ' '];
+		for (int row = 0; row < RASTER_GLYPH_HEIGHT; ++row) {
+			int y = top + row;
+			if (y < 0 || y >= target->height) {
+				continue;
+			}
+
+			for (int column = 0; column < RASTER_GLYPH_WIDTH; ++column) {
+				int x = cell_x + 1 + column;
+				if (x >= 0 && x < target->width && (glyph[row] & (0x10 >> column)) != 0) {
+					raster_blend_pixel(target->pixels + ((size_t)y * (size_t)target->width + (size_t)x) * 4, *color);
+				}
+			}
+		}
+	}
+}
+
+static void raster_draw_image(DebuginatorVector2* position, DebuginatorVector2* size, DebuginatorImageHandle handle, void* userdata) {
+	(void)handle;
+	++g_headless_calls.draw_image;
+	DebuginatorColor color = { 128, 128, 128, 255 };
+	raster_fill((RasterTarget*)userdata, position->x, position->y, size->x, size->y, color);
+}
+
+// Same as headless_config, but draws into target.
+static void raster_config(TheDebuginatorConfig* config, char* memory_arena, unsigned int memory_arena_capacity, RasterTarget* target) {
+	headless_config(config, memory_arena, memory_arena_capacity);
+	config->draw_text = raster_draw_text;
+	config->draw_rect = raster_draw_rect;
+	config->draw_image = raster_draw_image;
+	config->app_user_data = target;
+	config->size.x = (float)target->width;
+	config->size.y = (float)target->height;
+	config->screen_resolution.x = (float)target->width;
+	config->screen_resolution.y = (float)target->height;
+}
+
+// Binary PPM, which any image viewer can open.
+static bool raster_write_ppm(const RasterTarget* target, const char* path) {
+	FILE* file = fopen(path, "wb");
+	if (file == NULL) {
+		return false;
+	}
+
+	fprintf(file, "P6\n%d %d\n255\n", target->width, target->height);
+	for (int i = 0; i < target->width * target->height; ++i) {
+		fwrite(target->pixels + (size_t)i * 4, 1, 3, file);
+	}
+	return fclose(file) == 0;
+}
+
+// Only reads what raster_write_ppm writes. The target is created with the image's size.
+static bool raster_read_ppm(RasterTarget* target, const char* path) {
+	FILE* file = fopen(path, "rb");
+	if (file == NULL) {
+		return false;
+	}
+
+	int width = 0;
+	int height = 0;
+	int max_value = 0;
+	if (fscanf(file, "P6 %d %d %d", &width, &height, &max_value) != 3 || max_value != 255 || fgetc(file) == EOF || width <= 0 || height <= 0) {
+		fclose(file);
+		return false;
+	}
+
+	raster_create(target, width, height);
+	bool ok = true;
+	for (int i = 0; ok && i < width * height; ++i) {
+		unsigned char* pixel = target->pixels + (size_t)i * 4;
+		ok = fread(pixel, 1, 3, file) == 3;
+		pixel[3] = 255;
+	}
+	fclose(file);
+	return ok;
+}
+
+// The number of pixels where any channel differs by more than tolerance.
+static int raster_compare(const RasterTarget* a, const RasterTarget* b, int tolerance) {
+	if (a->width != b->width || a->height != b->height) {
+		return a->width * a->height;
+	}
+
+	int differing = 0;
+	for (int i = 0; i < a->width * a->height; ++i) {
+		const unsigned char* pixel_a = a->pixels + (size_t)i * 4;
+		const unsigned char* pixel_b = b->pixels + (size_t)i * 4;
+		for (int channel = 0; channel < 3; ++channel) {
+			if (abs(pixel_a[channel] - pixel_b[channel]) > tolerance) {
+				++differing;
+				break;
+			}
+		}
+	}
+	return differing;
+}
+
+#endif // DEBUGINATOR_RASTER_H
@@ -0,0 +1,101 @@
+// Test for debuginator_save_binary and debuginator_load_binary.
+//
+// Saves a menu with changed values, a collapsed folder and hot keys, and checks that the size
+// query is exact, and that loading it back gives the same save as debuginator_save, both into
+// the same items after a reset and into a new Debuginator before its items are created, which
+// is how a game would do it at startup. Also checks that a truncated save fails to load.
+//
+// Usage: save_binary
+
+#define DEBUGINATOR_IMPLEMENTATION
+#include "headless.h"
+
+#define SAVE_BINARY_ITEMS 500
+#define SAVE_BINARY_PATH_STRIDE 64
+
+typedef struct SaveBuffer {
+	char data[SAVE_BINARY_ITEMS * SAVE_BINARY_PATH_STRIDE];
+	size_t size;
+} SaveBuffer;
+
+static const char* s_quality_titles[] = { "Off", "Low", "Medium", "High" };
+static int s_quality_values[] = { 0, 1, 2, 3 };
+static char s_paths[SAVE_BINARY_ITEMS][SAVE_BINARY_PATH_STRIDE];
+
+static bool save_binary_save_callback(const char* key, const char* value, void* userdata) {
+	SaveBuffer* buffer = (SaveBuffer*)userdata;
+	int length = snprintf(buffer->data + buffer->size, sizeof(buffer->data) - buffer->size, "%s=%s\n", key, value);
+	if (length < 0 || buffer->size + (size_t)length >= sizeof(buffer->data)) {
+		return false;
+	}
+	buffer->size += (size_t)length;
+	return true;
+}
+
+static bool save_binary_matches(struct TheDebuginator* debuginator, const SaveBuffer* expected) {
+	static SaveBuffer saved;
+	saved.size = 0;
+	return debuginator_save(debuginator, save_binary_save_callback, &saved)
+		&& saved.size == expected->size && memcmp(saved.data, expected->data, saved.size) == 0;
+}
+
+// Loads binary first, if there is one, and then creates the items.
+static struct TheDebuginator* save_binary_create_menu(const void* binary, int binary_size) {
+	struct TheDebuginator* debuginator = headless_create(4 * 1024 * 1024, false);
+	if (binary != NULL) {
+		HEADLESS_CHECK(debuginator_load_binary(debuginator, binary, binary_size));
+	}
+
+	for (int i = 0; i < SAVE_BINARY_ITEMS; ++i) {
+		debuginator_create_array_item(debuginator, NULL, s_paths[i], NULL, NULL, NULL,
+			s_quality_titles, (void*)s_quality_values, 4, sizeof(s_quality_values[0]));
+	}
+	return debuginator;
+}
+
+int main(void) {
+	for (int i = 0; i < SAVE_BINARY_ITEMS; ++i) {
+		sprintf(s_paths[i], "System %02d/Group %02d/Item %03d", i % 7, i % 5, i);
+	}
+
+	struct TheDebuginator* debuginator = save_binary_create_menu(NULL, 0);
+	for (int i = 0; i < SAVE_BINARY_ITEMS; i += 7) {
+		DebuginatorItem* item = debuginator_get_item(debuginator, NULL, s_paths[i], NULL);
+		item->leaf.hot_index = 1 + i % 3;
+		debuginator_activate(debuginator, item, false);
+	}
+	debuginator_set_collapsed(debuginator, debuginator_get_parent(debuginator_get_item(debuginator, NULL, s_paths[0], NULL)), true);
+	debuginator_assign_hot_key(debuginator, "F5", s_paths[0], 0, "High");
+	debuginator_assign_hot_key(debuginator, "F6", s_paths[1], DEBUGINATOR_NO_HOT_INDEX, NULL);
+
+	static SaveBuffer original;
+	HEADLESS_CHECK(debuginator_save(debuginator, save_binary_save_callback, &original));
+
+	// The size query gives the exact size, and one byte less doesn't fit.
+	int needed = 0;
+	HEADLESS_CHECK(!debuginator_save_binary(debuginator, NULL, 0, &needed));
+	HEADLESS_CHECK(needed > 0);
+	char* binary = (char*)malloc((size_t)needed);
+	int written = 0;
+	HEADLESS_CHECK(!debuginator_save_binary(debuginator, binary, needed - 1, &written));
+	HEADLESS_CHECK(written == needed);
+	written = 0;
+	HEADLESS_CHECK(debuginator_save_binary(debuginator, binary, needed, &written));
+	HEADLESS_CHECK(written == needed);
+
+	// Into the same items, after a reset.
+	debuginator_reset_items_recursively(debuginator, debuginator->root);
+	HEADLESS_CHECK(!save_binary_matches(debuginator, &original));
+	HEADLESS_CHECK(debuginator_load_binary(debuginator, binary, needed));
+	HEADLESS_CHECK(save_binary_matches(debuginator, &original));
+	HEADLESS_CHECK(!debuginator_load_binary(debuginator, binary, needed - 1));
+	headless_destroy(debuginator);
+
+	// Into a new Debuginator, before the items exist.
+	struct TheDebuginator* loaded = save_binary_create_menu(binary, needed);
+	HEADLESS_CHECK(save_binary_matches(loaded, &original));
+	headless_destroy(loaded);
+
+	free(binary);
+	return g_headless_failures == 0 ? 0 : 1;
+}
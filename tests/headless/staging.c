@@ -0,0 +1,179 @@
+// Test for building items in staging areas and attaching them to the menu.
+//
+// Stages a folder of items for each of lots of entities, over a few staging areas, attaches
+// them, and checks that they're just like the same items created directly, and behave like
+// them afterwards. Then stages more on several threads while the main thread keeps creating,
+// removing, updating and drawing, and attaches each area when its thread is done. Those areas
+// also stage the same folder, which gets merged, and the same item, which is left out after the
+// first. Meant to be run under ThreadSanitizer too.
+//
+// Usage: staging
+
+#define DEBUGINATOR_IMPLEMENTATION
+#include "headless.h"
+#include "thread.h"
+
+#define STAGING_ENTITIES 1000
+#define STAGING_ITEMS_PER_ENTITY 8
+#define STAGING_AREAS 2
+#define STAGING_THREADS 4
+#define STAGING_THREAD_ENTITIES 250
+#define STAGING_MAIN_ITEMS 64
+
+static const char* s_quality_titles[] = { "Off", "Low", "Medium", "High" };
+static int s_quality_values[] = { 0, 1, 2, 3 };
+
+static void staging_create_entity(struct TheDebuginator* debuginator, const char* folder, int entity_index) {
+	char path[64];
+	for (int i = 0; i < STAGING_ITEMS_PER_ENTITY; ++i) {
+		snprintf(path, sizeof(path), "%sEntity %04d/Setting %d", folder, entity_index, i);
+		if (i == 0) {
+			debuginator_create_array_item(debuginator, NULL, path, "Quality for this entity.", NULL, NULL,
+				s_quality_titles, (void*)s_quality_values, 4, sizeof(s_quality_values[0]));
+		}
+		else {
+			debuginator_create_bool_item(debuginator, path, NULL, NULL);
+		}
+	}
+}
+
+static int staging_count_items(DebuginatorItem* item) {
+	int count = 1;
+	if (item->is_folder) {
+		for (DebuginatorItem* child = item->folder.first_child; child != NULL; child = child->next_sibling) {
+			count += staging_count_items(child);
+		}
+	}
+	return count;
+}
+
+typedef struct StagingWorker {
+	struct TheDebuginator staging;
+	int index;
+	volatile unsigned long long done;
+	Thread thread;
+	bool attached;
+} StagingWorker;
+
+THREAD_FUNCTION(staging_thread) {
+	StagingWorker* worker = (StagingWorker*)userdata;
+	for (int i = worker->index * STAGING_THREAD_ENTITIES; i < (worker->index + 1) * STAGING_THREAD_ENTITIES; ++i) {
+		staging_create_entity(&worker->staging, "", i);
+	}
+
+	char path[64];
+	snprintf(path, sizeof(path), "Shared/Worker %02d", worker->index);
+	debuginator_create_bool_item(&worker->staging, path, NULL, NULL);
+	debuginator_create_bool_item(&worker->staging, "Shared/Common", NULL, NULL);
+	debuginator_finish_staging(&worker->staging);
+	DEBUGINATOR_atomic_store64(&worker->done, 1);
+	return THREAD_RETURN;
+}
+
+static int staging_count_titled(DebuginatorItem* folder, const char* title) {
+	int count = 0;
+	for (DebuginatorItem* child = folder->folder.first_child; child != NULL; child = child->next_sibling) {
+		count += strcmp(child->title, title) == 0;
+	}
+	return count;
+}
+
+static void staging_test_threads(struct TheDebuginator* debuginator) {
+	DebuginatorItem* threaded = debuginator_create_folder_item(debuginator, NULL, "Threaded");
+	StagingWorker* workers = (StagingWorker*)malloc(sizeof(StagingWorker) * STAGING_THREADS);
+	for (int i = 0; i < STAGING_THREADS; ++i) {
+		debuginator_create_staging(debuginator, &workers[i].staging, 32);
+		workers[i].index = i;
+		workers[i].done = 0;
+		workers[i].attached = false;
+		thread_start(&workers[i].thread, staging_thread, &workers[i]);
+	}
+
+	// Like a game's frames, with items coming and going in blocks of the arena after theirs.
+	char path[64];
+	int num_attached = 0;
+	for (int frame = 0; num_attached < STAGING_THREADS; ++frame) {
+		snprintf(path, sizeof(path), "Main/Item %06d", frame);
+		debuginator_create_bool_item(debuginator, path, "Created while the others are staging.", NULL);
+		if (frame >= STAGING_MAIN_ITEMS) {
+			snprintf(path, sizeof(path), "Main/Item %06d", frame - STAGING_MAIN_ITEMS);
+			debuginator_remove_item_by_path(debuginator, path);
+		}
+		headless_run_frames(debuginator, 1);
+
+		for (int i = 0; i < STAGING_THREADS; ++i) {
+			if (!workers[i].attached && DEBUGINATOR_atomic_load64(&workers[i].done) != 0) {
+				thread_join(workers[i].thread);
+				debuginator_attach_staging(debuginator, &workers[i].staging, threaded);
+				workers[i].attached = true;
+				++num_attached;
+			}
+		}
+		thread_yield();
+	}
+	headless_run_frames(debuginator, 30);
+
+	DebuginatorItem* shared = debuginator_get_item(debuginator, threaded, "Shared", NULL);
+	HEADLESS_CHECK(staging_count_titled(threaded, "Shared") == 1);
+	HEADLESS_CHECK(shared != NULL && staging_count_items(shared) == 1 + STAGING_THREADS + 1);
+	HEADLESS_CHECK(shared != NULL && staging_count_titled(shared, "Common") == 1);
+	HEADLESS_CHECK(staging_count_items(threaded) == 1 + STAGING_THREADS * STAGING_THREAD_ENTITIES * (1 + STAGING_ITEMS_PER_ENTITY) + 1 + STAGING_THREADS + 1);
+	HEADLESS_CHECK(debuginator_get_item(debuginator, threaded, "Entity 0765/Setting 3", NULL) != NULL);
+	HEADLESS_CHECK(debuginator_get_item(debuginator, threaded, "Shared/Worker 03", NULL) != NULL);
+	free(workers);
+}
+
+int main(void) {
+	struct TheDebuginator* debuginator = headless_create(64 * 1024 * 1024, false);
+
+	// For comparison, the usual way.
+	DebuginatorItem* direct = debuginator_create_folder_item(debuginator, NULL, "Direct");
+	for (int i = 0; i < STAGING_ENTITIES; ++i) {
+		staging_create_entity(debuginator, "Direct/", i);
+	}
+
+	DebuginatorItem* entities = debuginator_create_folder_item(debuginator, NULL, "Entities");
+	struct TheDebuginator* staging = (struct TheDebuginator*)malloc(sizeof(struct TheDebuginator) * STAGING_AREAS);
+	int entities_per_area = STAGING_ENTITIES / STAGING_AREAS;
+	for (int area = 0; area < STAGING_AREAS; ++area) {
+		debuginator_create_staging(debuginator, &staging[area], 32);
+		for (int i = area * entities_per_area; i < (area + 1) * entities_per_area; ++i) {
+			staging_create_entity(&staging[area], "", i);
+		}
+		debuginator_finish_staging(&staging[area]);
+	}
+
+	for (int area = 0; area < STAGING_AREAS; ++area) {
+		debuginator_attach_staging(debuginator, &staging[area], entities);
+	}
+
+	HEADLESS_CHECK(staging_count_items(entities) == staging_count_items(direct));
+	HEADLESS_CHECK(debuginator_get_item(debuginator, NULL, "Entities/Entity 0765/Setting 3", NULL) != NULL);
+
+	debuginator_set_open(debuginator, true);
+	headless_run_frames(debuginator, 30);
+	HEADLESS_CHECK(entities->total_height == direct->total_height);
+
+	// Removing a staged entity and creating one the usual way in its place.
+	debuginator_remove_item_by_path(debuginator, "Entities/Entity 0001");
+	HEADLESS_CHECK(debuginator_get_item(debuginator, NULL, "Entities/Entity 0001/Setting 0", NULL) == NULL);
+	staging_create_entity(debuginator, "Entities/", STAGING_ENTITIES);
+	headless_run_frames(debuginator, 30);
+	HEADLESS_CHECK(staging_count_items(entities) == staging_count_items(direct));
+
+	// A staged item whose title is taken, here by a folder, is left out.
+	struct TheDebuginator taken;
+	debuginator_create_staging(debuginator, &taken, 8);
+	debuginator_create_bool_item(&taken, "Entity 0002", NULL, NULL);
+	debuginator_finish_staging(&taken);
+	debuginator_attach_staging(debuginator, &taken, entities);
+	HEADLESS_CHECK(staging_count_titled(entities, "Entity 0002") == 1);
+	HEADLESS_CHECK(debuginator_get_item(debuginator, entities, "Entity 0002", NULL)->is_folder);
+	HEADLESS_CHECK(staging_count_items(entities) == staging_count_items(direct));
+
+	staging_test_threads(debuginator);
+
+	free(staging);
+	headless_destroy(debuginator);
+	return g_headless_failures == 0 ? 0 : 1;
+}
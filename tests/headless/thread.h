@@ -0,0 +1,51 @@
+#ifndef DEBUGINATOR_THREAD_H
+#define DEBUGINATOR_THREAD_H
+
+// Just enough threads for the headless test programs that need them, on Windows and on
+// pthreads. Include headless.h before this, and link with Threads::Threads.
+//
+// A thread's function is declared with THREAD_FUNCTION(name), gets its argument as userdata
+// and ends with return THREAD_RETURN.
+
+#ifdef _WIN32
+typedef HANDLE Thread;
+typedef LPTHREAD_START_ROUTINE ThreadFunction;
+#define THREAD_FUNCTION(name) static DWORD WINAPI name(LPVOID userdata)
+#define THREAD_RETURN 0
+#else
+#include <pthread.h>
+#include <sched.h>
+typedef pthread_t Thread;
+typedef void* (*ThreadFunction)(void* userdata);
+#define THREAD_FUNCTION(name) static void* name(void* userdata)
+#define THREAD_RETURN NULL
+#endif
+
+#ifdef _WIN32
+static HEADLESS_MAYBE_UNUSED void thread_start(Thread* thread, ThreadFunction function, void* userdata) {
+	*thread = CreateThread(NULL, 0, function, userdata, 0, NULL);
+}
+
+static HEADLESS_MAYBE_UNUSED void thread_join(Thread thread) {
+	WaitForSingleObject(thread, INFINITE);
+	CloseHandle(thread);
+}
+
+static HEADLESS_MAYBE_UNUSED void thread_yield(void) {
+	SwitchToThread();
+}
+#else
+static HEADLESS_MAYBE_UNUSED void thread_start(Thread* thread, ThreadFunction function, void* userdata) {
+	pthread_create(thread, NULL, function, userdata);
+}
+
+static HEADLESS_MAYBE_UNUSED void thread_join(Thread thread) {
+	pthread_join(thread, NULL);
+}
+
+static HEADLESS_MAYBE_UNUSED void thread_yield(void) {
+	sched_yield();
+}
+#endif
+
+#endif // DEBUGINATOR_THREAD_H
@@ -200,6 +200,8 @@ typedef void (*DebuginatorLogCallback)
 	(const char* text, void* userdata);
 typedef void (*DebuginatorOnOpenChangedCallback)
 	(bool opened, bool done, void* app_userdata);
+typedef double (*DebuginatorGetTimeCallback)
+	(void* app_userdata);
 
 typedef void(*DebuginatorOnItemChangedCallback)(DebuginatorItem* item, void* value, const char* value_title, void* app_userdata);
 typedef bool(*DebuginatorSaveItemCallback)(const char* key, const char* value, void* userdata);
@@ -213,6 +215,7 @@ typedef enum DebuginatorItemEditorDataType {
 	DEBUGINATOR_EditTypePreset,
 	DEBUGINATOR_EditTypeColorPicker,
 	DEBUGINATOR_EditTypeNumberRange,
+	DEBUGINATOR_EditTypeProfiler, // Shows the stats of the profile zone in user_data
 	/*DEBUGINATOR_EditTypeUserType1,
 	...
 	DEBUGINATOR_EditTypeUserTypeN,*/
@@ -224,6 +227,137 @@ typedef enum DebuginatorDrawMode {
 	DEBUGINATOR_DrawModeSortedFilter,
 } DebuginatorDrawMode;
 
+typedef enum DebuginatorDrawCommandType {
+	DEBUGINATOR_DrawCommandRect,
+	DEBUGINATOR_DrawCommandText,
+	DEBUGINATOR_DrawCommandImage,
+} DebuginatorDrawCommandType;
+
+// One recorded draw call. See debuginator_set_draw_command_buffer.
+typedef struct DebuginatorDrawCommand {
+	unsigned char type;           // DebuginatorDrawCommandType
+	unsigned char font;           // Text only. Index into the theme's fonts, i.e. a DebuginatorDrawType.
+	unsigned short flags;         // Used internally
+	DebuginatorColor color;       // Rect and text
+	DebuginatorVector2 position;
+	DebuginatorVector2 size;      // Rect and image
+	union {
+		struct {
+			unsigned int offset;  // Into the buffer's strings. The text is null terminated.
+			unsigned int length;
+		} text;
+		DebuginatorImageHandle image;
+	} data;
+} DebuginatorDrawCommand;
+
+// Owned by the application. The Debuginator clears it at the start of each draw and
+// then fills it up. If it runs out of space, the rest of the frame's commands are dropped
+// and overflowed is set.
+typedef struct DebuginatorDrawCommandBuffer {
+	DebuginatorDrawCommand* commands;
+	int commands_capacity;
+	int command_count;
+
+	char* strings;
+	int strings_capacity;
+	int strings_size;
+
+	bool overflowed;
+} DebuginatorDrawCommandBuffer;
+
+// 32 bit x86 only aligns 8 byte members to 4, and a 64 bit load or store that straddles a
+// cache line isn't done all at once.
+#ifndef DEBUGINATOR_ALIGN8
+#if defined(_MSC_VER) && !defined(__clang__)
+#define DEBUGINATOR_ALIGN8 __declspec(align(8))
+#else
+#define DEBUGINATOR_ALIGN8 __attribute__((aligned(8)))
+#endif
+#endif
+
+// Owned by the application, and zeroed to begin with. Holds an item's active value, up to 8
+// bytes of it, so that other threads can read it while the menu changes it, without locks and
+// without ever getting half of an old value. See debuginator_publish_value. Always 8 byte
+// aligned, also in a struct on 32 bit, and reading it doesn't write to it, so it can be in
+// read-only memory on the reading side.
+typedef struct DebuginatorPublishedValue {
+	DEBUGINATOR_ALIGN8 volatile unsigned long long bits;
+} DebuginatorPublishedValue;
+
+// Owned by the application. Items whose callbacks are waiting for debuginator_run_callbacks,
+// in the order they were first changed. See debuginator_set_callback_buffer.
+typedef struct DebuginatorCallbackBuffer {
+	DebuginatorItem** items;
+	int capacity;
+	int count;
+
+	// Set if it was full, and a callback was run right away instead.
+	bool overflowed;
+} DebuginatorCallbackBuffer;
+
+// The parts of The Debuginator that the profiler times. See DEBUGINATOR_ENABLE_PROFILER.
+typedef enum DebuginatorProfileZone {
+	DEBUGINATOR_ProfileUpdate,
+	DEBUGINATOR_ProfileUpdateFilter,
+	DEBUGINATOR_ProfileDraw,
+	DEBUGINATOR_ProfileDrawHierarchy,
+	DEBUGINATOR_ProfileDrawAnimations,
+	DEBUGINATOR_ProfileDrawTooltip,
+	DEBUGINATOR_ProfileDrawNotifications,
+	DEBUGINATOR_ProfileItemCallbacks,
+	DEBUGINATOR_ProfileLayout,
+	DEBUGINATOR_ProfileSave,
+	DEBUGINATOR_ProfileLoad,
+	DEBUGINATOR_ProfileQueueProcess,
+	DEBUGINATOR_ProfileZoneCount
+} DebuginatorProfileZone;
+
+// Time spent in a zone per frame, over the last frames it ran in.
+typedef struct DebuginatorProfileStats {
+	float min_ms;
+	float avg_ms;
+	float max_ms;
+	int num_frames;
+} DebuginatorProfileStats;
+
+// Sent when the profiler enters and leaves a zone, see debuginator_set_trace_callback.
+typedef struct DebuginatorTraceEvent {
+	DebuginatorProfileZone zone;
+	const char* name;      // The zone's name
+	const char* item_path; // For item callbacks, otherwise NULL
+	bool begin;
+	double time;           // From config.get_time, in seconds
+} DebuginatorTraceEvent;
+
+typedef void (*DebuginatorTraceCallback)(const DebuginatorTraceEvent* event, void* userdata);
+
+// Writes trace events as Chrome's trace event JSON, which chrome://tracing and Perfetto can
+// open. Owned by the application. If the buffer runs out, the rest of the events are dropped
+// and overflowed is set. The file still ends properly, with every event up until then.
+typedef struct DebuginatorTraceJsonWriter {
+	char* buffer;
+	int capacity;
+	int size;
+	int num_events;
+	int pid; // Shown as the process and thread, so that it lines up with your own traces
+	int tid;
+	bool overflowed;
+} DebuginatorTraceJsonWriter;
+
+// What a frame cost, in callbacks and items. A frame runs from the start of one
+// debuginator_update to the start of the next. Counts callbacks into the application, so text sizes and word wraps that were cached
+// aren't counted, and nothing is drawn if retained drawing kept last frame's draw commands.
+typedef struct DebuginatorFrameStats {
+	int draw_rect_calls;
+	int draw_text_calls;
+	int draw_image_calls;
+	int text_size_calls;
+	int word_wrap_calls;
+	int items_visited; // Items looked at while finding what to draw, including the drawn ones
+	int items_drawn;
+	int item_callbacks; // on_item_changed_callback
+} DebuginatorFrameStats;
+
 // API START
 
 // Call to create an instance of the debuginator. Make sure the config has
@@ -241,9 +375,37 @@ bool debuginator_is_open(struct TheDebuginator* debuginator);
 // Starts opening or closing
 void debuginator_set_open(struct TheDebuginator* debuginator, bool open);
 
+// Item heights, word wrapped descriptions, the sizes of hot key labels, what's under the mouse
+// and everything that animates are worked out in debuginator_update. debuginator_draw doesn't
+// change the menu, it only fills in the draw command buffer, keeps track of it for retained
+// drawing, and counts its frame stats. Neither is thread safe, so don't call debuginator_draw
+// while anything else is using the Debuginator.
 void debuginator_update(struct TheDebuginator* debuginator, float dt);
 void debuginator_draw(struct TheDebuginator* debuginator, float dt);
 
+// Makes debuginator_draw record what it draws into buffer, instead of calling the
+// draw callbacks once for every rect, text and image. Handy if you want to batch it
+// all up in one go. Pass NULL to go back to using the callbacks.
+void debuginator_set_draw_command_buffer(struct TheDebuginator* debuginator, DebuginatorDrawCommandBuffer* buffer);
+
+// Calls the draw callbacks for every command in the buffer, in order. Colors are the ones
+// recorded in the commands, fonts are looked up in the current theme.
+void debuginator_submit_draw_commands(struct TheDebuginator* debuginator, DebuginatorDrawCommandBuffer* buffer);
+
+// Retained drawing. Needs a draw command buffer. When enabled, debuginator_draw leaves the
+// previous frame's commands in the buffer if nothing that affects them has changed, only
+// updating the color of the pulsing active item. Use debuginator_needs_redraw to know if
+// the buffer would change, so you can skip submitting it again.
+void debuginator_set_retained_drawing(struct TheDebuginator* debuginator, bool enabled);
+
+// Returns true if the next debuginator_draw would draw something different than the last
+// one did. The pulsing color of the active item doesn't count.
+bool debuginator_needs_redraw(struct TheDebuginator* debuginator);
+
+// The Debuginator notices changes made through the API, but not ones you make directly to
+// items, or things your own edit types draw that change by themselves. Call this then.
+void debuginator_invalidate_draw_list(struct TheDebuginator* debuginator);
+
 // parent is optional, can be used for a bit of performance I suppose.
 // path is on the format a_parent/the_new_item
 // description is optional
@@ -259,6 +421,7 @@ DebuginatorItem* debuginator_create_array_item(struct TheDebuginator* debuginato
 	const char** value_titles, void* values, int num_values, int value_size);
 
 // Wraps create_array_item. user_data should point to a single byte. It'll get 1 or 0 written to it.
+// It can be NULL, then the item only keeps track of its state itself, in leaf.active_index.
 DebuginatorItem* debuginator_create_bool_item(struct TheDebuginator* debuginator, const char* path, const char* description, void* user_data);
 
 // Like above but when you want a custom callback
@@ -267,6 +430,20 @@ DebuginatorItem* debuginator_create_bool_item_with_callback(struct TheDebuginato
 // Useful simple callback function for setting a small value
 void debuginator_copy_1byte(DebuginatorItem* item, void* value, const char* value_title, void* app_userdata);
 
+// Like debuginator_copy_1byte, but the item's user_data is a DebuginatorPublishedValue, which
+// gets the first 8 bytes of the value. With a callback buffer, that happens when the callbacks
+// are run.
+void debuginator_publish_value(DebuginatorItem* item, void* value, const char* value_title, void* app_userdata);
+
+// Like create_bool_item, but for other threads to read with debuginator_read_bool.
+DebuginatorItem* debuginator_create_published_bool_item(struct TheDebuginator* debuginator, const char* path, const char* description, DebuginatorPublishedValue* published);
+
+// Reads a published value from any thread. Never waits, not even while it's being changed.
+bool debuginator_read_bool(const DebuginatorPublishedValue* published);
+int debuginator_read_int(const DebuginatorPublishedValue* published);
+float debuginator_read_float(const DebuginatorPublishedValue* published);
+void debuginator_read_value(const DebuginatorPublishedValue* published, void* value, int size);
+
 // Wraps create_array_item. Creates an item which, upon activation, sets the value of all items referenced to by paths, to
 // have the value from the corresponding index in value_titles.
 // value_indices is currently not used
@@ -322,6 +499,16 @@ bool debuginator_save(struct TheDebuginator* debuginator, DebuginatorSaveItemCal
 // value_title should be the value you want it to have when finally created.
 void debuginator_load_item(struct TheDebuginator* debuginator, const char* key, const char* value);
 
+// Save the same state as debuginator_save, in a compact binary format, in one pass. Returns false if it didn't fit, in
+// which case the buffer's contents are undefined. needed is set to the exact size either way, so pass a NULL buffer and
+// 0 capacity to ask for it.
+bool debuginator_save_binary(struct TheDebuginator* debuginator, void* buffer, int capacity, int* needed);
+
+// Load what debuginator_save_binary saved, like calling debuginator_load_item for each setting but faster. Hot keys
+// are also assigned to existing items that don't have one. Returns false if the data is broken, but what came before
+// the broken part is still loaded.
+bool debuginator_load_binary(struct TheDebuginator* debuginator, const void* buffer, int size);
+
 // Set an item's default value. If value_title is NULL, value_index will be used instead.
 // value index is used if value_title == NULL
 void debuginator_set_default_value(struct TheDebuginator* debuginator, const char* path, const char* value_title, int value_index);
@@ -388,7 +575,14 @@ void debuginator_reset_scrolling(struct TheDebuginator* debuginator);
 void debuginator_set_mouse_cursor_pos(struct TheDebuginator* debuginator, DebuginatorVector2* mouse_cursor_pos);
 void debuginator_activate_item_at_mouse_cursor(struct TheDebuginator* debuginator);
 void debuginator_expand_item_at_mouse_cursor(struct TheDebuginator* debuginator, DebuginatorExpand expand);
+// As of the last debuginator_update.
 DebuginatorItem* debuginator_get_item_at_mouse_cursor(struct TheDebuginator* debuginator, int* out_hot_item_index);
+
+// Returns the item whose row is at y, in the same space as the mouse cursor, or NULL if there
+// isn't one. If it's one of an expanded item's values, out_value_index is set to which one,
+// otherwise to DEBUGINATOR_NO_HOT_INDEX. Uses the height indices of big folders, so it doesn't
+// step through all the items above y.
+DebuginatorItem* debuginator_get_item_at_y(struct TheDebuginator* debuginator, float y, int* out_value_index);
 bool debuginator_is_mouse_over(struct TheDebuginator* debuginator, bool* out_over_quick_draw_area);
 
 // Hot key API
@@ -409,6 +603,10 @@ void debuginator_set_size(struct TheDebuginator* debuginator, int width, int hei
 // Sets screen resolution for The Debuginator. Only used for right-aligned mode.
 void debuginator_set_screen_resolution(struct TheDebuginator* debuginator, int width, int height);
 
+// Word wrapped descriptions and text sizes are cached. Call this if you've changed something
+// that affects how text is measured, that isn't in the theme's fonts, like reloading a font.
+void debuginator_invalidate_text_cache(struct TheDebuginator* debuginator);
+
 // Not sure there'a valid use case for this but.. it doesn't exactly hurt.
 int debuginator_total_height(struct TheDebuginator* debuginator);
 
@@ -428,12 +626,78 @@ char* debuginator_copy_string(struct TheDebuginator* debuginator, const char* st
 // Logs current value
 void debuginator_log_item(struct TheDebuginator* debuginator, DebuginatorItem* item);
 
+// Profiling. Define DEBUGINATOR_ENABLE_PROFILER and set config.get_time to have The
+// Debuginator time its update, filtering, drawing and item callbacks, and add a
+// Debuginator/Tools/Profiler page. Or define DEBUGINATOR_PROFILE_BEGIN(debuginator, zone) and
+// DEBUGINATOR_PROFILE_END(debuginator, zone) to use your own profiler instead.
+// A frame starts with debuginator_update. The stats are all zero if the profiler isn't used.
+void debuginator_get_profile_stats(struct TheDebuginator* debuginator, DebuginatorProfileZone zone, DebuginatorProfileStats* stats);
+const char* debuginator_get_profile_zone_name(DebuginatorProfileZone zone);
+
+// For timing things outside of the_debuginator.h, like the_debuginator_queue.h. Goes through
+// DEBUGINATOR_PROFILE_BEGIN/END.
+void debuginator_profile_begin(struct TheDebuginator* debuginator, DebuginatorProfileZone zone);
+void debuginator_profile_end(struct TheDebuginator* debuginator, DebuginatorProfileZone zone);
+
+// Tracing. With the built-in profiler and config.get_time, the callback gets an event when each
+// zone begins and ends, including each item callback with the item's path. NULL to stop.
+// debuginator_trace_json_write can be used as the callback, with a DebuginatorTraceJsonWriter
+// as the userdata. Start it with debuginator_trace_json_begin and finish the file with
+// debuginator_trace_json_end, which returns false if it overflowed.
+void debuginator_set_trace_callback(struct TheDebuginator* debuginator, DebuginatorTraceCallback callback, void* userdata);
+void debuginator_trace_json_begin(DebuginatorTraceJsonWriter* writer, char* buffer, int capacity);
+void debuginator_trace_json_write(const DebuginatorTraceEvent* event, void* userdata);
+bool debuginator_trace_json_end(DebuginatorTraceJsonWriter* writer);
+
+// The stats of the last whole frame, which ended when debuginator_update was last called. So
+// the items your input activated before the update are in it, and so is the draw before that.
+// Reading them doesn't reset anything, they're the same until the next update.
+void debuginator_get_frame_stats(struct TheDebuginator* debuginator, DebuginatorFrameStats* stats);
+
+// Called whenever any item is activated, before the item's own callback, for things that want
+// to know about every change, like the_debuginator_queue.h's change queues. value is the new
+// value, or the item's values for action items, which have no value_title. The last argument
+// is userdata, not app_userdata. There's only one, NULL to stop.
+void debuginator_set_item_changed_listener(struct TheDebuginator* debuginator, DebuginatorOnItemChangedCallback listener, void* userdata);
+
+// Makes activating items, by hand, with hot keys or with presets, put off calling their
+// callbacks until debuginator_run_callbacks, instead of calling them right away. An item that's
+// changed several times before then gets one call, with the value it has by then. Callbacks
+// still pending in the previous buffer are run first. Pass NULL to go back to calling them
+// right away.
+void debuginator_set_callback_buffer(struct TheDebuginator* debuginator, DebuginatorCallbackBuffer* buffer);
+
+// For building lots of items on other threads, like a folder for each entity that's spawned.
+// On the main thread, debuginator_create_staging sets up staging as a private Debuginator that
+// allocates from num_blocks blocks of the main one's arena (DEBUGINATOR_ALLOCATOR_BLOCK_SIZE
+// each, and each kind of allocation needs its own, so five or more). Another thread can then
+// create items in it with the usual functions, and calls debuginator_finish_staging when it's
+// done. Back on the main thread, debuginator_attach_staging moves its top level items, and the
+// blocks they're in, into the main Debuginator, under parent (or the root if NULL), without
+// copying any of them. A staged folder that's there already is merged into the one that's
+// there, and any other staged item that's there already is left out. Staged items start out
+// with their default values, without loaded settings or hot keys, and can't be presets.
+// Afterwards, staging is empty and can be thrown away.
+void debuginator_create_staging(struct TheDebuginator* debuginator, struct TheDebuginator* staging, int num_blocks);
+void debuginator_finish_staging(struct TheDebuginator* staging);
+void debuginator_attach_staging(struct TheDebuginator* debuginator, struct TheDebuginator* staging, DebuginatorItem* parent);
+
+// Calls the pending callbacks, and those of items they change in turn, on the calling thread.
+// The Debuginator isn't thread safe, so nothing else may use it meanwhile. Returns how many
+// there were.
+int debuginator_run_callbacks(struct TheDebuginator* debuginator);
+
 // API END
 
+struct DebuginatorHeightIndex;
+
 typedef struct DebuginatorFolderData {
 	DebuginatorItem* first_child;
 	DebuginatorItem* hot_child;
+	struct DebuginatorHeightIndex* height_index; // Only for big folders, see debuginator__skip_children_above
 	int num_visible_children;
+	int children_height;         // Sum of the children's total_height, even when collapsed
+	int height_index_entry;      // See debuginator__height_index_entry
 	bool is_collapsed;           // Note collapsed as opposed to expanded - because I want false/0 to be default
 	bool is_sorted;              // Uses alphabetic sorting
 } DebuginatorFolderData;
@@ -441,7 +705,8 @@ typedef struct DebuginatorFolderData {
 typedef struct DebuginatorLeafData {
 	// A helpful text for the user
 	const char* description;
-	int description_line_count;
+	int description_line_count; // -1 until it's been expanded
+	int height_index_entry;     // See debuginator__height_index_entry
 
 	// The values and the UI titles
 	const char** value_titles;
@@ -526,6 +791,12 @@ typedef struct DebuginatorItem {
 
 	// If it's filtered out by the search
 	bool is_filtered;
+
+	// If total_height needs to be recalculated, see debuginator__update_layout
+	bool is_layout_dirty;
+
+	// If it's in the callback buffer, see debuginator_set_callback_buffer
+	bool is_callback_pending;
 } DebuginatorItem;
 
 // Used for creating an instance of TheDebuginator
@@ -558,12 +829,23 @@ typedef struct TheDebuginatorConfig {
 	// Optional. Will be called during draw.
 	DebuginatorDrawImageCallback draw_image;
 
+	// Optional. If set, draw calls get recorded into this rather than calling the draw
+	// callbacks. See debuginator_set_draw_command_buffer.
+	DebuginatorDrawCommandBuffer* draw_command_buffer;
+
+	// Only used with a draw command buffer. See debuginator_set_retained_drawing.
+	bool retained_drawing;
+
 	// Optional.
 	DebuginatorPlaySoundCallback play_sound;
 
 	// Optional. Gets called when The Debuginator is opened or closed.
 	DebuginatorOnOpenChangedCallback on_opened_changed;
 
+	// Optional. Returns the current time in seconds. Used by the profiler, see
+	// DEBUGINATOR_ENABLE_PROFILER.
+	DebuginatorGetTimeCallback get_time;
+
 	// The dimensions of the "panel".
 	DebuginatorVector2 size; // Might not be needed in the future
 
@@ -626,6 +908,36 @@ void debuginator_strcpy_s(char* dest, int dest_size, const char* src);
 #define DEBUGINATOR_memcpy memcpy
 #endif
 
+#ifndef DEBUGINATOR_atomic_load64
+#if defined(_MSC_VER) && !defined(__clang__)
+#include <intrin.h>
+// A plain 64 bit load, which is atomic when aligned, also on 32 bit where it's done with SSE or
+// the FPU. Not a compare exchange, which would write to what might be read-only.
+static __inline unsigned long long debuginator__atomic_load64(const volatile unsigned long long* ptr) {
+	unsigned long long value = (unsigned long long)__iso_volatile_load64((const volatile long long*)ptr);
+#if defined(_M_ARM) || defined(_M_ARM64)
+	__dmb(0xB); // ISH
+#else
+	_ReadWriteBarrier();
+#endif
+	return value;
+}
+#define DEBUGINATOR_atomic_load64(ptr) debuginator__atomic_load64(ptr)
+// Compare exchange, since exchange isn't an intrinsic on 32 bit.
+#define DEBUGINATOR_atomic_store64(ptr, value) \
+	do { \
+		long long debuginator__expected = *(volatile long long*)(ptr); \
+		long long debuginator__actual; \
+		while ((debuginator__actual = _InterlockedCompareExchange64((volatile long long*)(ptr), (long long)(value), debuginator__expected)) != debuginator__expected) { \
+			debuginator__expected = debuginator__actual; \
+		} \
+	} while (0)
+#else
+#define DEBUGINATOR_atomic_load64(ptr) __atomic_load_n((ptr), __ATOMIC_ACQUIRE)
+#define DEBUGINATOR_atomic_store64(ptr, value) __atomic_store_n((ptr), (value), __ATOMIC_RELEASE)
+#endif
+#endif
+
 #ifndef DEBUGINATOR_memcmp
 #include <string.h>
 #define DEBUGINATOR_memcmp memcmp
@@ -758,6 +1070,7 @@ void debuginator_strcpy_s(char* dest, int dest_size, const char* src);
 #endif
 
 #define DEBUGINATOR_NO_HOT_INDEX -1
+#define DEBUGINATOR_DESCRIPTION_NOT_MEASURED -1
 #define DEBUGINATOR_CUSTOM_VALUE_STATE_COUNT -1
 
 #ifndef DEBUGINATOR_DO_NOT_HOT_KEY_UPPERCASING
@@ -781,6 +1094,63 @@ void debuginator_strcpy_s(char* dest, int dest_size, const char* src);
 #define DEBUGINATOR_TOOLTIP_FADEIN 0.25
 #endif
 
+// Folders with at least this many visible children get a height index, so drawing
+// doesn't have to step through all the children above the screen.
+#ifndef DEBUGINATOR_HEIGHT_INDEX_MIN_CHILDREN
+#define DEBUGINATOR_HEIGHT_INDEX_MIN_CHILDREN 256
+#endif
+
+#ifndef DEBUGINATOR_HEIGHT_INDEX_STRIDE
+#define DEBUGINATOR_HEIGHT_INDEX_STRIDE 32
+#endif
+
+// More changes than this between two layout updates and everything is laid out again.
+#ifndef DEBUGINATOR_MAX_LAYOUT_DIRTY_ITEMS
+#define DEBUGINATOR_MAX_LAYOUT_DIRTY_ITEMS 256
+#endif
+
+// How many word wrapped descriptions to keep, at least. Only expanded items and the tooltip need
+// them, so there's also room for one per row that fits on screen, see debuginator__reserve_wrap_cache.
+#ifndef DEBUGINATOR_WRAP_CACHE_SIZE
+#define DEBUGINATOR_WRAP_CACHE_SIZE 8
+#endif
+
+#define DEBUGINATOR_MAX_DESCRIPTION_ROWS 32
+
+// How many text_size results to keep, for labels that are measured every frame.
+// Must be a power of two.
+#ifndef DEBUGINATOR_TEXT_SIZE_CACHE_SIZE
+#define DEBUGINATOR_TEXT_SIZE_CACHE_SIZE 128
+#endif
+
+// Longer strings are measured every time.
+#define DEBUGINATOR_TEXT_SIZE_CACHE_MAX_LENGTH 32
+
+// How many frames the profiler's stats are over.
+#ifndef DEBUGINATOR_PROFILER_HISTORY
+#define DEBUGINATOR_PROFILER_HISTORY 64
+#endif
+
+#ifdef DEBUGINATOR_ENABLE_PROFILER
+#ifndef DEBUGINATOR_PROFILE_BEGIN
+#define DEBUGINATOR_PROFILE_BEGIN(debuginator, zone) debuginator__profile_begin((debuginator), (zone), NULL)
+#define DEBUGINATOR_PROFILE_END(debuginator, zone) debuginator__profile_end((debuginator), (zone), NULL)
+#define DEBUGINATOR_PROFILE_BEGIN_ITEM(debuginator, zone, item) debuginator__profile_begin((debuginator), (zone), (item))
+#define DEBUGINATOR_PROFILE_END_ITEM(debuginator, zone, item) debuginator__profile_end((debuginator), (zone), (item))
+#endif
+#endif
+
+#ifndef DEBUGINATOR_PROFILE_BEGIN
+#define DEBUGINATOR_PROFILE_BEGIN(debuginator, zone) ((void)0)
+#define DEBUGINATOR_PROFILE_END(debuginator, zone) ((void)0)
+#endif
+
+// Zones that are about a single item. Your own profiler can use the item to label them.
+#ifndef DEBUGINATOR_PROFILE_BEGIN_ITEM
+#define DEBUGINATOR_PROFILE_BEGIN_ITEM(debuginator, zone, item) DEBUGINATOR_PROFILE_BEGIN(debuginator, zone)
+#define DEBUGINATOR_PROFILE_END_ITEM(debuginator, zone, item) DEBUGINATOR_PROFILE_END(debuginator, zone)
+#endif
+
 static float debuginator__ceil(float v) {
 	if ((int)v == v) {
 		return v;
@@ -892,6 +1262,83 @@ typedef struct DebuginatorAnimation {
 	float time;
 } DebuginatorAnimation;
 
+// Every stride:th visible child of a folder, and how far below the first visible
+// child it starts. Lives in a single allocator block right after this struct.
+typedef struct DebuginatorHeightIndexEntry {
+	DebuginatorItem* child;
+	int y;
+} DebuginatorHeightIndexEntry;
+
+typedef struct DebuginatorHeightIndex {
+	DebuginatorHeightIndexEntry* entries;
+	int count;
+	int capacity;
+	int stride;
+	bool is_dirty;
+} DebuginatorHeightIndex;
+
+// The result of word_wrap for an item's description, for a given width and font.
+typedef struct DebuginatorWrapCacheEntry {
+	DebuginatorItem* item; // NULL if unused
+	const char* description;
+	float width;
+	DebuginatorFont font;
+	unsigned int generation;
+	unsigned int last_used;
+	int row_count;
+	int row_lengths[DEBUGINATOR_MAX_DESCRIPTION_ROWS];
+} DebuginatorWrapCacheEntry;
+
+// The result of text_size for a short string and a font.
+typedef struct DebuginatorTextSizeCacheEntry {
+	unsigned int hash;
+	unsigned int generation;
+	bool is_used;
+	DebuginatorFont font;
+	DebuginatorVector2 size;
+	char text[DEBUGINATOR_TEXT_SIZE_CACHE_MAX_LENGTH];
+} DebuginatorTextSizeCacheEntry;
+
+typedef struct DebuginatorProfileZoneData {
+	double start;
+	int depth; // Item callbacks can nest
+	bool ran_this_frame;
+	float frame_ms;
+	float history_ms[DEBUGINATOR_PROFILER_HISTORY];
+	int history_count;
+	int history_next;
+} DebuginatorProfileZoneData;
+
+// Everything, other than the items themselves, that decides what gets drawn.
+// Compared with memcmp, so it's memset before it's filled in.
+typedef struct DebuginatorDrawState {
+	DebuginatorItem* hot_item;
+	DebuginatorItem* hot_mouse_item;
+	size_t hot_index;
+	unsigned int generation;
+	int root_total_height;
+	int scroll_current;
+	float current_height_offset;
+	float openness;
+	float filter_timer;
+	float tooltip_timer;
+	DebuginatorVector2 top_left;
+	DebuginatorVector2 size;
+	DebuginatorVector2 screen_resolution;
+	DebuginatorVector2 mouse_cursor_pos;
+	int item_height;
+	int quick_draw_size;
+	int theme_index;
+	DebuginatorDrawMode draw_mode;
+	bool is_open;
+	bool filter_enabled;
+	bool notifications_enabled;
+	char open_direction;
+	char filter[DEBUGINATOR_FILTER_MAX_LENGTH];
+} DebuginatorDrawState;
+
+#define DEBUGINATOR_DRAW_COMMAND_PULSING 0x1
+
 struct TheDebuginator {
 	DebuginatorItem* root;
 	DebuginatorItem* hot_item;
@@ -921,8 +1368,45 @@ struct TheDebuginator {
 	DebuginatorLogCallback log;
 	DebuginatorOnOpenChangedCallback on_opened_changed;
 	DebuginatorPlaySoundCallback play_sound;
+	DebuginatorGetTimeCallback get_time;
+	DebuginatorTraceCallback trace;
+	void* trace_userdata;
+	DebuginatorOnItemChangedCallback item_changed_listener;
+	void* item_changed_listener_userdata;
+	DebuginatorCallbackBuffer* callback_buffer;
+	DebuginatorDrawCommandBuffer* draw_command_buffer;
 	int item_height;
 
+	DebuginatorProfileZoneData profile_zones[DEBUGINATOR_ProfileZoneCount];
+	DebuginatorFrameStats frame_stats; // This frame's, so far
+	DebuginatorFrameStats last_frame_stats;
+
+	// Retained drawing. The generation is bumped for every change to the items.
+	bool retained_drawing;
+	bool draw_list_valid;
+	bool draw_list_animating;
+	unsigned char draw_list_mouse_highlight_alpha;
+	unsigned int draw_generation;
+	DebuginatorDrawState draw_list_state;
+
+	// Items whose height may have changed since the last debuginator__update_layout.
+	DebuginatorItem* layout_dirty_items[DEBUGINATOR_MAX_LAYOUT_DIRTY_ITEMS];
+	int layout_dirty_count;
+	bool layout_full_rebuild;
+
+	DebuginatorWrapCacheEntry* wrap_cache; // From the arena, NULL until something's wrapped
+	int wrap_cache_capacity;
+	unsigned int wrap_cache_clock;
+	DebuginatorTextSizeCacheEntry text_size_cache[DEBUGINATOR_TEXT_SIZE_CACHE_SIZE];
+	unsigned int text_cache_generation;
+
+	// Bumped whenever an item's height or visibility changes, or items are added or removed.
+	// The hot item's distance from the root is cached until then.
+	unsigned int layout_generation;
+	unsigned int hot_item_distance_generation;
+	DebuginatorItem* hot_item_distance_item;
+	int hot_item_distance;
+
 	DebuginatorVector2 size;
 	DebuginatorVector2 root_position; // The fixed position where The Debuginator is when it's closed
 	DebuginatorVector2 top_left; // The top-left position where The Debuginator currently is
@@ -952,6 +1436,7 @@ struct TheDebuginator {
 	char* memory_arena; // char* for pointer arithmetic
 	unsigned int memory_arena_capacity;
 	DebuginatorBlockAllocatorStaticData allocator_data;
+	char* staging_blocks; // Only set in staging Debuginators, where their blocks start
 	DebuginatorBlockAllocator allocators[6];
 
 	const char** loaded_settings;
@@ -965,9 +1450,6 @@ struct TheDebuginator {
 	} hot_keys[DEBUGINATOR_MAX_NUM_HOT_KEYS];
 	int num_hot_keys;
 
-	bool bool_values[2];
-	const char* bool_titles[2];
-
 	DebuginatorImageHandle colorpicker_image;
 
 	int notification_count;
@@ -1006,13 +1488,293 @@ static float debuginator__lerp(float a, float b, float t) {
 	return a * (1 - t) + b * t;
 }
 
+// Call whenever something changes that might change what's drawn, and that isn't part of
+// DebuginatorDrawState.
+static void debuginator__mark_dirty(struct TheDebuginator* debuginator) {
+	++debuginator->draw_generation;
+}
+
+#ifdef DEBUGINATOR_ENABLE_PROFILER
+// Moves last frame's times into the history, for the zones that ran.
+static void debuginator__profile_next_frame(struct TheDebuginator* debuginator) {
+	for (int i = 0; i < DEBUGINATOR_ProfileZoneCount; i++) {
+		DebuginatorProfileZoneData* zone = &debuginator->profile_zones[i];
+		if (!zone->ran_this_frame) {
+			continue;
+		}
+
+		zone->history_ms[zone->history_next] = zone->frame_ms;
+		zone->history_next = (zone->history_next + 1) % DEBUGINATOR_PROFILER_HISTORY;
+		zone->history_count = DEBUGINATOR_min(zone->history_count + 1, DEBUGINATOR_PROFILER_HISTORY);
+		zone->ran_this_frame = false;
+		zone->frame_ms = 0;
+	}
+}
+
+static void debuginator__trace(struct TheDebuginator* debuginator, DebuginatorProfileZone zone, DebuginatorItem* item, bool begin, double time) {
+	char item_path[DEBUGINATOR_MAX_PATH_LENGTH];
+	DebuginatorTraceEvent event;
+	event.zone = zone;
+	event.name = debuginator_get_profile_zone_name(zone);
+	event.item_path = NULL;
+	event.begin = begin;
+	event.time = time;
+	if (item != NULL) {
+		// Leaves room for the terminator. If it doesn't fit, the length is set to what's needed.
+		int path_length = DEBUGINATOR_MAX_PATH_LENGTH - 1;
+		debuginator_get_path(debuginator, item, item_path, &path_length);
+		event.item_path = path_length < DEBUGINATOR_MAX_PATH_LENGTH ? item_path : item->title;
+	}
+
+	debuginator->trace(&event, debuginator->trace_userdata);
+}
+
+static void debuginator__profile_begin(struct TheDebuginator* debuginator, DebuginatorProfileZone zone_index, DebuginatorItem* item) {
+	if (debuginator->get_time == NULL) {
+		return;
+	}
+
+	if (zone_index == DEBUGINATOR_ProfileUpdate) {
+		debuginator__profile_next_frame(debuginator);
+	}
+
+	double time = debuginator->get_time(debuginator->app_user_data);
+	DebuginatorProfileZoneData* zone = &debuginator->profile_zones[zone_index];
+	if (zone->depth++ == 0) {
+		zone->start = time;
+	}
+
+	if (debuginator->trace != NULL) {
+		debuginator__trace(debuginator, zone_index, item, true, time);
+	}
+}
+
+static void debuginator__profile_end(struct TheDebuginator* debuginator, DebuginatorProfileZone zone_index, DebuginatorItem* item) {
+	DebuginatorProfileZoneData* zone = &debuginator->profile_zones[zone_index];
+	if (debuginator->get_time == NULL || zone->depth == 0) {
+		return;
+	}
+
+	double time = debuginator->get_time(debuginator->app_user_data);
+	if (--zone->depth == 0) {
+		zone->frame_ms += (float)((time - zone->start) * 1000.0);
+		zone->ran_this_frame = true;
+	}
+
+	if (debuginator->trace != NULL) {
+		debuginator__trace(debuginator, zone_index, item, false, time);
+	}
+}
+#endif
+
+void debuginator_profile_begin(struct TheDebuginator* debuginator, DebuginatorProfileZone zone) {
+	DEBUGINATOR_UNUSED(debuginator);
+	DEBUGINATOR_UNUSED(zone);
+	DEBUGINATOR_PROFILE_BEGIN(debuginator, zone);
+}
+
+void debuginator_profile_end(struct TheDebuginator* debuginator, DebuginatorProfileZone zone) {
+	DEBUGINATOR_UNUSED(debuginator);
+	DEBUGINATOR_UNUSED(zone);
+	DEBUGINATOR_PROFILE_END(debuginator, zone);
+}
+
+void debuginator_set_trace_callback(struct TheDebuginator* debuginator, DebuginatorTraceCallback callback, void* userdata) {
+	debuginator->trace = callback;
+	debuginator->trace_userdata = userdata;
+}
+
+#define DEBUGINATOR_TRACE_JSON_END "\n]}\n"
+
+// Appends all of text or none of it, always leaving room to end the file.
+static void debuginator__trace_json_append(DebuginatorTraceJsonWriter* writer, const char* text, bool is_end) {
+	int length = (int)DEBUGINATOR_strlen(text);
+	int reserved = is_end ? 0 : (int)sizeof(DEBUGINATOR_TRACE_JSON_END) - 1;
+	if ((writer->overflowed && !is_end) || writer->size + length + reserved + 1 > writer->capacity) {
+		writer->overflowed = true;
+		return;
+	}
+
+	DEBUGINATOR_memcpy(writer->buffer + writer->size, text, (size_t)length + 1);
+	writer->size += length;
+}
+
+// Paths are the user's, so they can have anything in them. Writes at most
+// DEBUGINATOR_MAX_PATH_LENGTH * 2 + 3 chars, including the terminator, and returns the length.
+static int debuginator__trace_json_escape(char* escaped, const char* text) {
+	int length = 0;
+	escaped[length++] = '"';
+	for (const char* c = text; *c != '\0' && length < DEBUGINATOR_MAX_PATH_LENGTH * 2; ++c) {
+		if (*c == '"' || *c == '\\') {
+			escaped[length++] = '\\';
+			escaped[length++] = *c;
+		}
+		else if ((unsigned char)*c >= ' ') {
+			escaped[length++] = *c;
+		}
+	}
+	escaped[length++] = '"';
+	escaped[length] = '\0';
+	return length;
+}
+
+void debuginator_trace_json_begin(DebuginatorTraceJsonWriter* writer, char* buffer, int capacity) {
+	writer->buffer = buffer;
+	writer->capacity = capacity;
+	writer->size = 0;
+	writer->num_events = 0;
+	writer->overflowed = false;
+	debuginator__trace_json_append(writer, "{\"traceEvents\":[\n", false);
+}
+
+void debuginator_trace_json_write(const DebuginatorTraceEvent* event, void* userdata) {
+	DebuginatorTraceJsonWriter* writer = (DebuginatorTraceJsonWriter*)userdata;
+
+	// The whole event is formatted first, so that it's either all in the file or not at all.
+	char text[128 + DEBUGINATOR_MAX_PATH_LENGTH * 2 + 3 + 1];
+	DEBUGINATOR_sprintf_s(text, 128, "%s{\"ph\":\"%c\",\"ts\":%.3f,\"pid\":%d,\"tid\":%d,\"cat\":\"debuginator\",\"name\":",
+		writer->num_events > 0 ? ",\n" : "", event->begin ? 'B' : 'E', event->time * 1000000.0, writer->pid, writer->tid);
+	int length = (int)DEBUGINATOR_strlen(text);
+
+	// Item callbacks are named by their item, so that they can be told apart.
+	length += debuginator__trace_json_escape(text + length, event->item_path != NULL ? event->item_path : event->name);
+	text[length++] = '}';
+	text[length] = '\0';
+	debuginator__trace_json_append(writer, text, false);
+	if (!writer->overflowed) {
+		++writer->num_events;
+	}
+}
+
+bool debuginator_trace_json_end(DebuginatorTraceJsonWriter* writer) {
+	// If the start of the file fit, there's room for the end too.
+	if (writer->size == 0) {
+		writer->overflowed = true;
+		return false;
+	}
+
+	debuginator__trace_json_append(writer, DEBUGINATOR_TRACE_JSON_END, true);
+	return !writer->overflowed;
+}
+
+void debuginator_get_profile_stats(struct TheDebuginator* debuginator, DebuginatorProfileZone zone_index, DebuginatorProfileStats* stats) {
+	DEBUGINATOR_memset(stats, 0, sizeof(*stats));
+	DebuginatorProfileZoneData* zone = &debuginator->profile_zones[zone_index];
+	if (zone->history_count == 0) {
+		return;
+	}
+
+	float sum = 0;
+	stats->min_ms = zone->history_ms[0];
+	stats->max_ms = zone->history_ms[0];
+	for (int i = 0; i < zone->history_count; i++) {
+		stats->min_ms = DEBUGINATOR_min(stats->min_ms, zone->history_ms[i]);
+		stats->max_ms = DEBUGINATOR_max(stats->max_ms, zone->history_ms[i]);
+		sum += zone->history_ms[i];
+	}
+
+	stats->avg_ms = sum / zone->history_count;
+	stats->num_frames = zone->history_count;
+}
+
+const char* debuginator_get_profile_zone_name(DebuginatorProfileZone zone) {
+	static const char* names[DEBUGINATOR_ProfileZoneCount] = {
+		"Update", "Update filter", "Draw", "Draw hierarchy", "Draw animations", "Draw tooltip", "Draw notifications", "Item callbacks",
+		"Layout", "Save", "Load", "Queue process",
+	};
+	return names[zone];
+}
+
+void debuginator_get_frame_stats(struct TheDebuginator* debuginator, DebuginatorFrameStats* stats) {
+	*stats = debuginator->last_frame_stats;
+}
+
+// All drawing goes through these, so that it can be recorded into a command buffer
+// instead of going straight to the app.
+static DebuginatorDrawCommand* debuginator__push_draw_command(struct TheDebuginator* debuginator, DebuginatorDrawCommandType type, DebuginatorVector2* position, DebuginatorVector2* size) {
+	DebuginatorDrawCommandBuffer* buffer = debuginator->draw_command_buffer;
+	if (buffer->overflowed || buffer->command_count == buffer->commands_capacity) {
+		buffer->overflowed = true;
+		return NULL;
+	}
+
+	DebuginatorDrawCommand* command = &buffer->commands[buffer->command_count++];
+	DEBUGINATOR_memset(command, 0, sizeof(*command));
+	command->type = (unsigned char)type;
+	command->position = *position;
+	if (size != NULL) {
+		command->size = *size;
+	}
+	return command;
+}
+
+static void debuginator__draw_rect(struct TheDebuginator* debuginator, DebuginatorVector2* position, DebuginatorVector2* size, DebuginatorColor* color) {
+	++debuginator->frame_stats.draw_rect_calls;
+	if (debuginator->draw_command_buffer == NULL) {
+		debuginator->draw_rect(position, size, color, debuginator->app_user_data);
+		return;
+	}
+
+	DebuginatorDrawCommand* command = debuginator__push_draw_command(debuginator, DEBUGINATOR_DrawCommandRect, position, size);
+	if (command != NULL) {
+		command->color = *color;
+		if (color == &debuginator->theme.colors[DEBUGINATOR_ItemTitleActive]) {
+			command->flags |= DEBUGINATOR_DRAW_COMMAND_PULSING;
+		}
+	}
+}
+
+static void debuginator__draw_text(struct TheDebuginator* debuginator, const char* text, DebuginatorVector2* position, DebuginatorColor* color, DebuginatorFont* font) {
+	++debuginator->frame_stats.draw_text_calls;
+	if (debuginator->draw_command_buffer == NULL) {
+		debuginator->draw_text(text, position, color, font, debuginator->app_user_data);
+		return;
+	}
+
+	DebuginatorDrawCommandBuffer* buffer = debuginator->draw_command_buffer;
+	int length = (int)DEBUGINATOR_strlen(text);
+	if (buffer->overflowed || buffer->strings_size + length + 1 > buffer->strings_capacity) {
+		buffer->overflowed = true;
+		return;
+	}
+
+	DebuginatorDrawCommand* command = debuginator__push_draw_command(debuginator, DEBUGINATOR_DrawCommandText, position, NULL);
+	if (command == NULL) {
+		return;
+	}
+
+	DEBUGINATOR_assert(font >= debuginator->theme.fonts && font < debuginator->theme.fonts + DEBUGINATOR_NumDrawTypes);
+	command->font = (unsigned char)(font - debuginator->theme.fonts);
+	command->color = *color;
+	if (color == &debuginator->theme.colors[DEBUGINATOR_ItemTitleActive]) {
+		command->flags |= DEBUGINATOR_DRAW_COMMAND_PULSING;
+	}
+	command->data.text.offset = (unsigned int)buffer->strings_size;
+	command->data.text.length = (unsigned int)length;
+	DEBUGINATOR_memcpy(buffer->strings + buffer->strings_size, text, (size_t)length + 1);
+	buffer->strings_size += length + 1;
+}
+
+static void debuginator__draw_image(struct TheDebuginator* debuginator, DebuginatorVector2* position, DebuginatorVector2* size, DebuginatorImageHandle handle) {
+	++debuginator->frame_stats.draw_image_calls;
+	if (debuginator->draw_command_buffer == NULL) {
+		debuginator->draw_image(position, size, handle, debuginator->app_user_data);
+		return;
+	}
+
+	DebuginatorDrawCommand* command = debuginator__push_draw_command(debuginator, DEBUGINATOR_DrawCommandImage, position, size);
+	if (command != NULL) {
+		command->data.image = handle;
+	}
+}
+
 static void debuginator__quick_draw_default(struct TheDebuginator* debuginator, DebuginatorItem* item, DebuginatorVector2* position) {
 	if (item->leaf.num_values > 0) {
 		DebuginatorVector2 pos = debuginator__vector2(debuginator->top_left.x + debuginator->size.x - debuginator->quick_draw_size, position->y + debuginator->item_height / 2.0f);
 
 		bool is_overriden = item->leaf.active_index != item->leaf.default_index;
 		unsigned default_color_index = is_overriden ? DEBUGINATOR_ItemTitleOverridden : DEBUGINATOR_ItemTitle;
-		debuginator->draw_text(item->leaf.value_titles[item->leaf.active_index], &pos, &debuginator->theme.colors[default_color_index], &debuginator->theme.fonts[DEBUGINATOR_ItemTitle], debuginator->app_user_data);
+		debuginator__draw_text(debuginator, item->leaf.value_titles[item->leaf.active_index], &pos, &debuginator->theme.colors[default_color_index], &debuginator->theme.fonts[DEBUGINATOR_ItemTitle]);
 	}
 }
 
@@ -1025,10 +1787,9 @@ static void debuginator__expanded_draw_default(struct TheDebuginator* debuginato
 			position->y <= debuginator->mouse_cursor_pos.y && debuginator->mouse_cursor_pos.y < position->y + debuginator->item_height;
 
 		if (mouse_over || debuginator->hot_item == item && item->leaf.hot_index == i) {
-			debuginator->hot_mouse_item_index = mouse_over ? i : debuginator->hot_mouse_item_index;
 			DebuginatorVector2 pos = debuginator__vector2(debuginator->top_left.x, position->y);
 			DebuginatorVector2 size = debuginator__vector2(debuginator->size.x, (float)debuginator->item_height);
-			debuginator->draw_rect(&pos, &size, &debuginator->theme.colors[mouse_over ? DEBUGINATOR_LineHighlightMouse : DEBUGINATOR_LineHighlight], debuginator->app_user_data);
+			debuginator__draw_rect(debuginator, &pos, &size, &debuginator->theme.colors[mouse_over ? DEBUGINATOR_LineHighlightMouse : DEBUGINATOR_LineHighlight]);
 		}
 
 		bool forget_state = debuginator->edit_types[(int)item->leaf.edit_type].forget_state;
@@ -1037,7 +1798,7 @@ static void debuginator__expanded_draw_default(struct TheDebuginator* debuginato
 		bool value_overridden = i == item->leaf.active_index && !forget_state;
 		unsigned value_color_index = value_hot ? DEBUGINATOR_ItemValueHot : (value_overridden ? DEBUGINATOR_ItemTitleOverridden : DEBUGINATOR_ItemValueDefault);
 		DebuginatorVector2 text_pos = debuginator__vector2(position->x, position->y + debuginator->item_height / 2.0f);
-		debuginator->draw_text(value_title, &text_pos, &debuginator->theme.colors[value_color_index], &debuginator->theme.fonts[value_hot ? DEBUGINATOR_ItemTitleHot : DEBUGINATOR_ItemTitle], debuginator->app_user_data);
+		debuginator__draw_text(debuginator, value_title, &text_pos, &debuginator->theme.colors[value_color_index], &debuginator->theme.fonts[value_hot ? DEBUGINATOR_ItemTitleHot : DEBUGINATOR_ItemTitle]);
 
 		if (item->leaf.hot_key_index != DEBUGINATOR_NO_HOT_INDEX) {
 			const char* key = debuginator->hot_keys[item->leaf.hot_key_index].key;
@@ -1045,10 +1806,10 @@ static void debuginator__expanded_draw_default(struct TheDebuginator* debuginato
 			if (value_index == i) {
 				DebuginatorVector2 key_rect_pos = debuginator__vector2(debuginator->top_left.x + debuginator->size.x, position->y);
 				DebuginatorVector2 key_rect_size = debuginator__vector2((float)debuginator->item_height, (float)debuginator->item_height);
-				debuginator->draw_rect(&key_rect_pos, &key_rect_size, &debuginator->theme.colors[DEBUGINATOR_Background], debuginator->app_user_data);
+				debuginator__draw_rect(debuginator, &key_rect_pos, &key_rect_size, &debuginator->theme.colors[DEBUGINATOR_Background]);
 
 				DebuginatorVector2 key_text_pos = debuginator__vector2(debuginator->top_left.x + debuginator->size.x + 10, position->y + debuginator->item_height / 2.0f);
-				debuginator->draw_text(key, &key_text_pos, &debuginator->theme.colors[DEBUGINATOR_ItemTitleOverridden], &debuginator->theme.fonts[DEBUGINATOR_ItemTitle], debuginator->app_user_data);
+				debuginator__draw_text(debuginator, key, &key_text_pos, &debuginator->theme.colors[DEBUGINATOR_ItemTitleOverridden], &debuginator->theme.fonts[DEBUGINATOR_ItemTitle]);
 			}
 		}
 	}
@@ -1058,11 +1819,11 @@ static void debuginator__quick_draw_boolean(struct TheDebuginator* debuginator,
 	DebuginatorVector2 size = debuginator__vector2(50, 20);
 	DebuginatorVector2 pos = debuginator__vector2(debuginator->top_left.x + debuginator->size.x - debuginator->quick_draw_size, position->y + debuginator->item_height / 2.0f - size.y / 2.0f);
 	DebuginatorColor background = debuginator__color(0, 0, 0, 100);
-	debuginator->draw_rect(&pos, &size, &background, debuginator->app_user_data);
+	debuginator__draw_rect(debuginator, &pos, &size, &background);
 
-	item->leaf.draw_t += debuginator->dt * 5;
-	if (item->leaf.draw_t > 1) {
-		item->leaf.draw_t = 1;
+	// The update moves the slider along, see debuginator__cache_children_text.
+	if (item->leaf.draw_t < 1) {
+		debuginator->draw_list_animating = true;
 	}
 
 	DebuginatorVector2 slider_pos = pos;
@@ -1082,7 +1843,7 @@ static void debuginator__quick_draw_boolean(struct TheDebuginator* debuginator,
 	DebuginatorColor slider = item->leaf.active_index == 0 ? debuginator->theme.colors[DEBUGINATOR_ItemEditorOff] : debuginator->theme.colors[DEBUGINATOR_ItemEditorOn];
 	slider.a = alpha;
 
-	debuginator->draw_rect(&slider_pos, &size, &slider, debuginator->app_user_data);
+	debuginator__draw_rect(debuginator, &slider_pos, &size, &slider);
 }
 
 static void debuginator__expanded_draw_boolean(struct TheDebuginator* debuginator, DebuginatorItem* item, DebuginatorVector2* position) {
@@ -1097,7 +1858,7 @@ static void debuginator__expanded_draw_boolean(struct TheDebuginator* debuginato
 			DebuginatorVector2 pos = debuginator__vector2(debuginator->top_left.x, position->y);
 			DebuginatorVector2 size = debuginator__vector2(debuginator->size.x, (float)debuginator->item_height);
 			unsigned color_index = mouse_over ? DEBUGINATOR_LineHighlightMouse : DEBUGINATOR_LineHighlight;
-			debuginator->draw_rect(&pos, &size, &debuginator->theme.colors[color_index], debuginator->app_user_data);
+			debuginator__draw_rect(debuginator, &pos, &size, &debuginator->theme.colors[color_index]);
 		}
 
 		const char* value_title = item->leaf.value_titles[i];
@@ -1105,7 +1866,7 @@ static void debuginator__expanded_draw_boolean(struct TheDebuginator* debuginato
 		bool value_overridden = i == item->leaf.active_index;
 		unsigned value_color_index = value_hot ? DEBUGINATOR_ItemValueHot : (value_overridden ? DEBUGINATOR_ItemTitleOverridden : DEBUGINATOR_ItemValueDefault);
 		DebuginatorVector2 text_pos = debuginator__vector2(position->x, position->y + debuginator->item_height / 2.0f);
-		debuginator->draw_text(value_title, &text_pos, &debuginator->theme.colors[value_color_index], &debuginator->theme.fonts[value_hot ? DEBUGINATOR_ItemTitleHot : DEBUGINATOR_ItemTitle], debuginator->app_user_data);
+		debuginator__draw_text(debuginator, value_title, &text_pos, &debuginator->theme.colors[value_color_index], &debuginator->theme.fonts[value_hot ? DEBUGINATOR_ItemTitleHot : DEBUGINATOR_ItemTitle]);
 
 		if (item->leaf.hot_key_index != DEBUGINATOR_NO_HOT_INDEX) {
 			const char* key = debuginator->hot_keys[item->leaf.hot_key_index].key;
@@ -1113,10 +1874,10 @@ static void debuginator__expanded_draw_boolean(struct TheDebuginator* debuginato
 			if (value_index == i) {
 				DebuginatorVector2 key_rect_pos = debuginator__vector2(debuginator->top_left.x + debuginator->size.x, position->y);
 				DebuginatorVector2 key_rect_size = debuginator__vector2((float)debuginator->item_height, (float)debuginator->item_height);
-				debuginator->draw_rect(&key_rect_pos, &key_rect_size, &debuginator->theme.colors[DEBUGINATOR_Background], debuginator->app_user_data);
+				debuginator__draw_rect(debuginator, &key_rect_pos, &key_rect_size, &debuginator->theme.colors[DEBUGINATOR_Background]);
 
 				DebuginatorVector2 key_text_pos = debuginator__vector2(debuginator->top_left.x + debuginator->size.x + 10, position->y + debuginator->item_height / 2.0f);
-				debuginator->draw_text(key, &key_text_pos, &debuginator->theme.colors[DEBUGINATOR_ItemTitleOverridden], &debuginator->theme.fonts[DEBUGINATOR_ItemTitle], debuginator->app_user_data);
+				debuginator__draw_text(debuginator, key, &key_text_pos, &debuginator->theme.colors[DEBUGINATOR_ItemTitleOverridden], &debuginator->theme.fonts[DEBUGINATOR_ItemTitle]);
 			}
 		}
 	}
@@ -1144,6 +1905,7 @@ static void debuginator__quick_draw_colorpicker(struct TheDebuginator* debuginat
 	(void)debuginator, item, position;
 
 	float anim_t = (float)(DEBUGINATOR_sin(debuginator->draw_timer * 0.2) + 1) * 0.5f;
+	debuginator->draw_list_animating = true;
 	float margin = 3.0f;
 	float square_side_size = debuginator->item_height - margin * 2.0f;
 	DebuginatorVector2 square_pos = debuginator__vector2(debuginator->top_left.x + debuginator->size.x - debuginator->quick_draw_size, position->y);
@@ -1154,25 +1916,25 @@ static void debuginator__quick_draw_colorpicker(struct TheDebuginator* debuginat
 	square_size.y = debuginator__floor(square_side_size * anim_t);
 
 	DebuginatorColor square_color = debuginator__color(255, 255, 255, 255);
-	debuginator->draw_rect(&square_pos, &square_size, &square_color, debuginator->app_user_data);
+	debuginator__draw_rect(debuginator, &square_pos, &square_size, &square_color);
 
 	square_pos.y += square_size.y;
 	square_size.y = debuginator__ceil(square_side_size * (1 - anim_t));
 	square_color = debuginator__color(0, 0, 0, 255);
-	debuginator->draw_rect(&square_pos, &square_size, &square_color, debuginator->app_user_data);
+	debuginator__draw_rect(debuginator, &square_pos, &square_size, &square_color);
 
 	square_pos.x += margin;
 	square_pos.y = position->y + 2.0f * margin;
 	square_size.x -= margin * 2.0f;
 	square_size.y = square_side_size - margin * 2.0f;
 	square_color = *(DebuginatorColor*)item->leaf.values;
-	debuginator->draw_rect(&square_pos, &square_size, &square_color, debuginator->app_user_data);
+	debuginator__draw_rect(debuginator, &square_pos, &square_size, &square_color);
 }
 
 static void debuginator__expanded_draw_colorpicker(struct TheDebuginator* debuginator, DebuginatorItem* item, DebuginatorVector2* position) {
 	DEBUGINATOR_UNUSED(item);
 	DebuginatorVector2 image_size = debuginator__vector2(100, 100);
-	debuginator->draw_image(position, &image_size, debuginator->colorpicker_image, debuginator->app_user_data);
+	debuginator__draw_image(debuginator, position, &image_size, debuginator->colorpicker_image);
 }
 
 // static void debuginator__on_expanded_colorpicker(struct TheDebuginator* debuginator, DebuginatorItem* item, DebuginatorVector2* position) {
@@ -1187,13 +1949,27 @@ static void debuginator__quick_draw_numberrange(struct TheDebuginator* debuginat
 	// float* state = (float*)item->leaf.values;
 
 	// float default_value = state[2];
+	// The value lives in the app and can change at any time.
+	debuginator->draw_list_animating = true;
 	float current_value = *(float*)item->user_data;
 	char value_str[64];
 	DEBUGINATOR_sprintf_s(value_str, sizeof(value_str), "%.4f", current_value);
 
 	DebuginatorVector2 pos = debuginator__vector2(debuginator->top_left.x + debuginator->size.x - debuginator->quick_draw_size, position->y + debuginator->item_height / 2.0f);
 	DebuginatorFont* font = &debuginator->theme.fonts[DEBUGINATOR_ItemValueOverridden];
-	debuginator->draw_text(value_str, &pos, &debuginator->theme.colors[DEBUGINATOR_ItemTitleActive], font, debuginator->app_user_data);
+	debuginator__draw_text(debuginator, value_str, &pos, &debuginator->theme.colors[DEBUGINATOR_ItemTitleActive], font);
+}
+
+static void debuginator__quick_draw_profiler(struct TheDebuginator* debuginator, DebuginatorItem* item, DebuginatorVector2* position) {
+	// New stats every frame.
+	debuginator->draw_list_animating = true;
+	DebuginatorProfileStats stats;
+	debuginator_get_profile_stats(debuginator, (DebuginatorProfileZone)(DEBUGINATOR_intptr)item->user_data, &stats);
+	char value_str[64];
+	DEBUGINATOR_sprintf_s(value_str, sizeof(value_str), "%.2f / %.2f / %.2f ms", stats.min_ms, stats.avg_ms, stats.max_ms);
+
+	DebuginatorVector2 pos = debuginator__vector2(debuginator->top_left.x + debuginator->size.x - debuginator->quick_draw_size, position->y + debuginator->item_height / 2.0f);
+	debuginator__draw_text(debuginator, value_str, &pos, &debuginator->theme.colors[DEBUGINATOR_ItemTitle], &debuginator->theme.fonts[DEBUGINATOR_ItemTitle]);
 }
 
 static void debuginator__expanded_draw_numberrange(struct TheDebuginator* debuginator, DebuginatorItem* item, DebuginatorVector2* position) {
@@ -1292,68 +2068,44 @@ static DebuginatorAnimation* debuginator__get_free_animation(struct TheDebuginat
 	return animation;
 }
 
-static void debuginator__set_total_height(DebuginatorItem* item, int height) {
-	if (item->total_height == height) {
-		return;
-	}
-
-	int diff = height - item->total_height;
-	item->total_height = height;
-	DEBUGINATOR_assert(item->total_height >= 0);
-	if (item->parent && !item->parent->folder.is_collapsed) {
-		debuginator__set_total_height(item->parent, item->parent->total_height + diff);
+// Call when the visibility, height or order of the folder's children has changed.
+static void debuginator__layout_changed(struct TheDebuginator* debuginator, DebuginatorItem* folder) {
+	++debuginator->layout_generation;
+	if (folder != NULL && folder->folder.height_index != NULL) {
+		folder->folder.height_index->is_dirty = true;
 	}
 }
 
-static int debuginator__set_item_total_height_recursively(DebuginatorItem* item, int item_height) {
-	if (item->is_folder) {
-		if (item->folder.is_collapsed) {
-			if (item->folder.num_visible_children > 0) {
-				// If a folder doesn't have children, it shouldn't be visible in any case.
-				item->total_height = item_height;
-			}
-			else {
-				item->total_height = 0;
-			}
-		}
-		else {
-			item->total_height = 0;
-			DebuginatorItem* child = item->folder.first_child;
-			while (child != NULL) {
-				item->total_height += debuginator__set_item_total_height_recursively(child, item_height);
-				child = child->next_sibling;
-			}
-
-			if (item->total_height > 0) {
-				item->total_height += item_height;
-			}
-		}
+// Heights aren't updated right away. Instead, whatever changed is marked as dirty and
+// debuginator__update_layout works out the new heights before they're needed.
+static void debuginator__invalidate_layout(struct TheDebuginator* debuginator, DebuginatorItem* item) {
+	if (item == NULL || item->is_layout_dirty || debuginator->layout_full_rebuild) {
+		return;
 	}
-	else {
-		if (item->leaf.is_expanded) {
-			item->total_height = item_height + item_height * item->leaf.description_line_count + item_height * item->leaf.num_values;
-		}
-		else if (!item->is_filtered) {
-			item->total_height = item_height;
-		}
-		else {
-			item->total_height = 0;
-		}
+
+	if (debuginator->layout_dirty_count == DEBUGINATOR_MAX_LAYOUT_DIRTY_ITEMS) {
+		// Lots of changes, like when filtering. Cheaper to just redo everything.
+		debuginator->layout_full_rebuild = true;
+		return;
 	}
 
-	return item->total_height;
+	item->is_layout_dirty = true;
+	debuginator->layout_dirty_items[debuginator->layout_dirty_count++] = item;
 }
 
-static void debuginator__adjust_num_visible_children(DebuginatorItem* item, int diff) {
+static void debuginator__adjust_num_visible_children(struct TheDebuginator* debuginator, DebuginatorItem* item, int diff) {
 	DEBUGINATOR_assert(item->is_folder);
 	DEBUGINATOR_assert(diff != 0 && item->folder.num_visible_children + diff >= 0);
 	item->folder.num_visible_children += diff;
+	debuginator__layout_changed(debuginator, item);
+	debuginator__layout_changed(debuginator, item->parent);
+	debuginator__invalidate_layout(debuginator, item); // Collapsed folders are hidden when empty
 	if (item->folder.num_visible_children == 0 && item->parent != NULL) {
 		// Hide us as well
-		debuginator__adjust_num_visible_children(item->parent, -1);
+		debuginator__adjust_num_visible_children(debuginator, item->parent, -1);
 	}
 	else if (item->folder.num_visible_children == diff && item->parent != NULL) {
-		debuginator__adjust_num_visible_children(item->parent, 1);
+		debuginator__adjust_num_visible_children(debuginator, item->parent, 1);
 	}
 }
 
@@ -1363,6 +2115,9 @@ static void debuginator__on_change_theme(DebuginatorItem* item, void* value, con
 	struct TheDebuginator* debuginator = (struct TheDebuginator*)item->user_data;
 	debuginator->theme_index = *(int*)value;
 	debuginator->theme = debuginator->themes[debuginator->theme_index];
+
+	// The fonts may have changed, and with them how many lines descriptions take up.
+	debuginator->layout_full_rebuild = true;
 }
 
 static void debuginator__set_title(struct TheDebuginator* debuginator, DebuginatorItem* item, const char* title, int title_length) {
@@ -1430,48 +2185,450 @@ static DebuginatorItem* debuginator__first_visible_child(DebuginatorItem* item)
 	return debuginator__next_visible_sibling(item->folder.first_child);
 }
 
-static DebuginatorItem* debuginator__find_first_leaf(DebuginatorItem* item) {
-	if (!item->is_folder) {
-		if (!item->is_filtered) {
-			return item;
-		}
-	}
-	else if (item->folder.num_visible_children > 0 && item->parent != NULL) {
-		// Checking parent is a minor hack to never return the menu root item.
-		return item;
+static bool debuginator__is_visible(DebuginatorItem* item) {
+	if (item->is_folder) {
+		return item->folder.num_visible_children > 0;
 	}
-	else {
-		DebuginatorItem* child = debuginator__first_visible_child(item);
-		DebuginatorItem* leaf = child == NULL ? NULL : debuginator__find_first_leaf(child);
-		if (leaf) {
-			return leaf;
+	return !item->is_filtered;
+}
+
+// Which entry of its parent's height index the item is. Not cleared when the item stops being
+// one, so it's only true if the entry points back at the item. Kept in the leaf and folder
+// data, where there's room for it, so that items don't get any bigger.
+static int* debuginator__height_index_entry(DebuginatorItem* item) {
+	return item->is_folder ? &item->folder.height_index_entry : &item->leaf.height_index_entry;
+}
+
+// Finds the entry of the visible child, or of the closest visible sibling before it that has
+// one, at most a stride away. offset is set to how far below that entry the child is.
+// Returns -1 if the index is out of date.
+static int debuginator__find_height_index_entry(DebuginatorHeightIndex* index, DebuginatorItem* child, int* offset) {
+	*offset = 0;
+	for (int steps = 0; child != NULL && steps <= index->stride; ++steps) {
+		int entry = *debuginator__height_index_entry(child);
+		if (entry >= 0 && entry < index->count && index->entries[entry].child == child) {
+			return entry;
 		}
-	}
 
-	DebuginatorItem* sibling = debuginator__next_visible_sibling(item);
-	while (sibling != NULL) {
-		item = debuginator__find_first_leaf(sibling);
-		if (item != NULL) {
-			return item;
+		child = debuginator__prev_visible_sibling(child);
+		if (child != NULL) {
+			*offset += child->total_height;
 		}
-		sibling = debuginator__next_visible_sibling(sibling);
 	}
 
-	return NULL;
+	return -1;
 }
 
-static DebuginatorItem* debuginator__find_last_leaf(DebuginatorItem* item) {
-	if (!item->is_folder) {
-		if (!item->is_filtered) {
-			return item;
-		}
+// When only a child's height has changed, the entries after it are moved instead of building
+// the whole index again. That's a pass over the entries rather than the children, which for
+// a folder with n children is n / stride. Changes to which children are visible, or their
+// order, go through debuginator__layout_changed and rebuild it.
+static void debuginator__height_index_child_resized(DebuginatorItem* folder, DebuginatorItem* child, int diff) {
+	DebuginatorHeightIndex* index = folder->folder.height_index;
+	if (index == NULL || index->is_dirty) {
+		return;
 	}
-	else if (item->folder.is_collapsed) {
-		return item;
+
+	int offset;
+	int entry = debuginator__is_visible(child) ? debuginator__find_height_index_entry(index, child, &offset) : -1;
+	if (entry == -1) {
+		index->is_dirty = true;
+		return;
 	}
-	else {
-		DebuginatorItem* child = debuginator__first_visible_child(item);
-		while (debuginator__next_visible_sibling(child) != NULL) {
+
+	for (int i = entry + 1; i < index->count; ++i) {
+		index->entries[i].y += diff;
+	}
+}
+
+static void debuginator__build_height_index(struct TheDebuginator* debuginator, DebuginatorItem* folder) {
+	DebuginatorHeightIndex* index = folder->folder.height_index;
+	if (index == NULL) {
+		int bytes = (int)(debuginator->allocator_data.block_capacity - sizeof(DebuginatorBlockAllocator*));
+		index = (DebuginatorHeightIndex*)debuginator__allocate(debuginator, bytes);
+		index->entries = (DebuginatorHeightIndexEntry*)(void*)(index + 1);
+		index->capacity = (int)((bytes - sizeof(DebuginatorHeightIndex)) / sizeof(DebuginatorHeightIndexEntry));
+		folder->folder.height_index = index;
+	}
+
+	// A longer stride for huge folders so that it always fits.
+	int num_children = folder->folder.num_visible_children;
+	index->stride = DEBUGINATOR_max(DEBUGINATOR_HEIGHT_INDEX_STRIDE, (num_children + index->capacity - 1) / index->capacity);
+	index->count = 0;
+	index->is_dirty = false;
+
+	int y = 0;
+	int child_index = 0;
+	DebuginatorItem* child = debuginator__first_visible_child(folder);
+	while (child != NULL && index->count < index->capacity) {
+		if (child_index % index->stride == 0) {
+			*debuginator__height_index_entry(child) = index->count;
+			index->entries[index->count].child = child;
+			index->entries[index->count].y = y;
+			++index->count;
+		}
+
+		y += child->total_height;
+		++child_index;
+		child = debuginator__next_visible_sibling(child);
+	}
+}
+
+// Returns a visible child of the folder such that all the children before it end above
+// top, i.e. they don't need to be drawn. y is where the first visible child is drawn, and is
+// moved to where the returned child is drawn.
+// For big folders this is a binary search in the folder's height index, which is kept up
+// to date by debuginator__update_layout. For others it's just the first visible child.
+static DebuginatorItem* debuginator__skip_children_above(DebuginatorItem* folder, float* y, float top) {
+	DebuginatorHeightIndex* index = folder->folder.height_index;
+	if (folder->folder.is_collapsed || index == NULL || index->is_dirty || *y >= top) {
+		return debuginator__first_visible_child(folder);
+	}
+
+	// Find the last entry that starts at or above the top.
+	int low = 0;
+	int high = index->count - 1;
+	while (low < high) {
+		int middle = (low + high + 1) / 2;
+		if (*y + index->entries[middle].y <= top) {
+			low = middle;
+		}
+		else {
+			high = middle - 1;
+		}
+	}
+
+	if (index->count == 0) {
+		return debuginator__first_visible_child(folder);
+	}
+
+	*y += index->entries[low].y;
+	return index->entries[low].child;
+}
+
+static bool debuginator__wants_height_index(DebuginatorItem* folder) {
+	return !folder->folder.is_collapsed && folder->folder.num_visible_children >= DEBUGINATOR_HEIGHT_INDEX_MIN_CHILDREN;
+}
+
+// Where debuginator__draw_item draws the description.
+static float debuginator__description_width(struct TheDebuginator* debuginator, DebuginatorItem* item) {
+	int indent = DEBUGINATOR_LEFT_MARGIN;
+	DebuginatorItem* temp_parent = item->parent;
+	while (temp_parent) {
+		indent += DEBUGINATOR_INDENT;
+		temp_parent = temp_parent->parent;
+	}
+
+	return debuginator->size.x - 50 - indent;
+}
+
+// Where debuginator__draw_tooltip draws the description.
+static float debuginator__tooltip_width(struct TheDebuginator* debuginator) {
+	return debuginator->size.x - DEBUGINATOR_LEFT_MARGIN * 2;
+}
+
+// The label drawn next to items that have a hot key. Returns false if there isn't one.
+static bool debuginator__hot_key_label(struct TheDebuginator* debuginator, DebuginatorItem* item, char* hot_key_text) {
+	if (item->leaf.hot_key_index == DEBUGINATOR_NO_HOT_INDEX
+		|| (debuginator->hot_keys[item->leaf.hot_key_index].value_index != DEBUGINATOR_NO_HOT_INDEX && item->leaf.is_expanded)) {
+		return false;
+	}
+
+	const char* key = debuginator->hot_keys[item->leaf.hot_key_index].key;
+	int hot_key_value_index = debuginator->hot_keys[item->leaf.hot_key_index].value_index;
+	if (hot_key_value_index == DEBUGINATOR_NO_HOT_INDEX) {
+		DEBUGINATOR_sprintf_s(hot_key_text, DEBUGINATOR_MAX_PATH_LENGTH, "%s", key);
+	}
+	else {
+		DEBUGINATOR_sprintf_s(hot_key_text, DEBUGINATOR_MAX_PATH_LENGTH, "%s: %s", key, item->leaf.value_titles[hot_key_value_index]);
+	}
+
+	return true;
+}
+
+static bool debuginator__font_equals(const DebuginatorFont* a, const DebuginatorFont* b) {
+	return a->userdata == b->userdata && a->draw_type == b->draw_type && a->size == b->size && a->bold == b->bold && a->italic == b->italic;
+}
+
+static bool debuginator__wrap_cache_entry_matches(struct TheDebuginator* debuginator, DebuginatorWrapCacheEntry* entry, DebuginatorItem* item, float width, DebuginatorFont* font) {
+	return entry->item == item && entry->description == item->leaf.description && entry->width == width
+		&& entry->generation == debuginator->text_cache_generation && debuginator__font_equals(&entry->font, font);
+}
+
+static void debuginator__word_wrap_into(struct TheDebuginator* debuginator, DebuginatorWrapCacheEntry* entry, DebuginatorItem* item, float width, DebuginatorFont* font) {
+	entry->item = item;
+	entry->description = item->leaf.description;
+	entry->width = width;
+	entry->font = *font;
+	entry->generation = debuginator->text_cache_generation;
+	entry->row_count = 0;
+	++debuginator->frame_stats.word_wrap_calls;
+	debuginator->word_wrap(item->leaf.description, font, width, &entry->row_count, entry->row_lengths, DEBUGINATOR_MAX_DESCRIPTION_ROWS, debuginator->app_user_data);
+}
+
+// Every item on screen takes up at least one row, so with an entry per row, and one for the
+// tooltip, the update never evicts a description that it wrapped earlier in the same frame. Grows
+// with the panel, up to what fits in one allocation.
+static void debuginator__reserve_wrap_cache(struct TheDebuginator* debuginator) {
+	int wanted = (int)debuginator->size.y / DEBUGINATOR_max(1, debuginator->item_height) + 3;
+	wanted = DEBUGINATOR_max(DEBUGINATOR_WRAP_CACHE_SIZE, wanted);
+	wanted = DEBUGINATOR_min(wanted, (int)((DEBUGINATOR_ALLOCATOR_BLOCK_SIZE - sizeof(DebuginatorBlockAllocator*)) / sizeof(DebuginatorWrapCacheEntry)));
+	if (wanted <= debuginator->wrap_cache_capacity) {
+		return;
+	}
+
+	if (debuginator->wrap_cache != NULL) {
+		debuginator__deallocate(debuginator, debuginator->wrap_cache);
+	}
+
+	// Zeroed, so every entry starts out unused.
+	debuginator->wrap_cache = (DebuginatorWrapCacheEntry*)debuginator__allocate(debuginator, (int)sizeof(DebuginatorWrapCacheEntry) * wanted);
+	debuginator->wrap_cache_capacity = wanted;
+}
+
+// Word wraps the item's description, or returns the cached result if nothing has changed.
+// Only called from the update, drawing uses debuginator__find_wrapped_description.
+static DebuginatorWrapCacheEntry* debuginator__wrap_description(struct TheDebuginator* debuginator, DebuginatorItem* item, float width) {
+	debuginator__reserve_wrap_cache(debuginator);
+	DebuginatorFont* font = &debuginator->theme.fonts[DEBUGINATOR_ItemDescription];
+	DebuginatorWrapCacheEntry* oldest = &debuginator->wrap_cache[0];
+	for (int i = 0; i < debuginator->wrap_cache_capacity; ++i) {
+		DebuginatorWrapCacheEntry* entry = &debuginator->wrap_cache[i];
+		if (debuginator__wrap_cache_entry_matches(debuginator, entry, item, width, font)) {
+			entry->last_used = ++debuginator->wrap_cache_clock;
+			return entry;
+		}
+
+		if (entry->item == NULL || (oldest->item != NULL && entry->last_used < oldest->last_used)) {
+			oldest = entry;
+		}
+	}
+
+	debuginator__word_wrap_into(debuginator, oldest, item, width, font);
+	oldest->last_used = ++debuginator->wrap_cache_clock;
+	return oldest;
+}
+
+// Returns the wrapped description that the update cached, without touching the cache. NULL if
+// it wasn't cached, like for an item that was expanded after the update.
+static DebuginatorWrapCacheEntry* debuginator__find_wrapped_description(struct TheDebuginator* debuginator, DebuginatorItem* item, float width) {
+	DebuginatorFont* font = &debuginator->theme.fonts[DEBUGINATOR_ItemDescription];
+	for (int i = 0; i < debuginator->wrap_cache_capacity; ++i) {
+		if (debuginator__wrap_cache_entry_matches(debuginator, &debuginator->wrap_cache[i], item, width, font)) {
+			return &debuginator->wrap_cache[i];
+		}
+	}
+
+	return NULL;
+}
+
+// Finds where text would be in the text size cache. NULL if it's too long to be cached.
+static DebuginatorTextSizeCacheEntry* debuginator__text_size_cache_slot(struct TheDebuginator* debuginator, const char* text, DebuginatorFont* font, unsigned int* out_hash) {
+	unsigned int hash = 2166136261u;
+	size_t length = 0;
+	for (; text[length] != '\0'; ++length) {
+		hash = (hash ^ (unsigned char)text[length]) * 16777619u;
+	}
+
+	if (length >= DEBUGINATOR_TEXT_SIZE_CACHE_MAX_LENGTH) {
+		return NULL;
+	}
+
+	hash = (hash ^ (unsigned int)font->size) * 16777619u;
+	hash = (hash ^ ((font->bold ? 1u : 0u) | (font->italic ? 2u : 0u))) * 16777619u;
+	*out_hash = hash;
+	return &debuginator->text_size_cache[hash & (DEBUGINATOR_TEXT_SIZE_CACHE_SIZE - 1)];
+}
+
+static bool debuginator__text_size_cache_entry_matches(struct TheDebuginator* debuginator, DebuginatorTextSizeCacheEntry* entry, unsigned int hash, const char* text, DebuginatorFont* font) {
+	return entry->is_used && entry->hash == hash && entry->generation == debuginator->text_cache_generation
+		&& debuginator__font_equals(&entry->font, font) && DEBUGINATOR_strcmp(entry->text, text) == 0;
+}
+
+// Measures strings that are drawn often, like the hot key labels and the search box, so that
+// debuginator__text_size finds them. Keyed on the string's hash and the font. Only called from
+// the update.
+static void debuginator__cache_text_size(struct TheDebuginator* debuginator, const char* text, DebuginatorFont* font) {
+	unsigned int hash;
+	DebuginatorTextSizeCacheEntry* entry = debuginator__text_size_cache_slot(debuginator, text, font, &hash);
+	if (entry == NULL || debuginator__text_size_cache_entry_matches(debuginator, entry, hash, text, font)) {
+		return;
+	}
+
+	entry->is_used = true;
+	entry->hash = hash;
+	entry->generation = debuginator->text_cache_generation;
+	entry->font = *font;
+	++debuginator->frame_stats.text_size_calls;
+	entry->size = debuginator->text_size(text, font, debuginator->app_user_data);
+	DEBUGINATOR_memcpy(entry->text, text, DEBUGINATOR_strlen(text) + 1);
+}
+
+// Same as the text_size callback, but returns the size cached by the update if there is one.
+// Never writes to the cache.
+static DebuginatorVector2 debuginator__text_size(struct TheDebuginator* debuginator, const char* text, DebuginatorFont* font) {
+	unsigned int hash;
+	DebuginatorTextSizeCacheEntry* entry = debuginator__text_size_cache_slot(debuginator, text, font, &hash);
+	if (entry != NULL && debuginator__text_size_cache_entry_matches(debuginator, entry, hash, text, font)) {
+		return entry->size;
+	}
+
+	++debuginator->frame_stats.text_size_calls;
+	return debuginator->text_size(text, font, debuginator->app_user_data);
+}
+
+// Items without a description have "" rather than NULL.
+static int debuginator__description_line_count(struct TheDebuginator* debuginator, DebuginatorItem* item) {
+	return debuginator__wrap_description(debuginator, item, debuginator__description_width(debuginator, item))->row_count;
+}
+
+static int debuginator__calculate_height(struct TheDebuginator* debuginator, DebuginatorItem* item) {
+	int item_height = debuginator->item_height;
+	if (item->is_folder) {
+		if (item->folder.is_collapsed) {
+			// If a folder doesn't have children, it shouldn't be visible in any case.
+			return item->folder.num_visible_children > 0 ? item_height : 0;
+		}
+
+		return item->folder.children_height > 0 ? item->folder.children_height + item_height : 0;
+	}
+
+	if (item->leaf.is_expanded) {
+		// Measured again every time, since the width or font may have changed. It's cached.
+		item->leaf.description_line_count = debuginator__description_line_count(debuginator, item);
+		return item_height + item_height * item->leaf.description_line_count + item_height * item->leaf.num_values;
+	}
+
+	return item->is_filtered ? 0 : item_height;
+}
+
+static int debuginator__layout_recursively(struct TheDebuginator* debuginator, DebuginatorItem* item) {
+	item->is_layout_dirty = false;
+	if (item->is_folder) {
+		// Collapsed folders' children too, so that children_height is right when expanded again.
+		item->folder.children_height = 0;
+		DebuginatorItem* child = item->folder.first_child;
+		while (child != NULL) {
+			item->folder.children_height += debuginator__layout_recursively(debuginator, child);
+			child = child->next_sibling;
+		}
+
+		if (debuginator__wants_height_index(item) || item->folder.height_index != NULL) {
+			debuginator__build_height_index(debuginator, item);
+		}
+	}
+
+	item->total_height = debuginator__calculate_height(debuginator, item);
+	return item->total_height;
+}
+
+// Recalculates the heights of the dirty items, and their parents as long as that changes
+// anything. Also rebuilds the height indices that have gone out of date. Called when
+// updating and before anything that needs to know where items are, but never when drawing.
+static void debuginator__update_dirty_layout(struct TheDebuginator* debuginator) {
+	if (debuginator->layout_full_rebuild) {
+		for (int i = 0; i < debuginator->layout_dirty_count; ++i) {
+			debuginator->layout_dirty_items[i]->is_layout_dirty = false;
+		}
+
+		debuginator->layout_dirty_count = 0;
+		debuginator->layout_full_rebuild = false;
+		debuginator__layout_recursively(debuginator, debuginator->root);
+		++debuginator->layout_generation;
+		return;
+	}
+
+	for (int i = 0; i < debuginator->layout_dirty_count; ++i) {
+		DebuginatorItem* item = debuginator->layout_dirty_items[i];
+		item->is_layout_dirty = false;
+		while (item != NULL) {
+			int height = debuginator__calculate_height(debuginator, item);
+			if (height == item->total_height) {
+				break;
+			}
+
+			int diff = height - item->total_height;
+			item->total_height = height;
+			++debuginator->layout_generation;
+			if (item->parent != NULL) {
+				item->parent->folder.children_height += diff;
+				debuginator__height_index_child_resized(item->parent, item, diff);
+			}
+
+			item = item->parent;
+		}
+	}
+
+	// Separately, so that each index is rebuilt once no matter how many of its children changed.
+	for (int i = 0; i < debuginator->layout_dirty_count; ++i) {
+		DebuginatorItem* folder = debuginator->layout_dirty_items[i];
+		for (; folder != NULL; folder = folder->parent) {
+			if (!folder->is_folder) {
+				continue;
+			}
+
+			DebuginatorHeightIndex* index = folder->folder.height_index;
+			if ((index == NULL && debuginator__wants_height_index(folder)) || (index != NULL && index->is_dirty)) {
+				debuginator__build_height_index(debuginator, folder);
+			}
+		}
+	}
+
+	debuginator->layout_dirty_count = 0;
+}
+
+static void debuginator__update_layout(struct TheDebuginator* debuginator) {
+	if (!debuginator->layout_full_rebuild && debuginator->layout_dirty_count == 0) {
+		return;
+	}
+
+	DEBUGINATOR_PROFILE_BEGIN(debuginator, DEBUGINATOR_ProfileLayout);
+	debuginator__update_dirty_layout(debuginator);
+	DEBUGINATOR_PROFILE_END(debuginator, DEBUGINATOR_ProfileLayout);
+}
+
+static DebuginatorItem* debuginator__find_first_leaf(DebuginatorItem* item) {
+	if (!item->is_folder) {
+		if (!item->is_filtered) {
+			return item;
+		}
+	}
+	else if (item->folder.num_visible_children > 0 && item->parent != NULL) {
+		// Checking parent is a minor hack to never return the menu root item.
+		return item;
+	}
+	else {
+		DebuginatorItem* child = debuginator__first_visible_child(item);
+		DebuginatorItem* leaf = child == NULL ? NULL : debuginator__find_first_leaf(child);
+		if (leaf) {
+			return leaf;
+		}
+	}
+
+	DebuginatorItem* sibling = debuginator__next_visible_sibling(item);
+	while (sibling != NULL) {
+		item = debuginator__find_first_leaf(sibling);
+		if (item != NULL) {
+			return item;
+		}
+		sibling = debuginator__next_visible_sibling(sibling);
+	}
+
+	return NULL;
+}
+
+static DebuginatorItem* debuginator__find_last_leaf(DebuginatorItem* item) {
+	if (!item->is_folder) {
+		if (!item->is_filtered) {
+			return item;
+		}
+	}
+	else if (item->folder.is_collapsed) {
+		return item;
+	}
+	else {
+		DebuginatorItem* child = debuginator__first_visible_child(item);
+		while (debuginator__next_visible_sibling(child) != NULL) {
 			child = debuginator__next_visible_sibling(child);
 		}
 
@@ -1546,12 +2703,13 @@ static DebuginatorItem* debuginator__nearest_visible_item(DebuginatorItem* item)
 	return found_item;
 }
 
-static void debuginator__set_parent(DebuginatorItem* item, DebuginatorItem* parent) {
+static void debuginator__set_parent(struct TheDebuginator* debuginator, DebuginatorItem* item, DebuginatorItem* parent) {
 	if (parent == NULL)
 		return;
 
 	DEBUGINATOR_assert(item->parent == NULL || item->parent == parent);
 	item->parent = parent;
+	debuginator__layout_changed(debuginator, parent);
 	if (parent->folder.first_child == NULL) {
 		parent->folder.first_child = item;
 	}
@@ -1595,9 +2753,10 @@ static void debuginator__set_parent(DebuginatorItem* item, DebuginatorItem* pare
 	}
 }
 
-static void debuginator__store_item_setting(struct TheDebuginator* debuginator, const char* path, const char* value_title) {
+// Only the first num_settings_to_search settings are checked for an existing one with the same path.
+static void debuginator__store_item_setting(struct TheDebuginator* debuginator, const char* path, const char* value_title, int num_settings_to_search) {
 	// If it already exists, we override the value
-	for (int i = 0; i < debuginator->num_loaded_settings; ++i) {
+	for (int i = 0; i < num_settings_to_search; ++i) {
 		int setting_index = i * 2;
 		if (DEBUGINATOR_strcmp(debuginator->loaded_settings[setting_index], path) == 0) {
 			debuginator__deallocate(debuginator, debuginator->loaded_settings[setting_index + 1]);
@@ -1672,13 +2831,14 @@ static const char* debuginator__compute_path(struct TheDebuginator* debuginator,
 }
 
 DebuginatorItem* debuginator_new_folder_item(struct TheDebuginator* debuginator, DebuginatorItem* parent, const char* title, int title_length) {
+	debuginator__mark_dirty(debuginator);
 	DebuginatorItem* folder_item = (DebuginatorItem*)debuginator__allocate(debuginator, sizeof(DebuginatorItem));
 	folder_item->is_folder = true;
 	folder_item->folder.num_visible_children = 0;
 	folder_item->folder.is_sorted = debuginator->sort_items;
 	debuginator__set_title(debuginator, folder_item, title, title_length);
-	debuginator__set_parent(folder_item, parent);
-	debuginator__set_total_height(folder_item, debuginator->item_height);
+	debuginator__set_parent(debuginator, folder_item, parent);
+	debuginator__invalidate_layout(debuginator, folder_item);
 
 	const char* full_path = debuginator__compute_path(debuginator, parent, title, title_length);
 	const char* item_setting = debuginator__get_item_setting(debuginator, full_path);
@@ -1695,7 +2855,7 @@ DebuginatorItem* debuginator_create_folder_item(struct TheDebuginator* debuginat
 	DebuginatorItem* folder_item = debuginator_get_item(debuginator, parent, path, &create_if_not_exist);
 	folder_item->is_folder = true;
 	folder_item->folder.is_sorted = debuginator->sort_items;
-	debuginator__set_total_height(folder_item, debuginator->item_height);
+	debuginator__invalidate_layout(debuginator, folder_item);
 
 	const char* full_path = debuginator__compute_path(debuginator, parent, path, 0);
 	const char* item_setting = debuginator__get_item_setting(debuginator, full_path);
@@ -1745,7 +2905,7 @@ DebuginatorItem* debuginator_get_item(struct TheDebuginator* debuginator, Debugi
 			if (current_item == NULL) {
 				current_item = (DebuginatorItem*)debuginator__allocate(debuginator, sizeof(DebuginatorItem));
 				debuginator__set_title(debuginator, current_item, temp_path, 0);
-				debuginator__set_parent(current_item, parent);
+				debuginator__set_parent(debuginator, current_item, parent);
 			}
 
 			return current_item;
@@ -1808,6 +2968,7 @@ DebuginatorItem* debuginator_create_array_item(struct TheDebuginator* debuginato
 	DebuginatorItem* parent, const char* path, const char* description,
 	DebuginatorOnItemChangedCallback on_item_changed_callback, void* user_data,
 	const char** value_titles, void* values, int num_values, int value_size) {
+	debuginator__mark_dirty(debuginator);
 
 	bool old_notifications_enabled = debuginator->notifications_enabled;
 	debuginator->notifications_enabled = false;
@@ -1821,7 +2982,7 @@ DebuginatorItem* debuginator_create_array_item(struct TheDebuginator* debuginato
 	item->leaf.on_item_changed_callback = on_item_changed_callback;
 	item->leaf.hot_key_index = DEBUGINATOR_NO_HOT_INDEX;
 	item->user_data = user_data;
-	debuginator__set_total_height(item, debuginator->item_height);
+	debuginator__invalidate_layout(debuginator, item);
 
 	if (item->leaf.hot_index >= num_values) {
 		item->leaf.hot_index = num_values - 1;
@@ -1849,24 +3010,13 @@ DebuginatorItem* debuginator_create_array_item(struct TheDebuginator* debuginato
 
 	if (create_if_not_exist) {
 		// Only want to update this if the item didn't already exist.
-		debuginator__adjust_num_visible_children(item->parent, 1);
+		debuginator__adjust_num_visible_children(debuginator, item->parent, 1);
 	}
 
-	if (description && !item->is_folder) {
-		int indent = DEBUGINATOR_LEFT_MARGIN;
-		DebuginatorItem* temp_parent = item->parent;
-		while (temp_parent) {
-			indent += DEBUGINATOR_INDENT;
-			temp_parent = temp_parent->parent;
-		}
-
-		float description_width = debuginator->size.x - 50 - indent;
-		int row_lengths[32];
-		int row_count = 0;
-		debuginator->word_wrap(item->leaf.description, &debuginator->theme.fonts[DEBUGINATOR_ItemDescription], description_width, &row_count, row_lengths, 32, debuginator->app_user_data);
-		item->leaf.description_line_count = row_count;
-	} else if (!item->is_folder) {
-		item->leaf.description_line_count = 0;
+	if (!item->is_folder) {
+		// Most items are never expanded, so word wrapping the description waits until the
+		// layout needs it.
+		item->leaf.description_line_count = description != NULL ? DEBUGINATOR_DESCRIPTION_NOT_MEASURED : 0;
 	}
 
 	char hot_path_key[DEBUGINATOR_MAX_PATH_LENGTH + 16] = { 0 };
@@ -1890,7 +3040,7 @@ DebuginatorItem* debuginator_create_array_item(struct TheDebuginator* debuginato
 	return item;
 }
 
-bool debuginator_save(struct TheDebuginator* debuginator, DebuginatorSaveItemCallback callback, void* userdata) {
+static bool debuginator__save(struct TheDebuginator* debuginator, DebuginatorSaveItemCallback callback, void* userdata) {
 	char current_full_path[1024] = { 0 };
 	size_t path_indices[DEBUGINATOR_MAX_HIERARCHY_SIZE] = { 0 };
 	int current_path_index = 0;
@@ -1900,7 +3050,7 @@ bool debuginator_save(struct TheDebuginator* debuginator, DebuginatorSaveItemCal
 		if (item->is_folder) {
 			if (item->folder.first_child != NULL) {
 				size_t folder_title_length = (size_t)DEBUGINATOR_strlen(item->title);
-				DEBUGINATOR_strcpy_s(current_full_path + path_indices[current_path_index], folder_title_length + 1, item->title); // HACK
+				DEBUGINATOR_strcpy_s(current_full_path + path_indices[current_path_index], sizeof(current_full_path) - path_indices[current_path_index], item->title);
 
 				if (item->folder.is_collapsed) {
 					bool saved = callback(current_full_path, DEBUGINATOR_FOLDER_COLLAPSED_STRING, userdata);
@@ -1920,7 +3070,7 @@ bool debuginator_save(struct TheDebuginator* debuginator, DebuginatorSaveItemCal
 			}
 		}
 		else {
-			DEBUGINATOR_strcpy_s(current_full_path + path_indices[current_path_index], 50, item->title); // HACK
+			DEBUGINATOR_strcpy_s(current_full_path + path_indices[current_path_index], sizeof(current_full_path) - path_indices[current_path_index], item->title);
 			path_indices[current_path_index + 1] = path_indices[current_path_index] + (size_t)DEBUGINATOR_strlen(item->title);
 			//int current_path_length = path_indices[current_path_index + 1];
 
@@ -1973,12 +3123,15 @@ bool debuginator_save(struct TheDebuginator* debuginator, DebuginatorSaveItemCal
 	return true;
 }
 
-void debuginator_load_item(struct TheDebuginator* debuginator, const char* key, const char* value) {
-	// First we store path + value so that we can use it later when (re)creating the item.
-	debuginator__store_item_setting(debuginator, key, value);
+bool debuginator_save(struct TheDebuginator* debuginator, DebuginatorSaveItemCallback callback, void* userdata) {
+	DEBUGINATOR_PROFILE_BEGIN(debuginator, DEBUGINATOR_ProfileSave);
+	bool saved = debuginator__save(debuginator, callback, userdata);
+	DEBUGINATOR_PROFILE_END(debuginator, DEBUGINATOR_ProfileSave);
+	return saved;
+}
 
-	// Then we check if the item already existed, and if so, update its state.
-	DebuginatorItem* item = debuginator_get_item(debuginator, NULL, key, NULL);
+// value_index_hint is where the value is expected to be, it's checked before searching for it.
+static void debuginator__apply_item_setting(struct TheDebuginator* debuginator, DebuginatorItem* item, const char* value, int value_index_hint) {
 	if (item == NULL) {
 		// Pass
 	}
@@ -1989,16 +3142,305 @@ void debuginator_load_item(struct TheDebuginator* debuginator, const char* key,
 		}
 	}
 	else {
-		for (int i = 0; i < item->leaf.num_values; i++) {
+		int value_index = DEBUGINATOR_NO_HOT_INDEX;
+		if (value_index_hint >= 0 && value_index_hint < item->leaf.num_values && DEBUGINATOR_strcmp(item->leaf.value_titles[value_index_hint], value) == 0) {
+			value_index = value_index_hint;
+		}
+
+		for (int i = 0; i < item->leaf.num_values && value_index == DEBUGINATOR_NO_HOT_INDEX; i++) {
 			if (DEBUGINATOR_strcmp(item->leaf.value_titles[i], value) == 0) {
-				item->leaf.hot_index = i;
-				if (!debuginator->edit_types[(int)item->leaf.edit_type].forget_state) {
-					debuginator_activate(debuginator, item, false);
+				value_index = i;
+			}
+		}
+
+		if (value_index != DEBUGINATOR_NO_HOT_INDEX) {
+			item->leaf.hot_index = value_index;
+			if (!debuginator->edit_types[(int)item->leaf.edit_type].forget_state) {
+				debuginator_activate(debuginator, item, false);
+			}
+		}
+	}
+}
+
+static void debuginator__load_item(struct TheDebuginator* debuginator, const char* key, const char* value) {
+	debuginator__mark_dirty(debuginator);
+	// First we store path + value so that we can use it later when (re)creating the item.
+	debuginator__store_item_setting(debuginator, key, value, debuginator->num_loaded_settings);
+
+	// Then we check if the item already existed, and if so, update its state.
+	DebuginatorItem* item = debuginator_get_item(debuginator, NULL, key, NULL);
+	debuginator__apply_item_setting(debuginator, item, value, DEBUGINATOR_NO_HOT_INDEX);
+}
+
+void debuginator_load_item(struct TheDebuginator* debuginator, const char* key, const char* value) {
+	DEBUGINATOR_PROFILE_BEGIN(debuginator, DEBUGINATOR_ProfileLoad);
+	debuginator__load_item(debuginator, key, value);
+	DEBUGINATOR_PROFILE_END(debuginator, DEBUGINATOR_ProfileLoad);
+}
+
+// Binary save format. After the header, one record per saved setting, in the same order as debuginator_save:
+//   type (1 byte), shared path length (varint), suffix length (varint), suffix
+// where the path is the first "shared path length" bytes of the previous record's path followed by the suffix.
+// Then, depending on type:
+//   Value:     value index (varint), value title (zero terminated)
+//   Collapsed: nothing
+//   HotKey:    key (zero terminated), value index + 1 or 0 if none (varint), value title (zero terminated)
+#define DEBUGINATOR_BINARY_MAGIC "DBGS"
+#define DEBUGINATOR_BINARY_VERSION 1
+#define DEBUGINATOR_BINARY_HEADER_SIZE 5
+
+typedef enum DebuginatorBinaryRecordType {
+	DEBUGINATOR_BinaryRecordValue = 1,
+	DEBUGINATOR_BinaryRecordCollapsed,
+	DEBUGINATOR_BinaryRecordHotKey,
+} DebuginatorBinaryRecordType;
+
+typedef struct DebuginatorBinaryWriter {
+	unsigned char* buffer;
+	int capacity;
+	int size; // Keeps counting past capacity, so that it ends up as the needed size.
+	char path[DEBUGINATOR_MAX_PATH_LENGTH];
+	char previous_path[DEBUGINATOR_MAX_PATH_LENGTH];
+	int previous_path_length;
+} DebuginatorBinaryWriter;
+
+static void debuginator__binary_write(DebuginatorBinaryWriter* writer, const void* data, int size) {
+	if (writer->size + size <= writer->capacity) {
+		DEBUGINATOR_memcpy(writer->buffer + writer->size, data, (unsigned int)size);
+	}
+	writer->size += size;
+}
+
+static void debuginator__binary_write_varint(DebuginatorBinaryWriter* writer, unsigned int value) {
+	unsigned char bytes[5];
+	int num_bytes = 0;
+	do {
+		bytes[num_bytes] = (unsigned char)(value & 0x7f);
+		value >>= 7;
+		bytes[num_bytes] |= value != 0 ? 0x80 : 0;
+		num_bytes++;
+	} while (value != 0);
+	debuginator__binary_write(writer, bytes, num_bytes);
+}
+
+static void debuginator__binary_write_string(DebuginatorBinaryWriter* writer, const char* string) {
+	debuginator__binary_write(writer, string, (int)DEBUGINATOR_strlen(string) + 1);
+}
+
+static void debuginator__binary_write_path(DebuginatorBinaryWriter* writer, DebuginatorBinaryRecordType type, int path_length) {
+	int shared_length = 0;
+	while (shared_length < path_length && shared_length < writer->previous_path_length && writer->path[shared_length] == writer->previous_path[shared_length]) {
+		shared_length++;
+	}
+
+	unsigned char type_byte = (unsigned char)type;
+	debuginator__binary_write(writer, &type_byte, 1);
+	debuginator__binary_write_varint(writer, (unsigned int)shared_length);
+	debuginator__binary_write_varint(writer, (unsigned int)(path_length - shared_length));
+	debuginator__binary_write(writer, writer->path + shared_length, path_length - shared_length);
+
+	DEBUGINATOR_memcpy(writer->previous_path + shared_length, writer->path + shared_length, (unsigned int)(path_length - shared_length));
+	writer->previous_path_length = path_length;
+}
+
+// Recursion depth is bounded by DEBUGINATOR_MAX_HIERARCHY_SIZE. writer->path holds the folder's path, with a trailing slash.
+static void debuginator__save_binary_folder(struct TheDebuginator* debuginator, DebuginatorBinaryWriter* writer, DebuginatorItem* folder, int path_length) {
+	for (DebuginatorItem* item = folder->folder.first_child; item != NULL; item = item->next_sibling) {
+		int title_length = (int)DEBUGINATOR_strlen(item->title);
+		if (path_length + title_length + 1 >= DEBUGINATOR_MAX_PATH_LENGTH) {
+			// Can't have been created with a path this long, so it couldn't be loaded either.
+			continue;
+		}
+
+		DEBUGINATOR_memcpy(writer->path + path_length, item->title, (unsigned int)title_length);
+		int item_path_length = path_length + title_length;
+
+		if (item->is_folder) {
+			if (item->folder.first_child == NULL) {
+				continue;
+			}
+
+			if (item->folder.is_collapsed) {
+				debuginator__binary_write_path(writer, DEBUGINATOR_BinaryRecordCollapsed, item_path_length);
+			}
+
+			writer->path[item_path_length] = '/';
+			debuginator__save_binary_folder(debuginator, writer, item, item_path_length + 1);
+			continue;
+		}
+
+		if (item->leaf.active_index != item->leaf.default_index && !debuginator->edit_types[(int)item->leaf.edit_type].forget_state) {
+			debuginator__binary_write_path(writer, DEBUGINATOR_BinaryRecordValue, item_path_length);
+			debuginator__binary_write_varint(writer, (unsigned int)item->leaf.active_index);
+			debuginator__binary_write_string(writer, item->leaf.value_titles[item->leaf.active_index]);
+		}
+
+		if (item->leaf.hot_key_index != DEBUGINATOR_NO_HOT_INDEX) {
+			int hot_key_value_index = debuginator->hot_keys[item->leaf.hot_key_index].value_index;
+			debuginator__binary_write_path(writer, DEBUGINATOR_BinaryRecordHotKey, item_path_length);
+			debuginator__binary_write_string(writer, debuginator->hot_keys[item->leaf.hot_key_index].key);
+			debuginator__binary_write_varint(writer, (unsigned int)(hot_key_value_index + 1));
+			debuginator__binary_write_string(writer, hot_key_value_index == DEBUGINATOR_NO_HOT_INDEX ? "" : item->leaf.value_titles[hot_key_value_index]);
+		}
+	}
+}
+
+bool debuginator_save_binary(struct TheDebuginator* debuginator, void* buffer, int capacity, int* needed) {
+	DEBUGINATOR_assert(buffer != NULL || capacity == 0);
+	DEBUGINATOR_PROFILE_BEGIN(debuginator, DEBUGINATOR_ProfileSave);
+	DebuginatorBinaryWriter writer;
+	writer.buffer = (unsigned char*)buffer;
+	writer.capacity = capacity;
+	writer.size = 0;
+	writer.previous_path_length = 0;
+
+	unsigned char header[DEBUGINATOR_BINARY_HEADER_SIZE] = { DEBUGINATOR_BINARY_MAGIC[0], DEBUGINATOR_BINARY_MAGIC[1], DEBUGINATOR_BINARY_MAGIC[2], DEBUGINATOR_BINARY_MAGIC[3], DEBUGINATOR_BINARY_VERSION };
+	debuginator__binary_write(&writer, header, DEBUGINATOR_BINARY_HEADER_SIZE);
+	debuginator__save_binary_folder(debuginator, &writer, debuginator->root, 0);
+
+	if (needed != NULL) {
+		*needed = writer.size;
+	}
+
+	DEBUGINATOR_PROFILE_END(debuginator, DEBUGINATOR_ProfileSave);
+	return writer.size <= capacity;
+}
+
+typedef struct DebuginatorBinaryReader {
+	const unsigned char* data;
+	int size;
+	int offset;
+	bool failed;
+} DebuginatorBinaryReader;
+
+static unsigned int debuginator__binary_read_varint(DebuginatorBinaryReader* reader) {
+	unsigned int value = 0;
+	for (int shift = 0; shift < 32; shift += 7) {
+		if (reader->offset == reader->size) {
+			break;
+		}
+
+		unsigned char byte = reader->data[reader->offset++];
+		value |= (unsigned int)(byte & 0x7f) << shift;
+		if ((byte & 0x80) == 0) {
+			return value;
+		}
+	}
+
+	reader->failed = true;
+	return 0;
+}
+
+static const char* debuginator__binary_read_string(DebuginatorBinaryReader* reader) {
+	const char* string = (const char*)reader->data + reader->offset;
+	while (reader->offset < reader->size) {
+		if (reader->data[reader->offset++] == '\0') {
+			return string;
+		}
+	}
+
+	reader->failed = true;
+	return "";
+}
+
+static bool debuginator__load_binary(struct TheDebuginator* debuginator, const void* buffer, int size) {
+	DebuginatorBinaryReader reader;
+	reader.data = (const unsigned char*)buffer;
+	reader.size = size;
+	reader.offset = DEBUGINATOR_BINARY_HEADER_SIZE;
+	reader.failed = false;
+
+	if (size < DEBUGINATOR_BINARY_HEADER_SIZE || DEBUGINATOR_memcmp(buffer, DEBUGINATOR_BINARY_MAGIC, 4) != 0 || reader.data[4] != DEBUGINATOR_BINARY_VERSION) {
+		return false;
+	}
+
+	debuginator__mark_dirty(debuginator);
+
+	// The paths in a save are unique, so only the settings that were there before need to be searched for duplicates.
+	int num_settings_before = debuginator->num_loaded_settings;
+
+	// Records come in tree order, so consecutive ones usually share a parent and we only need to look among its children.
+	char path[DEBUGINATOR_MAX_PATH_LENGTH];
+	int path_length = 0;
+	DebuginatorItem* parent = debuginator->root;
+	int parent_path_length = 0;
+
+	while (reader.offset < reader.size && !reader.failed) {
+		DebuginatorBinaryRecordType type = (DebuginatorBinaryRecordType)reader.data[reader.offset++];
+		unsigned int shared_length = debuginator__binary_read_varint(&reader);
+		unsigned int suffix_length = debuginator__binary_read_varint(&reader);
+		if (reader.failed || shared_length > (unsigned int)path_length || suffix_length >= DEBUGINATOR_MAX_PATH_LENGTH - shared_length || suffix_length > (unsigned int)(reader.size - reader.offset)) {
+			return false;
+		}
+
+		DEBUGINATOR_memcpy(path + shared_length, reader.data + reader.offset, suffix_length);
+		reader.offset += (int)suffix_length;
+		path_length = (int)(shared_length + suffix_length);
+		path[path_length] = '\0';
+
+		int title_start = path_length;
+		while (title_start > 0 && path[title_start - 1] != '/') {
+			--title_start;
+		}
+
+		if (title_start != parent_path_length || (int)shared_length < title_start) {
+			parent = debuginator->root;
+			if (title_start > 0) {
+				path[title_start - 1] = '\0';
+				parent = debuginator_get_item(debuginator, NULL, path, NULL);
+				path[title_start - 1] = '/';
+			}
+
+			parent_path_length = title_start;
+		}
+
+		DebuginatorItem* item = parent != NULL && parent->is_folder ? debuginator_get_item(debuginator, parent, path + title_start, NULL) : NULL;
+		switch (type) {
+			case DEBUGINATOR_BinaryRecordValue: {
+				int value_index = (int)debuginator__binary_read_varint(&reader);
+				const char* value_title = debuginator__binary_read_string(&reader);
+				if (!reader.failed) {
+					debuginator__store_item_setting(debuginator, path, value_title, num_settings_before);
+					debuginator__apply_item_setting(debuginator, item, value_title, value_index);
 				}
+			} break;
+			case DEBUGINATOR_BinaryRecordCollapsed:
+				debuginator__store_item_setting(debuginator, path, DEBUGINATOR_FOLDER_COLLAPSED_STRING, num_settings_before);
+				debuginator__apply_item_setting(debuginator, item, DEBUGINATOR_FOLDER_COLLAPSED_STRING, DEBUGINATOR_NO_HOT_INDEX);
 				break;
-			}
+			case DEBUGINATOR_BinaryRecordHotKey: {
+				const char* hot_key_key = debuginator__binary_read_string(&reader);
+				int hot_key_value_index = (int)debuginator__binary_read_varint(&reader) - 1;
+				const char* hot_key_value_title = debuginator__binary_read_string(&reader);
+				if (reader.failed) {
+					break;
+				}
+
+				// Stored the same way as debuginator_save's keys, so that they're picked up when the item is (re)created.
+				char hot_path[DEBUGINATOR_MAX_PATH_LENGTH + 16];
+				DEBUGINATOR_sprintf_s(hot_path, sizeof(hot_path), "%s__HotKey_Key", path);
+				debuginator__store_item_setting(debuginator, hot_path, hot_key_key, num_settings_before);
+				DEBUGINATOR_sprintf_s(hot_path, sizeof(hot_path), "%s__HotKey_Value", path);
+				debuginator__store_item_setting(debuginator, hot_path, hot_key_value_title, num_settings_before);
+
+				if (item != NULL && !item->is_folder && item->leaf.hot_key_index == DEBUGINATOR_NO_HOT_INDEX) {
+					bool has_value = hot_key_value_index != DEBUGINATOR_NO_HOT_INDEX;
+					debuginator_assign_hot_key(debuginator, hot_key_key, path, has_value ? hot_key_value_index : DEBUGINATOR_NO_HOT_INDEX, has_value ? hot_key_value_title : NULL);
+				}
+			} break;
+			default:
+				return false;
 		}
 	}
+
+	return !reader.failed;
+}
+
+bool debuginator_load_binary(struct TheDebuginator* debuginator, const void* buffer, int size) {
+	DEBUGINATOR_PROFILE_BEGIN(debuginator, DEBUGINATOR_ProfileLoad);
+	bool loaded = debuginator__load_binary(debuginator, buffer, size);
+	DEBUGINATOR_PROFILE_END(debuginator, DEBUGINATOR_ProfileLoad);
+	return loaded;
 }
 
 DebuginatorItem* debuginator_get_hot_item(struct TheDebuginator* debuginator, int* out_hot_item_index) {
@@ -2018,6 +3460,7 @@ DebuginatorItem* debuginator_get_hot_item(struct TheDebuginator* debuginator, in
 }
 
 void debuginator_set_hot_item(struct TheDebuginator* debuginator, DebuginatorItem* item) {
+	debuginator__mark_dirty(debuginator);
 	if (item == debuginator->root) {
 		return;
 	}
@@ -2027,6 +3470,7 @@ void debuginator_set_hot_item(struct TheDebuginator* debuginator, DebuginatorIte
 }
 
 void debuginator_set_default_value(struct TheDebuginator* debuginator, const char* path, const char* value_title, int value_index) {
+	debuginator__mark_dirty(debuginator);
 	DebuginatorItem* item = debuginator_get_item(debuginator, NULL, path, NULL);
 	if (item == NULL || item->is_folder) {
 		return;
@@ -2053,6 +3497,7 @@ void debuginator_modify_value(struct TheDebuginator* debuginator, DebuginatorIte
 }
 
 void debuginator_set_edit_type(struct TheDebuginator* debuginator, const char* path, DebuginatorItemEditorDataType edit_type) {
+	debuginator__mark_dirty(debuginator);
 	DebuginatorItem* item = debuginator_get_item(debuginator, NULL, path, NULL);
 	if (item == NULL) {
 		return;
@@ -2091,8 +3536,28 @@ void debuginator_item_set_user_data_by_path(struct TheDebuginator* debuginator,
 	item->user_data = user_data;
 }
 
+// What the item itself took, once nothing points to it anymore.
+static void debuginator__deallocate_item(struct TheDebuginator* debuginator, DebuginatorItem* item) {
+	if (item->is_folder && item->folder.height_index != NULL) {
+		debuginator__deallocate(debuginator, item->folder.height_index);
+	}
+
+	debuginator__deallocate(debuginator, item->title);
+	if (!item->is_folder) {
+		// Deallocate things in case The Debuginator owns these things.
+		debuginator__deallocate(debuginator, item->leaf.description);
+		for (int i = 0; i < item->leaf.num_values; ++i) {
+			debuginator__deallocate(debuginator, item->leaf.value_titles[i]);
+		}
+		debuginator__deallocate(debuginator, item->leaf.value_titles);
+	}
+
+	debuginator__deallocate(debuginator, item);
+}
+
 // Note: If you remove the last visible item, you must create a new one under the root.
 void debuginator_remove_item(struct TheDebuginator* debuginator, DebuginatorItem* item) {
+	debuginator__mark_dirty(debuginator);
 	if (item->is_folder) {
 		DebuginatorItem* child = item->folder.first_child;
 		while (child != NULL) {
@@ -2101,6 +3566,11 @@ void debuginator_remove_item(struct TheDebuginator* debuginator, DebuginatorItem
 		}
 	}
 
+	if (item->is_folder && item->folder.height_index != NULL) {
+		debuginator__deallocate(debuginator, item->folder.height_index);
+		item->folder.height_index = NULL;
+	}
+
 	if (item->prev_sibling) {
 		item->prev_sibling->next_sibling = item->next_sibling;
 	}
@@ -2109,6 +3579,7 @@ void debuginator_remove_item(struct TheDebuginator* debuginator, DebuginatorItem
 	}
 
 	DebuginatorItem* parent = item->parent;
+	debuginator__layout_changed(debuginator, parent);
 	if (parent->folder.hot_child == item) {
 		if (item->next_sibling != NULL) {
 			parent->folder.hot_child = item->next_sibling;
@@ -2129,27 +3600,39 @@ void debuginator_remove_item(struct TheDebuginator* debuginator, DebuginatorItem
 		debuginator->hot_item = debuginator__nearest_visible_item(item);
 	}
 
-	// Only update the height of the parent if we were visible
-	if (item->parent->is_folder && !item->parent->folder.is_collapsed) {
-		debuginator__set_total_height(item->parent, item->parent->total_height - item->total_height);
+	item->parent->folder.children_height -= item->total_height;
+	debuginator__invalidate_layout(debuginator, item->parent);
+	for (int i = 0; i < debuginator->wrap_cache_capacity; ++i) {
+		if (debuginator->wrap_cache[i].item == item) {
+			debuginator->wrap_cache[i].item = NULL;
+		}
+	}
+	if (item->is_layout_dirty) {
+		for (int i = 0; i < debuginator->layout_dirty_count; ++i) {
+			if (debuginator->layout_dirty_items[i] == item) {
+				debuginator->layout_dirty_items[i] = debuginator->layout_dirty_items[--debuginator->layout_dirty_count];
+				break;
+			}
+		}
+	}
+	if (item->is_callback_pending) {
+		// The rest keep their order.
+		DebuginatorCallbackBuffer* buffer = debuginator->callback_buffer;
+		int write = 0;
+		for (int read = 0; read < buffer->count; ++read) {
+			if (buffer->items[read] != item) {
+				buffer->items[write++] = buffer->items[read];
+			}
+		}
+		buffer->count = write;
 	}
 
 	if (!item->is_folder && !item->is_filtered) {
 		// If it's a folder we've already adjusted the parent's count when we removed the item's children above.
-		debuginator__adjust_num_visible_children(item->parent, -1);
-	}
-
-	debuginator__deallocate(debuginator, item->title);
-	if (!item->is_folder) {
-		// Deallocate things in case The Debuginator owns these things.
-		debuginator__deallocate(debuginator, item->leaf.description);
-		for (int i = 0; i < item->leaf.num_values; ++i) {
-			debuginator__deallocate(debuginator, item->leaf.value_titles[i]);
-		}
-		debuginator__deallocate(debuginator, item->leaf.value_titles);
+		debuginator__adjust_num_visible_children(debuginator, item->parent, -1);
 	}
 
-	debuginator__deallocate(debuginator, item);
+	debuginator__deallocate_item(debuginator, item);
 }
 
 void debuginator_remove_item_by_path(struct TheDebuginator* debuginator, const char* path) {
@@ -2161,34 +3644,78 @@ void debuginator_remove_item_by_path(struct TheDebuginator* debuginator, const c
 	debuginator_remove_item(debuginator, item);
 }
 
-static bool debuginator__distance_to_hot_item(DebuginatorItem* item, DebuginatorItem* hot_item, int item_height, int* distance) {
-	if (item == hot_item) {
-		if (!item->is_folder && item->leaf.is_expanded && !item->is_filtered) {
-			*distance += item_height * (item->leaf.hot_index + 1);
+// How far down from the root the item is drawn, or the height of the whole menu if it isn't
+// visible. Walks up the parents and adds up the heights of the visible items before it on each
+// level. Big folders have that in their height index, up to a stride before the item, so it's
+// about depth * stride steps no matter how many items there are.
+static int debuginator__distance_to_item_uncached(struct TheDebuginator* debuginator, DebuginatorItem* item) {
+	DebuginatorItem* root = debuginator->root;
+	if (item == root) {
+		return 0;
+	}
+
+	bool is_visible = item != NULL;
+	for (DebuginatorItem* ancestor = item; is_visible && ancestor != root; ancestor = ancestor->parent) {
+		if (ancestor->parent == NULL || ancestor->parent->folder.is_collapsed || !debuginator__is_visible(ancestor)) {
+			is_visible = false;
+			break;
 		}
-		return true;
 	}
 
-	*distance += item_height;
-	if (item->is_folder && !item->is_filtered) {
-		DebuginatorItem* child = debuginator__first_visible_child(item);
-		while (child) {
-			bool found = debuginator__distance_to_hot_item(child, hot_item, item_height, distance);
-			if (found) {
-				return true;
+	int distance = debuginator->item_height;
+	if (!is_visible) {
+		for (DebuginatorItem* child = debuginator__first_visible_child(root); child != NULL; child = debuginator__next_visible_sibling(child)) {
+			distance += child->total_height;
+		}
+		return distance;
+	}
+
+	for (DebuginatorItem* ancestor = item; ancestor != root; ancestor = ancestor->parent) {
+		DebuginatorHeightIndex* index = ancestor->parent->folder.height_index;
+		int offset = 0;
+		int entry = index != NULL && !index->is_dirty ? debuginator__find_height_index_entry(index, ancestor, &offset) : -1;
+		if (entry != -1) {
+			distance += index->entries[entry].y + offset;
+		}
+		else {
+			for (DebuginatorItem* sibling = debuginator__prev_visible_sibling(ancestor); sibling != NULL; sibling = debuginator__prev_visible_sibling(sibling)) {
+				distance += sibling->total_height;
 			}
+		}
 
-			child = debuginator__next_visible_sibling(child);
+		if (ancestor->parent != root) {
+			distance += debuginator->item_height;
 		}
 	}
-	else if (item->leaf.is_expanded && !item->is_filtered) {
-		*distance += item_height * item->leaf.num_values;
-		*distance += item->leaf.description_line_count * item_height;
+
+	return distance;
+}
+
+// Cached for the hot item, since scrolling needs it every frame.
+static int debuginator__distance_to_item(struct TheDebuginator* debuginator, DebuginatorItem* item) {
+	debuginator__update_layout(debuginator);
+	int distance;
+	if (item == debuginator->hot_item_distance_item && debuginator->layout_generation == debuginator->hot_item_distance_generation) {
+		distance = debuginator->hot_item_distance;
 	}
-	return false;
+	else {
+		distance = debuginator__distance_to_item_uncached(debuginator, item);
+		if (item == debuginator->hot_item) {
+			debuginator->hot_item_distance_item = item;
+			debuginator->hot_item_distance_generation = debuginator->layout_generation;
+			debuginator->hot_item_distance = distance;
+		}
+	}
+
+	// The hot value of an expanded item is further down.
+	if (item != NULL && item != debuginator->root && !item->is_folder && item->leaf.is_expanded && !item->is_filtered) {
+		distance += debuginator->item_height * (item->leaf.hot_index + 1);
+	}
+	return distance;
 }
 
 int debuginator_total_height(struct TheDebuginator* debuginator) {
+	debuginator__update_layout(debuginator);
 	return debuginator->root->total_height;
 }
 
@@ -2209,7 +3736,131 @@ void debuginator_set_filter(struct TheDebuginator* debuginator, const char* want
 	DEBUGINATOR_strcpy_s(debuginator->filter, sizeof(debuginator->filter), wanted_filter);
 }
 
+// Scores how well a filter matches the full path of an item, that is, the titles of its parents
+// and itself separated by spaces. Higher is better. Matching is done against path_lowercase, which
+// should be the same as path if the search is case sensitive. Word breaks are found using path.
+// This is the reference scorer that debuginator_update_filter uses for every leaf.
+static int debuginator__score_path(const char* path, const char* path_lowercase, int path_length, int title_start, const char* filter, bool exact_search, bool* out_is_filtered) {
+	bool taken_chars[DEBUGINATOR_MAX_PATH_LENGTH] = { 0 };
+	DEBUGINATOR_assert(path_length < (int)sizeof(taken_chars)); // Also indexed one past the end of a match.
+	int score = -1;
+	*out_is_filtered = false;
+
+	int filter_part = 0;
+	while (filter[filter_part] != '\0') {
+		if (filter[filter_part] == ' ') {
+			++filter_part;
+			continue;
+		}
+
+		int path_part = 0;
+		int matches[8] = { 0 };
+		int match_count = 0;
+		while (path_lowercase[path_part] != '\0') {
+			bool filter_part_found = false;
+			for (int path_i = path_part; path_i < path_length; path_i++) {
+				if (path_lowercase[path_i] == filter[filter_part] && taken_chars[path_i] == false) {
+					path_part = path_i;
+					filter_part_found = true;
+					break;
+				}
+			}
+
+			if (!filter_part_found) {
+				break;
+			}
+
+			int match_length = 0;
+			const char* filter_char = filter + (size_t)filter_part;
+			const char* path_char = path_lowercase + (size_t)path_part;
+			while (*filter_char++ == *path_char++) {
+				match_length++;
+				if (*filter_char == '\0' || *filter_char == ' ' || taken_chars[path_part + match_length] == true) {
+					break;
+				}
+			}
+
+			if (exact_search) {
+				if (filter[filter_part + match_length] != '\0' && filter[filter_part + match_length] != ' ') {
+					path_part += 1;
+					continue;
+				}
+			}
+
+			matches[match_count++] = path_part;
+			matches[match_count++] = match_length;
+			path_part += match_length;
+
+			if (match_count == 8) {
+				break;
+			}
+		}
+
+		int best_match_index = -1;
+		int best_match_score = 0;
+		for (int i = 0; i < match_count; i += 2) {
+			int match_index = matches[i];
+			int match_length = matches[i + 1];
+			int is_word_break_start = match_index == 0
+				|| path[match_index - 1] == ' '
+				|| (!DEBUGINATOR_isalpha(path[match_index - 1]) && DEBUGINATOR_isalpha(path[match_index]))
+				|| (!DEBUGINATOR_isdigit(path[match_index - 1]) && DEBUGINATOR_isdigit(path[match_index]))
+				|| (!DEBUGINATOR_isupper(path[match_index - 1]) && DEBUGINATOR_isupper(path[match_index]));
+			int is_word_break_end = match_index + match_length == path_length
+				|| path[match_index + match_length] == ' '
+				|| (!DEBUGINATOR_isalpha(path[match_index + match_length - 1]) && DEBUGINATOR_isalpha(path[match_index + match_length]))
+				|| (!DEBUGINATOR_isdigit(path[match_index + match_length - 1]) && DEBUGINATOR_isdigit(path[match_index + match_length]))
+				|| (!DEBUGINATOR_isupper(path[match_index + match_length - 1]) && DEBUGINATOR_isupper(path[match_index + match_length]));
+			int is_match_in_item_title = match_index >= title_start;
+			int path_segment_length = path_length - title_start;
+			int path_segment_modifier = 0;
+			while (path_segment_length >>= 1) {
+				++path_segment_modifier;
+			}
+
+			// The goal here is to severely punish matching in the middle of words, especially for short matches.
+			// For example, we don't want to get "detail" as a filter result to "AI", as it just clutters the
+			// result list.
+			// However, we do want to be able to type "pick" and match "Colorpicker", and there is no practical
+			// way to detect that there is a word boundary between "Color" and "picker".
+			// So we give a score of zero to filters that don't align with the start or end of a word, except
+			// when the match is long enough (3+), in which case, we add anything that matches that too.
+			int score_word_start = is_word_break_start * DEBUGINATOR_SCORE_WORD_BREAK_START;
+			int score_word_break_end = is_word_break_end * DEBUGINATOR_SCORE_WORD_BREAK_END;
+			int score_match_in_item_title = is_match_in_item_title * DEBUGINATOR_SCORE_ITEM_TITLE_MATCH;
+			int score_match_length = match_length * match_length;
+			int score_match_length_fallback = match_length < 3 ? 0 : match_length * match_length;
+			int match_score =
+						(score_word_start + score_word_break_end)
+						* (score_match_length + score_match_in_item_title)
+						+ score_match_length_fallback
+						- path_segment_modifier;
+
+			if (match_score > best_match_score) {
+				best_match_score = match_score;
+				best_match_index = i;
+			}
+		}
+
+		if (best_match_index == -1) {
+			*out_is_filtered = true;
+			return -1; // Filter not valid
+		}
+		else {
+			filter_part += matches[best_match_index + 1];
+			score += best_match_score;
+			for (int match_i = 0; match_i < matches[best_match_index + 1]; match_i++) {
+				taken_chars[matches[best_match_index] + match_i] = true;
+			}
+		}
+	}
+
+	return score;
+}
+
 void debuginator_update_filter(struct TheDebuginator* debuginator, const char* wanted_filter) {
+	DEBUGINATOR_PROFILE_BEGIN(debuginator, DEBUGINATOR_ProfileUpdateFilter);
+	debuginator__mark_dirty(debuginator);
 	// See this for a description of how the fuzzy filtering works.
 	// https://medium.com/@Srekel/implementing-a-fuzzy-search-algorithm-for-the-debuginator-cacc349e6c55
 
@@ -2255,6 +3906,7 @@ void debuginator_update_filter(struct TheDebuginator* debuginator, const char* w
 
 	char current_full_path[DEBUGINATOR_MAX_PATH_LENGTH] = { 0 };
 	char current_full_path_lowercase[DEBUGINATOR_MAX_PATH_LENGTH] = { 0 };
+	DEBUGINATOR_static_assert(sizeof(current_full_path) == DEBUGINATOR_MAX_PATH_LENGTH); // Same size as debuginator__score_path's taken_chars.
 	size_t path_indices[DEBUGINATOR_MAX_HIERARCHY_SIZE] = { 0 };
 	int current_path_index = 0;
 
@@ -2273,150 +3925,38 @@ void debuginator_update_filter(struct TheDebuginator* debuginator, const char* w
 				path_indices[current_path_index+1] = path_indices[current_path_index] + (size_t)DEBUGINATOR_strlen(item->title);
 				current_full_path[path_indices[current_path_index + 1]] = ' ';
 				current_full_path_lowercase[path_indices[current_path_index + 1]] = ' ';
-				path_indices[current_path_index + 1]++;
-				DEBUGINATOR_assert(path_indices[current_path_index + 1] < sizeof(current_full_path));
-
-				if (!case_sensitive) {
-					for (size_t i = path_indices[current_path_index]; i < path_indices[current_path_index + 1]; i++) {
-						current_full_path_lowercase[i] = (char)DEBUGINATOR_tolower(current_full_path_lowercase[i]);
-					}
-				}
-
-				++current_path_index;
-				DEBUGINATOR_assert(current_path_index + 1 < sizeof(path_indices) / sizeof(path_indices[0]));
-				item = item->folder.first_child;
-
-				continue;
-			}
-		}
-		else {
-			bool taken_chars[DEBUGINATOR_MAX_PATH_LENGTH] = { 0 };
-			DEBUGINATOR_static_assert(sizeof(taken_chars) == sizeof(current_full_path));
-			DEBUGINATOR_strcpy_s(current_full_path + path_indices[current_path_index], sizeof(current_full_path) - path_indices[current_path_index], item->title);
-			DEBUGINATOR_strcpy_s(current_full_path_lowercase + path_indices[current_path_index], sizeof(current_full_path) - path_indices[current_path_index], item->title);
-			path_indices[current_path_index + 1] = path_indices[current_path_index] + (int)DEBUGINATOR_strlen(item->title);
-			DEBUGINATOR_assert(path_indices[current_path_index + 1] < sizeof(current_full_path));
-			int current_path_length = path_indices[current_path_index + 1];
-
-			if (!case_sensitive) {
-				for (int i = path_indices[current_path_index]; i < current_path_length; i++) {
-					current_full_path_lowercase[i] = (char)DEBUGINATOR_tolower(current_full_path_lowercase[i]);
-				}
-			}
-
-			int score = -1;
-			bool is_filtered = false;
-
-			int filter_part = 0;
-			while (filter[filter_part] != '\0') {
-				if (filter[filter_part] == ' ') {
-					++filter_part;
-					continue;
-				}
-
-				int path_part = 0;
-				int matches[8] = { 0 };
-				int match_count = 0;
-				while (current_full_path_lowercase[path_part] != '\0') {
-					bool filter_part_found = false;
-					for (int path_i = path_part; path_i < current_path_length; path_i++) {
-						if (current_full_path_lowercase[path_i] == filter[filter_part] && taken_chars[path_i] == false) {
-							path_part = path_i;
-							filter_part_found = true;
-							break;
-						}
-					}
-
-					if (!filter_part_found) {
-						break;
-					}
-
-					int match_length = 0;
-					const char* filter_char = filter + (size_t)filter_part;
-					const char* path_char = current_full_path_lowercase + (size_t)path_part;
-					while (*filter_char++ == *path_char++) {
-						match_length++;
-						if (*filter_char == '\0' || *filter_char == ' ' || taken_chars[path_part + match_length] == true) {
-							break;
-						}
-					}
-
-					if (exact_search) {
-						if (filter[filter_part + match_length] != '\0' && filter[filter_part + match_length] != ' ') {
-							path_part += 1;
-							continue;
-						}
-					}
-
-					matches[match_count++] = path_part;
-					matches[match_count++] = match_length;
-					path_part += match_length;
+				path_indices[current_path_index + 1]++;
+				DEBUGINATOR_assert(path_indices[current_path_index + 1] < sizeof(current_full_path));
 
-					if (match_count == 8) {
-						break;
+				if (!case_sensitive) {
+					for (size_t i = path_indices[current_path_index]; i < path_indices[current_path_index + 1]; i++) {
+						current_full_path_lowercase[i] = (char)DEBUGINATOR_tolower(current_full_path_lowercase[i]);
 					}
 				}
 
-				int best_match_index = -1;
-				int best_match_score = 0;
-				for (int i = 0; i < match_count; i += 2) {
-					int match_index = matches[i];
-					int match_length = matches[i + 1];
-					int is_word_break_start = match_index == 0
-						|| current_full_path[match_index - 1] == ' '
-						|| (!DEBUGINATOR_isalpha(current_full_path[match_index - 1]) && DEBUGINATOR_isalpha(current_full_path[match_index]))
-						|| (!DEBUGINATOR_isdigit(current_full_path[match_index - 1]) && DEBUGINATOR_isdigit(current_full_path[match_index]))
-						|| (!DEBUGINATOR_isupper(current_full_path[match_index - 1]) && DEBUGINATOR_isupper(current_full_path[match_index]));
-					int is_word_break_end = match_index + match_length == current_path_length
-						|| current_full_path[match_index + match_length] == ' '
-						|| (!DEBUGINATOR_isalpha(current_full_path[match_index + match_length - 1]) && DEBUGINATOR_isalpha(current_full_path[match_index + match_length]))
-						|| (!DEBUGINATOR_isdigit(current_full_path[match_index + match_length - 1]) && DEBUGINATOR_isdigit(current_full_path[match_index + match_length]))
-						|| (!DEBUGINATOR_isupper(current_full_path[match_index + match_length - 1]) && DEBUGINATOR_isupper(current_full_path[match_index + match_length]));
-					int is_match_in_item_title = match_index >= path_indices[current_path_index];
-					int path_segment_length = path_indices[current_path_index + 1] - path_indices[current_path_index];
-					int path_segment_modifier = 0;
-					while (path_segment_length >>= 1) {
-						++path_segment_modifier;
-					}
+				++current_path_index;
+				DEBUGINATOR_assert(current_path_index + 1 < sizeof(path_indices) / sizeof(path_indices[0]));
+				item = item->folder.first_child;
 
-					// The goal here is to severely punish matching in the middle of words, especially for short matches.
-					// For example, we don't want to get "detail" as a filter result to "AI", as it just clutters the
-					// result list.
-					// However, we do want to be able to type "pick" and match "Colorpicker", and there is no practical
-					// way to detect that there is a word boundary between "Color" and "picker".
-					// So we give a score of zero to filters that don't align with the start or end of a word, except
-					// when the match is long enough (3+), in which case, we add anything that matches that too.
-					int score_word_start = is_word_break_start * DEBUGINATOR_SCORE_WORD_BREAK_START;
-					int score_word_break_end = is_word_break_end * DEBUGINATOR_SCORE_WORD_BREAK_END;
-					int score_match_in_item_title = is_match_in_item_title * DEBUGINATOR_SCORE_ITEM_TITLE_MATCH;
-					int score_match_length = match_length * match_length;
-					int score_match_length_fallback = match_length < 3 ? 0 : match_length * match_length;
-					int match_score =
-								(score_word_start + score_word_break_end)
-								* (score_match_length + score_match_in_item_title)
-								+ score_match_length_fallback
-								- path_segment_modifier;
-
-					if (match_score > best_match_score) {
-						best_match_score = match_score;
-						best_match_index = i;
-					}
-				}
+				continue;
+			}
+		}
+		else {
+			DEBUGINATOR_strcpy_s(current_full_path + path_indices[current_path_index], sizeof(current_full_path) - path_indices[current_path_index], item->title);
+			DEBUGINATOR_strcpy_s(current_full_path_lowercase + path_indices[current_path_index], sizeof(current_full_path) - path_indices[current_path_index], item->title);
+			path_indices[current_path_index + 1] = path_indices[current_path_index] + (int)DEBUGINATOR_strlen(item->title);
+			DEBUGINATOR_assert(path_indices[current_path_index + 1] < sizeof(current_full_path));
+			int current_path_length = path_indices[current_path_index + 1];
 
-				if (best_match_index == -1) {
-					is_filtered = true;
-					score = -1;
-					break; // Filter not valid
-				}
-				else {
-					filter_part += matches[best_match_index + 1];
-					score += best_match_score;
-					for (int match_i = 0; match_i < matches[best_match_index + 1]; match_i++) {
-						taken_chars[matches[best_match_index] + match_i] = true;
-					}
+			if (!case_sensitive) {
+				for (int i = path_indices[current_path_index]; i < current_path_length; i++) {
+					current_full_path_lowercase[i] = (char)DEBUGINATOR_tolower(current_full_path_lowercase[i]);
 				}
 			}
 
+			bool is_filtered;
+			int score = debuginator__score_path(current_full_path, current_full_path_lowercase, current_path_length, (int)path_indices[current_path_index], filter, exact_search, &is_filtered);
+
 			// Ignore items in collapsed folders.
 			// TODO: Make smarter.
 			DebuginatorItem* parent = item->parent;
@@ -2434,13 +3974,13 @@ void debuginator_update_filter(struct TheDebuginator* debuginator, const char* w
 			}
 
 			if (is_filtered && !item->is_filtered) {
-				debuginator__set_total_height(item, 0);
-				debuginator__adjust_num_visible_children(item->parent, -1);
+				debuginator__invalidate_layout(debuginator, item);
+				debuginator__adjust_num_visible_children(debuginator, item->parent, -1);
 				item->leaf.is_expanded = false;
 			}
 			else if (!is_filtered && item->is_filtered) {
-				debuginator__set_total_height(item, debuginator->item_height); //Hacky
-				debuginator__adjust_num_visible_children(item->parent, 1);
+				debuginator__invalidate_layout(debuginator, item);
+				debuginator__adjust_num_visible_children(debuginator, item->parent, 1);
 			}
 
 			item->is_filtered = is_filtered;
@@ -2557,15 +4097,13 @@ void debuginator_update_filter(struct TheDebuginator* debuginator, const char* w
 		fallback->parent->folder.hot_child = fallback;
 	}
 
-	debuginator__set_item_total_height_recursively(debuginator->root, debuginator->item_height);
-
-	int distance_from_root_to_hot_item = 0;
-	debuginator__distance_to_hot_item(debuginator->root, debuginator->hot_item, debuginator->item_height, &distance_from_root_to_hot_item);
+	int distance_from_root_to_hot_item = debuginator__distance_to_item(debuginator, debuginator->hot_item);
 	float wanted_y = DEBUGINATOR_FILTER_HEIGHT + debuginator->size.y * debuginator->focus_height + (float)debuginator->scroll_current;
 	float distance_to_wanted_y = wanted_y - distance_from_root_to_hot_item;
 	debuginator->current_height_offset = distance_to_wanted_y;
 
 	DEBUGINATOR_strcpy_s(debuginator->filter, sizeof(debuginator->filter), filter);
+	DEBUGINATOR_PROFILE_END(debuginator, DEBUGINATOR_ProfileUpdateFilter);
 }
 
 void debuginator_apply_scroll(struct TheDebuginator* debuginator, int distance) {
@@ -2575,8 +4113,7 @@ void debuginator_apply_scroll(struct TheDebuginator* debuginator, int distance)
 	debuginator->scroll_wanted += distance;
 
 	// Make sure we don't scroll too far away from the menu's content.
-	int distance_from_root_to_hot_item = 0;
-	debuginator__distance_to_hot_item(debuginator->root, debuginator->hot_item, debuginator->item_height, &distance_from_root_to_hot_item);
+	int distance_from_root_to_hot_item = debuginator__distance_to_item(debuginator, debuginator->hot_item);
 	int max_offset = (int)(debuginator->size.y / 2);
 	debuginator->scroll_wanted = DEBUGINATOR_min(debuginator->scroll_wanted, max_offset + distance_from_root_to_hot_item);
 	debuginator->scroll_wanted = DEBUGINATOR_max(debuginator->scroll_wanted, -debuginator->root->total_height + distance_from_root_to_hot_item + max_offset);
@@ -2619,8 +4156,7 @@ void debuginator_activate_item_at_mouse_cursor(struct TheDebuginator* debuginato
 		return;
 	}
 
-	int distance_from_root_to_hot_item_before = 0;
-	debuginator__distance_to_hot_item(debuginator->root, debuginator->hot_item, debuginator->item_height, &distance_from_root_to_hot_item_before);
+	int distance_from_root_to_hot_item_before = debuginator__distance_to_item(debuginator, debuginator->hot_item);
 
 	if (hot_item->is_folder) {
 		debuginator->hot_item = hot_item;
@@ -2648,8 +4184,7 @@ void debuginator_activate_item_at_mouse_cursor(struct TheDebuginator* debuginato
 		debuginator_activate(debuginator, hot_item, true);
 	}
 
-	int distance_from_root_to_hot_item_after = 0;
-	debuginator__distance_to_hot_item(debuginator->root, debuginator->hot_item, debuginator->item_height, &distance_from_root_to_hot_item_after);
+	int distance_from_root_to_hot_item_after = debuginator__distance_to_item(debuginator, debuginator->hot_item);
 
 	debuginator->scroll_wanted += (distance_from_root_to_hot_item_after - distance_from_root_to_hot_item_before);
 	debuginator->scroll_current = debuginator->scroll_wanted;
@@ -2665,12 +4200,11 @@ void debuginator_expand_item_at_mouse_cursor(struct TheDebuginator* debuginator,
 		return;
 	}
 
-	int distance_from_root_to_hot_item_before = 0;
-	debuginator__distance_to_hot_item(debuginator->root, debuginator->hot_item, debuginator->item_height, &distance_from_root_to_hot_item_before);
+	int distance_from_root_to_hot_item_before = debuginator__distance_to_item(debuginator, debuginator->hot_item);
 
 	if (!debuginator->hot_item->is_folder && debuginator->hot_item != hot_item) {
 		debuginator->hot_item->leaf.is_expanded = false;
-		debuginator__set_total_height(debuginator->hot_item, debuginator->item_height);
+		debuginator__invalidate_layout(debuginator, debuginator->hot_item);
 	}
 
 	debuginator->hot_item = hot_item;
@@ -2683,16 +4217,10 @@ void debuginator_expand_item_at_mouse_cursor(struct TheDebuginator* debuginator,
 		bool do_expand = expand == DEBUGINATOR_Toggle ? !hot_item->leaf.is_expanded : (bool)(expand != DEBUGINATOR_Collapse);
 		PLAYSOUND((!do_expand) ? DEBUGINATOR_SoundEventCollapse : DEBUGINATOR_SoundEventExpand);
 		hot_item->leaf.is_expanded = do_expand;
-		if (do_expand) {
-			debuginator__set_total_height(hot_item, debuginator->item_height * (hot_item->leaf.num_values + hot_item->leaf.description_line_count));
-		}
-		else {
-			debuginator__set_total_height(hot_item, debuginator->item_height);
-		}
+		debuginator__invalidate_layout(debuginator, hot_item);
 	}
 
-	int distance_from_root_to_hot_item_after = 0;
-	debuginator__distance_to_hot_item(debuginator->root, debuginator->hot_item, debuginator->item_height, &distance_from_root_to_hot_item_after);
+	int distance_from_root_to_hot_item_after = debuginator__distance_to_item(debuginator, debuginator->hot_item);
 
 	debuginator->scroll_wanted += (distance_from_root_to_hot_item_after - distance_from_root_to_hot_item_before);
 	debuginator->scroll_current = debuginator->scroll_wanted;
@@ -2706,6 +4234,45 @@ DebuginatorItem* debuginator_get_item_at_mouse_cursor(struct TheDebuginator* deb
 	return debuginator->hot_mouse_item;
 }
 
+DebuginatorItem* debuginator_get_item_at_y(struct TheDebuginator* debuginator, float y, int* out_value_index) {
+	debuginator__update_layout(debuginator);
+	if (out_value_index != NULL) {
+		*out_value_index = DEBUGINATOR_NO_HOT_INDEX;
+	}
+
+	// Same as drawing, starting from where the root's children are drawn.
+	float offset = debuginator->current_height_offset;
+	DebuginatorItem* folder = debuginator->root;
+	while (true) {
+		DebuginatorItem* child = debuginator__skip_children_above(folder, &offset, y);
+		while (child != NULL && offset + child->total_height <= y) {
+			offset += child->total_height;
+			child = debuginator__next_visible_sibling(child);
+		}
+
+		if (child == NULL || y < offset) {
+			return NULL;
+		}
+
+		int row = (int)((y - offset) / debuginator->item_height);
+		if (child->is_folder) {
+			if (row == 0) {
+				return child;
+			}
+
+			offset += debuginator->item_height;
+			folder = child;
+			continue;
+		}
+
+		int value_index = row - 1 - DEBUGINATOR_max(0, child->leaf.description_line_count);
+		if (out_value_index != NULL && child->leaf.is_expanded && value_index >= 0 && value_index < child->leaf.num_values) {
+			*out_value_index = value_index;
+		}
+		return child;
+	}
+}
+
 bool debuginator_is_mouse_over(struct TheDebuginator* debuginator, bool* out_over_quick_draw_area) {
 	if (debuginator->openness == 0) {
 		return false;
@@ -2724,6 +4291,7 @@ bool debuginator_is_mouse_over(struct TheDebuginator* debuginator, bool* out_ove
 }
 
 void debuginator_assign_hot_key(struct TheDebuginator* debuginator, const char* _key, const char* path, int value_index, const char* optional_value_title) {
+	debuginator__mark_dirty(debuginator);
 #if DEBUGINATOR_DO_HOT_KEY_UPPERCASING
 	char key[128] = {0};
 	DEBUGINATOR_strcpy_s(key, 128, _key);
@@ -2764,6 +4332,7 @@ void debuginator_assign_hot_key(struct TheDebuginator* debuginator, const char*
 }
 
 void debuginator_unassign_hot_key(struct TheDebuginator* debuginator, const char* _key) {
+	debuginator__mark_dirty(debuginator);
 #if DEBUGINATOR_DO_HOT_KEY_UPPERCASING
 	char key[128] = { 0 };
 	DEBUGINATOR_strcpy_s(key, 128, _key);
@@ -2858,6 +4427,7 @@ bool debuginator_activate_hot_key(struct TheDebuginator* debuginator, const char
 }
 
 void debuginator_clear_hot_keys(struct TheDebuginator* debuginator) {
+	debuginator__mark_dirty(debuginator);
 	for (int i = 0; i < debuginator->num_hot_keys; ++i) {
 		DebuginatorItem* item = debuginator_get_item(debuginator, NULL, debuginator->hot_keys[i].path, NULL);
 		if (item != NULL) {
@@ -2917,16 +4487,20 @@ DebuginatorItem* debuginator_get_hot_key_assigned_path(struct TheDebuginator* de
 
 void debuginator_set_item_height(struct TheDebuginator* debuginator, int item_height) {
 	debuginator->item_height = item_height;
-	debuginator__set_item_total_height_recursively(debuginator->root, item_height);
+	debuginator->layout_full_rebuild = true;
 
-	int distance_from_root_to_hot_item = 0;
-	debuginator__distance_to_hot_item(debuginator->root, debuginator->hot_item, debuginator->item_height, &distance_from_root_to_hot_item);
+	int distance_from_root_to_hot_item = debuginator__distance_to_item(debuginator, debuginator->hot_item);
 	float wanted_y = debuginator->size.y * debuginator->focus_height;
 	float distance_to_wanted_y = wanted_y - distance_from_root_to_hot_item;
 	debuginator->current_height_offset = distance_to_wanted_y;
 }
 
 void debuginator_set_size(struct TheDebuginator* debuginator, int width, int height) {
+	if (debuginator->size.x != (float)width) {
+		// Descriptions wrap differently.
+		debuginator->layout_full_rebuild = true;
+	}
+
 	debuginator->size.x = (float)width;
 	debuginator->size.y = (float)height;
 }
@@ -2936,6 +4510,12 @@ void debuginator_set_screen_resolution(struct TheDebuginator* debuginator, int w
 	debuginator->screen_resolution.y = (float)height;
 }
 
+void debuginator_invalidate_text_cache(struct TheDebuginator* debuginator) {
+	debuginator__mark_dirty(debuginator);
+	++debuginator->text_cache_generation;
+	debuginator->layout_full_rebuild = true;
+}
+
 void debuginator_set_left_aligned(struct TheDebuginator* debuginator, bool left_aligned) {
 	debuginator->open_direction = left_aligned ? 1 : -1;
 }
@@ -3095,6 +4675,7 @@ void debuginator_get_default_config(TheDebuginatorConfig* config) {
 	config->edit_types[DEBUGINATOR_EditTypeNumberRange].expanded_draw = debuginator__expanded_draw_numberrange;
 	config->edit_types[DEBUGINATOR_EditTypeNumberRange].modify_value = debuginator__modify_value_numberrange;
 	// config->edit_types[DEBUGINATOR_EditTypeNumberRange].activate = debuginator__activate_numberrange;
+	config->edit_types[DEBUGINATOR_EditTypeProfiler].quick_draw = debuginator__quick_draw_profiler;
 }
 
 void debuginator_reset_items_recursively(struct TheDebuginator* debuginator, DebuginatorItem* item) {
@@ -3128,8 +4709,8 @@ static void debuginator_reset_all_items(DebuginatorItem* item, void* value, cons
 }
 
 void debuginator_create(TheDebuginatorConfig* config, struct TheDebuginator* debuginator) {
-	DEBUGINATOR_assert(config->draw_rect != NULL);
-	DEBUGINATOR_assert(config->draw_text != NULL);
+	DEBUGINATOR_assert(config->draw_rect != NULL || config->draw_command_buffer != NULL);
+	DEBUGINATOR_assert(config->draw_text != NULL || config->draw_command_buffer != NULL);
 	DEBUGINATOR_assert(config->text_size != NULL);
 	DEBUGINATOR_assert(config->word_wrap != NULL);
 	DEBUGINATOR_assert(config->app_user_data != NULL);
@@ -3163,6 +4744,9 @@ void debuginator_create(TheDebuginatorConfig* config, struct TheDebuginator* deb
 	debuginator->log = config->log;
 	debuginator->on_opened_changed = config->on_opened_changed;
 	debuginator->play_sound = config->play_sound;
+	debuginator->get_time = config->get_time;
+	debuginator->draw_command_buffer = config->draw_command_buffer;
+	debuginator->retained_drawing = config->retained_drawing;
 	debuginator->app_user_data = config->app_user_data;
 
 	debuginator->size = config->size;
@@ -3182,11 +4766,6 @@ void debuginator_create(TheDebuginatorConfig* config, struct TheDebuginator* deb
 	debuginator->theme_index = 0;
 	debuginator->theme = debuginator->themes[0];
 
-	debuginator->bool_values[0] = false;
-	debuginator->bool_values[1] = true;
-	debuginator->bool_titles[0] = "False";
-	debuginator->bool_titles[1] = "True";
-
 	debuginator->notifications_enabled = config->notifications_enabled;
 	debuginator->notification_position = config->notification_position;
 
@@ -3245,35 +4824,479 @@ void debuginator_create(TheDebuginatorConfig* config, struct TheDebuginator* deb
 		{
 			debuginator_create_bool_item(debuginator, "Debuginator/Settings/Sort items", "Makes items be sorted alphabetically by default.", &debuginator->sort_items);
 		}
-		{
-			int theme_count = 5;
-			int* theme_indices = (int*)debuginator__allocate(debuginator, theme_count * sizeof(int)); //
-			theme_indices[0] = 0;
-			theme_indices[1] = 1;
-			theme_indices[2] = 2;
-			theme_indices[3] = 3;
-			theme_indices[4] = 4;
-			const char** string_titles = (const char**)debuginator__allocate(debuginator, sizeof(char*) * theme_count);
-			string_titles[0] = "Classic";
-			string_titles[1] = "Blue";
-			string_titles[2] = "High Contrast Dark";
-			string_titles[3] = "High Contrast Light";
-			string_titles[4] = "Pink";
-			debuginator_create_array_item(debuginator, NULL, "Debuginator/Settings/Theme",
-				"Change color theme of The Debuginator. \nNote that only Classic is currently polished.", debuginator__on_change_theme, debuginator,
-				string_titles, (void*)theme_indices, theme_count, sizeof(theme_indices[0]));
+		{
+			int theme_count = 5;
+			int* theme_indices = (int*)debuginator__allocate(debuginator, theme_count * sizeof(int)); //
+			theme_indices[0] = 0;
+			theme_indices[1] = 1;
+			theme_indices[2] = 2;
+			theme_indices[3] = 3;
+			theme_indices[4] = 4;
+			const char** string_titles = (const char**)debuginator__allocate(debuginator, sizeof(char*) * theme_count);
+			string_titles[0] = "Classic";
+			string_titles[1] = "Blue";
+			string_titles[2] = "High Contrast Dark";
+			string_titles[3] = "High Contrast Light";
+			string_titles[4] = "Pink";
+			debuginator_create_array_item(debuginator, NULL, "Debuginator/Settings/Theme",
+				"Change color theme of The Debuginator. \nNote that only Classic is currently polished.", debuginator__on_change_theme, debuginator,
+				string_titles, (void*)theme_indices, theme_count, sizeof(theme_indices[0]));
+		}
+		{
+			debuginator_create_bool_item(debuginator, "Debuginator/Settings/Enable notifications",
+				"Get popups... or not!", &debuginator->notifications_enabled);
+		}
+		{
+			debuginator_create_array_item(debuginator, NULL, "Debuginator/Tools/Reset all items",
+				"Resets all menu items to default values.",
+				debuginator_reset_all_items, debuginator, NULL, NULL, 0, 0);
+			debuginator_set_edit_type(debuginator, "Debuginator/Tools/Reset all items", DEBUGINATOR_EditTypeActionArray);
+		}
+#ifdef DEBUGINATOR_ENABLE_PROFILER
+		if (debuginator->get_time != NULL) {
+			for (int i = 0; i < DEBUGINATOR_ProfileZoneCount; i++) {
+				char path[DEBUGINATOR_MAX_PATH_LENGTH];
+				DEBUGINATOR_sprintf_s(path, sizeof(path), "Debuginator/Tools/Profiler/%s", debuginator_get_profile_zone_name((DebuginatorProfileZone)i));
+				DebuginatorItem* zone_item = debuginator_create_array_item(debuginator, NULL, path,
+					"Min / average / max milliseconds per frame, over the last frames that it ran in.",
+					NULL, (void*)(DEBUGINATOR_intptr)i, NULL, NULL, 0, 0);
+				zone_item->leaf.edit_type = DEBUGINATOR_EditTypeProfiler;
+			}
+			debuginator_get_item(debuginator, NULL, "Debuginator/Tools/Profiler", NULL)->folder.is_sorted = false;
+		}
+#endif
+	}
+}
+
+void debuginator_create_staging(struct TheDebuginator* debuginator, struct TheDebuginator* staging, int num_blocks) {
+	DEBUGINATOR_memset(staging, 0, sizeof(*staging));
+
+	// The blocks are the main Debuginator's next ones. Being in its arena, whichever of the two
+	// deallocates something, it goes back to the allocator at the start of its block.
+	staging->memory_arena = debuginator->memory_arena;
+	staging->memory_arena_capacity = debuginator->memory_arena_capacity;
+	DebuginatorBlockAllocatorStaticData* data = &staging->allocator_data;
+	data->block_capacity = debuginator->allocator_data.block_capacity;
+	data->next_free_block = debuginator->allocator_data.next_free_block;
+	data->arena_end = data->next_free_block + (size_t)num_blocks * data->block_capacity;
+	DEBUGINATOR_assert(data->arena_end <= debuginator->allocator_data.arena_end);
+	debuginator->allocator_data.next_free_block = data->arena_end;
+	staging->staging_blocks = data->next_free_block;
+
+	// Unlike the main Debuginator's, these only take a block once they need it, since there are
+	// so few. A full current block makes the first allocation do that.
+	for (int i = 0; i < (int)(sizeof(staging->allocators) / sizeof(staging->allocators[0])); ++i) {
+		DebuginatorBlockAllocator* allocator = &staging->allocators[i];
+		allocator->data = data;
+		allocator->element_size = debuginator->allocators[i].element_size;
+		allocator->current_block_size = data->block_capacity;
+	}
+
+	// What creating items and working out their heights needs.
+	staging->app_user_data = debuginator->app_user_data;
+	staging->draw_image = debuginator->draw_image;
+	staging->draw_rect = debuginator->draw_rect;
+	staging->draw_text = debuginator->draw_text;
+	staging->word_wrap = debuginator->word_wrap;
+	staging->text_size = debuginator->text_size;
+	staging->log = debuginator->log;
+	staging->get_time = debuginator->get_time;
+	staging->size = debuginator->size;
+	staging->screen_resolution = debuginator->screen_resolution;
+	staging->item_height = debuginator->item_height;
+	staging->sort_items = debuginator->sort_items;
+	DEBUGINATOR_memcpy(staging->edit_types, debuginator->edit_types, sizeof(staging->edit_types));
+	DEBUGINATOR_memcpy(staging->themes, debuginator->themes, sizeof(staging->themes));
+	staging->theme_index = debuginator->theme_index;
+	staging->theme = debuginator->theme;
+
+	staging->root = debuginator_new_folder_item(staging, NULL, "Menu Root", 0);
+}
+
+void debuginator_finish_staging(struct TheDebuginator* staging) {
+	// So that the main thread doesn't have to.
+	debuginator__update_layout(staging);
+}
+
+// Returns the item at *cursor or after it that has title, if any. Only looks at items of one
+// kind, which are sorted by title, and leaves *cursor where a later title would be.
+static DebuginatorItem* debuginator__find_sorted_sibling(DebuginatorItem** cursor, bool is_folder, const char* title) {
+	for (; *cursor != NULL; *cursor = (*cursor)->next_sibling) {
+		if ((*cursor)->is_folder != is_folder) {
+			if (is_folder) {
+				continue; // Leaves come first
+			}
+			return NULL;
+		}
+
+		int order = DEBUGINATOR_strcmp((*cursor)->title, title);
+		if (order >= 0) {
+			return order == 0 ? *cursor : NULL;
+		}
+	}
+	return NULL;
+}
+
+// A staged item that wasn't attached, and everything in it.
+static void debuginator__deallocate_staged_item(struct TheDebuginator* debuginator, DebuginatorItem* item) {
+	if (item->is_folder) {
+		DebuginatorItem* child = item->folder.first_child;
+		while (child != NULL) {
+			DebuginatorItem* next_child = child->next_sibling;
+			debuginator__deallocate_staged_item(debuginator, child);
+			child = next_child;
+		}
+	}
+	debuginator__deallocate_item(debuginator, item);
+}
+
+// Moves staged_folder's children into folder. One whose title is taken there already is
+// merged into it if both are folders, and otherwise left out, keeping what's there.
+static void debuginator__attach_staged_children(struct TheDebuginator* debuginator, DebuginatorItem* staged_folder, DebuginatorItem* folder) {
+	// Both are sorted the same way, unless sorting is off, so they're merged in one go rather
+	// than inserting each one by looking through all of the folder's children. A title can
+	// also be taken by an item of the other kind, which other_kind looks for in one go too,
+	// starting over when the staged folders start after the staged leaves.
+	bool is_sorted = folder->folder.is_sorted && staged_folder->folder.is_sorted;
+	DebuginatorItem* sibling = folder->folder.first_child;
+	DebuginatorItem* last_sibling = NULL;
+	DebuginatorItem* other_kind = folder->folder.first_child;
+	bool in_staged_folders = false;
+	DebuginatorItem* child = staged_folder->folder.first_child;
+	debuginator__layout_changed(debuginator, folder);
+	while (child != NULL) {
+		DebuginatorItem* next_child = child->next_sibling;
+		if (!is_sorted) {
+			sibling = folder->folder.first_child;
+			last_sibling = NULL;
+		}
+		else if (child->is_folder && !in_staged_folders) {
+			other_kind = folder->folder.first_child;
+			in_staged_folders = true;
+		}
+
+		DebuginatorItem* existing = NULL;
+		while (sibling != NULL) {
+			int order = DEBUGINATOR_strcmp(sibling->title, child->title);
+			if (order == 0) {
+				existing = sibling;
+				break;
+			}
+
+			bool child_before_folder = !child->is_folder && sibling->is_folder;
+			bool same_type = child->is_folder == sibling->is_folder;
+			if (is_sorted && (child_before_folder || (same_type && order > 0))) {
+				break;
+			}
+
+			last_sibling = sibling;
+			sibling = sibling->next_sibling;
+		}
+
+		if (existing == NULL && is_sorted) {
+			existing = debuginator__find_sorted_sibling(&other_kind, !child->is_folder, child->title);
+		}
+
+		if (existing != NULL) {
+			if (existing->is_folder && child->is_folder) {
+				debuginator__attach_staged_children(debuginator, child, existing);
+				child->folder.first_child = NULL;
+			}
+			debuginator__deallocate_staged_item(debuginator, child);
+			child = next_child;
+			continue;
+		}
+
+		child->parent = folder;
+		child->prev_sibling = last_sibling;
+		child->next_sibling = sibling;
+		if (last_sibling == NULL) {
+			folder->folder.first_child = child;
+		}
+		else {
+			last_sibling->next_sibling = child;
+		}
+		if (sibling != NULL) {
+			sibling->prev_sibling = child;
+		}
+		last_sibling = child;
+
+		bool is_visible = child->is_folder ? child->folder.num_visible_children > 0 : !child->is_filtered;
+		if (is_visible) {
+			debuginator__adjust_num_visible_children(debuginator, folder, 1);
+		}
+
+		// Its own height is right, but the folder's doesn't include it yet.
+		child->total_height = 0;
+		debuginator__invalidate_layout(debuginator, child);
+		child = next_child;
+	}
+}
+
+void debuginator_attach_staging(struct TheDebuginator* debuginator, struct TheDebuginator* staging, DebuginatorItem* parent) {
+	DEBUGINATOR_assert(staging->staging_blocks != NULL);
+	DEBUGINATOR_assert(!staging->layout_full_rebuild && staging->layout_dirty_count == 0); // See debuginator_finish_staging
+	debuginator__mark_dirty(debuginator);
+	parent = parent == NULL ? debuginator->root : parent;
+
+	// The allocators have the same element sizes in both, so the blocks, and what's been freed
+	// in them, are handed over to the corresponding main ones.
+	for (char* block = staging->staging_blocks; block < staging->allocator_data.next_free_block; block += staging->allocator_data.block_capacity) {
+		DebuginatorBlockAllocator** block_allocator = (DebuginatorBlockAllocator**)(void*)block;
+		*block_allocator = &debuginator->allocators[*block_allocator - staging->allocators];
+	}
+
+	for (int i = 0; i < (int)(sizeof(staging->allocators) / sizeof(staging->allocators[0])); ++i) {
+		DebuginatorBlockAllocator* from = &staging->allocators[i];
+		DebuginatorBlockAllocator* to = &debuginator->allocators[i];
+		if (from->next_free_slot != NULL) {
+			char* last_free_slot = from->next_free_slot;
+			while (*(char**)(void*)last_free_slot != NULL) {
+				last_free_slot = *(char**)(void*)last_free_slot;
+			}
+
+			*(char**)(void*)last_free_slot = to->next_free_slot;
+			to->next_free_slot = from->next_free_slot;
+		}
+
+		to->stat_total_used += from->stat_total_used;
+		to->stat_num_allocations += from->stat_num_allocations;
+		to->stat_num_freed += from->stat_num_freed;
+		to->stat_num_blocks += from->stat_num_blocks;
+		to->stat_wasted_block_space += from->stat_wasted_block_space + (from->data->block_capacity - from->current_block_size);
+	}
+
+	// Blocks that weren't needed can be given back, unless something else was reserved after them.
+	if (debuginator->allocator_data.next_free_block == staging->allocator_data.arena_end) {
+		debuginator->allocator_data.next_free_block = staging->allocator_data.next_free_block;
+	}
+
+	debuginator__attach_staged_children(debuginator, staging->root, parent);
+	debuginator__deallocate_item(debuginator, staging->root);
+	DEBUGINATOR_memset(staging, 0, sizeof(*staging));
+}
+
+// Fills the text caches with what drawing the on-screen children of folder will look up.
+// Walks them the same way debuginator__draw_item does.
+static void debuginator__cache_children_text(struct TheDebuginator* debuginator, DebuginatorItem* folder, float y) {
+	DebuginatorItem* child = debuginator__skip_children_above(folder, &y, 0);
+	while (child && y <= debuginator->size.y) {
+		if (y + child->total_height > 0) {
+			if (child->is_folder) {
+				debuginator__cache_children_text(debuginator, child, y + debuginator->item_height);
+			}
+			else {
+				// Bool sliders move when they're changed, but only on screen.
+				child->leaf.draw_t = DEBUGINATOR_min(1.f, child->leaf.draw_t + debuginator->dt * 5);
+
+				char hot_key_text[DEBUGINATOR_MAX_PATH_LENGTH];
+				if (debuginator__hot_key_label(debuginator, child, hot_key_text)) {
+					debuginator__cache_text_size(debuginator, hot_key_text, &debuginator->theme.fonts[DEBUGINATOR_ItemTitle]);
+				}
+
+				if (child->leaf.is_expanded) {
+					debuginator__wrap_description(debuginator, child, debuginator__description_width(debuginator, child));
+				}
+			}
+		}
+
+		y += child->total_height;
+		child = debuginator__next_visible_sibling(child);
+	}
+}
+
+// Word wraps and measures everything debuginator_draw will need, so drawing only has to
+// read the caches.
+static void debuginator__cache_draw_text(struct TheDebuginator* debuginator) {
+	if (!debuginator->is_open && debuginator->openness == 0) {
+		return;
+	}
+
+	if (debuginator->draw_mode == DEBUGINATOR_DrawModeHierarchy) {
+		debuginator__cache_children_text(debuginator, debuginator->root, debuginator->current_height_offset);
+	}
+
+	DebuginatorItem* tooltip_item = debuginator->hot_mouse_item;
+	if (tooltip_item != NULL && !tooltip_item->is_folder && tooltip_item->leaf.description[0] != '\0') {
+		debuginator__wrap_description(debuginator, tooltip_item, debuginator__tooltip_width(debuginator));
+	}
+
+	if (debuginator->filter_enabled || debuginator->filter_timer > 0) {
+		DebuginatorFont* font = &debuginator->theme.fonts[DEBUGINATOR_ItemTitleActive];
+		debuginator__cache_text_size(debuginator, "Search: ", font);
+		if (DEBUGINATOR_strchr(debuginator->filter, ' ')) {
+			char letter[2] = { 0 };
+			for (size_t i = 0; i < DEBUGINATOR_strlen(debuginator->filter); i++) {
+				letter[0] = debuginator->filter[i];
+				debuginator__cache_text_size(debuginator, letter, font);
+			}
+		}
+		else {
+			debuginator__cache_text_size(debuginator, debuginator->filter, font);
+		}
+	}
+}
+
+static void debuginator__update_theme_colors(struct TheDebuginator* debuginator) {
+	// Update theme opacity
+	DebuginatorTheme* source_theme = &debuginator->themes[debuginator->theme_index];
+	for (int i = 0; i < DEBUGINATOR_NumDrawTypes; i++) {
+		debuginator->theme.colors[i].a = (unsigned char)(source_theme->colors[i].a * debuginator->openness);
+	}
+
+	float lerp_t = (float)(DEBUGINATOR_sin(debuginator->draw_timer * 2) + 1) * 0.5f;
+	debuginator->theme.colors[DEBUGINATOR_ItemTitleActive].r = (unsigned char)debuginator__lerp((float)debuginator->theme.colors[DEBUGINATOR_ItemTitleActive1].r, (float)debuginator->theme.colors[DEBUGINATOR_ItemTitleActive2].r, lerp_t);
+	debuginator->theme.colors[DEBUGINATOR_ItemTitleActive].g = (unsigned char)debuginator__lerp((float)debuginator->theme.colors[DEBUGINATOR_ItemTitleActive1].g, (float)debuginator->theme.colors[DEBUGINATOR_ItemTitleActive2].g, lerp_t);
+	debuginator->theme.colors[DEBUGINATOR_ItemTitleActive].b = (unsigned char)debuginator__lerp((float)debuginator->theme.colors[DEBUGINATOR_ItemTitleActive1].b, (float)debuginator->theme.colors[DEBUGINATOR_ItemTitleActive2].b, lerp_t);
+
+	if (debuginator->hot_mouse_item == NULL) {
+		debuginator->theme.colors[DEBUGINATOR_LineHighlightMouse].a = (unsigned char)debuginator__lerp((float)debuginator->theme.colors[DEBUGINATOR_LineHighlightMouse].a, 0, 0.5f);
+	}
+	else {
+		debuginator->theme.colors[DEBUGINATOR_LineHighlightMouse].a = (unsigned char)debuginator__lerp((float)debuginator->theme.colors[DEBUGINATOR_LineHighlightMouse].a, (float)debuginator->theme.colors[DEBUGINATOR_LineHighlight].a - 50, 0.005f);
+	}
+}
+
+// Works out which item, and which of its values, the mouse is over. Uses the same geometry as
+// drawing, so it's what gets highlighted.
+static void debuginator__update_hot_mouse_item(struct TheDebuginator* debuginator) {
+	DebuginatorItem* old_hot_mouse_item = debuginator->hot_mouse_item;
+	debuginator->hot_mouse_item = NULL;
+	debuginator->hot_mouse_item_index = DEBUGINATOR_NO_HOT_INDEX;
+
+	DebuginatorVector2 mouse = debuginator->mouse_cursor_pos;
+	bool mouse_over =
+		debuginator->top_left.x <= mouse.x && mouse.x < debuginator->top_left.x + debuginator->size.x &&
+		0 <= mouse.y && mouse.y < debuginator->size.y;
+	if (debuginator->draw_mode == DEBUGINATOR_DrawModeHierarchy && mouse_over) {
+		int value_index;
+		DebuginatorItem* item = debuginator_get_item_at_y(debuginator, mouse.y, &value_index);
+		debuginator->hot_mouse_item = item;
+
+		// Other edit types draw their values their own way, so they can't be clicked one by one.
+		if (item != NULL && !item->is_folder && debuginator->edit_types[(int)item->leaf.edit_type].expanded_draw == debuginator__expanded_draw_default) {
+			debuginator->hot_mouse_item_index = value_index;
+		}
+	}
+
+	if (old_hot_mouse_item != debuginator->hot_mouse_item && debuginator->hot_mouse_item != NULL) {
+		PLAYSOUND(DEBUGINATOR_SoundEventEnter);
+	}
+}
+
+static void debuginator__update_notifications(struct TheDebuginator* debuginator, float dt) {
+	if (!debuginator->notifications_enabled) {
+		debuginator->notification_count = 0;
+		return;
+	}
+
+	// They're only shown while the menu isn't fully open.
+	if (debuginator->openness == 1) {
+		return;
+	}
+
+	bool all_done = true;
+	for (int i = 0; i < debuginator->notification_count; ++i) {
+		debuginator->notification_anims[i] += dt;
+		if (debuginator->notification_anims[i] < 2) {
+			all_done = false;
+		}
+	}
+
+	if (all_done) {
+		debuginator->notification_count = 0;
+	}
+}
+
+static void debuginator__update_animations(struct TheDebuginator* debuginator, float dt) {
+	int running_animations = 0;
+	for (int i = 0; i < debuginator->animation_count; i++) {
+		DebuginatorAnimation* animation = &debuginator->animations[i];
+		if (animation->time < animation->duration) {
+			animation->time = DEBUGINATOR_min(animation->duration, animation->time + dt);
+			++running_animations;
+		}
+	}
+
+	if (running_animations == 0) {
+		debuginator->animation_count = 0;
+	}
+}
+
+static void debuginator__update_search_filter(struct TheDebuginator* debuginator, float dt) {
+	bool filter_hint_mode = !debuginator->filter_enabled && debuginator->current_height_offset > 100;
+	if (debuginator->filter_enabled) {
+		debuginator->filter_timer += dt * 5;
+		if (debuginator->filter_timer > 1) {
+			debuginator->filter_timer = 1;
+		}
+		if (filter_hint_mode && debuginator->filter_timer > 0.5f) {
+			debuginator->filter_timer = 0.5f;
+		}
+	}
+	else if (filter_hint_mode) {
+		if (debuginator->filter_timer > 0.5f) {
+			debuginator->filter_timer -= dt * 5;
+			if (debuginator->filter_timer < 0.5f) {
+				debuginator->filter_timer = 0.5f;
+			}
+		}
+		else {
+			debuginator->filter_timer += dt * 5;
+			if (debuginator->filter_timer > 0.5f) {
+				debuginator->filter_timer = 0.5f;
+			}
+		}
+	}
+	else {
+		debuginator->filter_timer -= dt * 5;
+		if (debuginator->filter_timer < 0) {
+			debuginator->filter_timer = 0;
 		}
-		{
-			debuginator_create_bool_item(debuginator, "Debuginator/Settings/Enable notifications",
-				"Get popups... or not!", &debuginator->notifications_enabled);
+	}
+
+	// Kept from when it was last shown, for clicks.
+	if (debuginator->filter_timer > 0) {
+		debuginator->filter_pos = debuginator__vector2(debuginator->top_left.x + debuginator->size.x - 450, 25);
+		debuginator->filter_size = debuginator__vector2(150 + (debuginator->size.x - 250) * debuginator->filter_timer, DEBUGINATOR_FILTER_HEIGHT);
+	}
+}
+
+static void debuginator__update_tooltip(struct TheDebuginator* debuginator, float dt) {
+	DebuginatorItem* item = debuginator->hot_mouse_item;
+	if (item == NULL) {
+		debuginator->tooltip_timer = DEBUGINATOR_max(DEBUGINATOR_TOOLTIP_DELAY, debuginator->tooltip_timer - dt);
+	}
+	else if (item->is_folder || item->leaf.description[0] == '\0' ) {
+		if (debuginator->tooltip_timer >= 0) {
+			debuginator->tooltip_timer = DEBUGINATOR_max(0.f, debuginator->tooltip_timer - dt);
 		}
-		{
-			debuginator_create_array_item(debuginator, NULL, "Debuginator/Tools/Reset all items",
-				"Resets all menu items to default values.",
-				debuginator_reset_all_items, debuginator, NULL, NULL, 0, 0);
-			debuginator_set_edit_type(debuginator, "Debuginator/Tools/Reset all items", DEBUGINATOR_EditTypeActionArray);
+		else {
+			debuginator->tooltip_timer = DEBUGINATOR_max(DEBUGINATOR_TOOLTIP_DELAY, debuginator->tooltip_timer - dt);
 		}
 	}
+	else {
+		debuginator->tooltip_timer = DEBUGINATOR_min(DEBUGINATOR_TOOLTIP_FADEIN, debuginator->tooltip_timer + dt);
+	}
+}
+
+// Everything that moves on its own, so debuginator_draw only has to read where it's at.
+static void debuginator__update_draw_animations(struct TheDebuginator* debuginator, float dt) {
+	debuginator__update_notifications(debuginator, dt);
+
+	// Like drawing, the rest stops while fully closed.
+	if (!debuginator->is_open && debuginator->openness == 0) {
+		return;
+	}
+
+	debuginator__update_hot_mouse_item(debuginator);
+	debuginator__update_theme_colors(debuginator);
+	if (debuginator->draw_mode == DEBUGINATOR_DrawModeHierarchy) {
+		debuginator__update_animations(debuginator, dt);
+	}
+
+	debuginator__update_search_filter(debuginator, dt);
+	debuginator__update_tooltip(debuginator, dt);
 }
 
 void debuginator_update(struct TheDebuginator* debuginator, float dt) {
@@ -3282,8 +5305,14 @@ void debuginator_update(struct TheDebuginator* debuginator, float dt) {
 		dt = 0.5f;
 	}
 
+	// A new frame, see DebuginatorFrameStats.
+	debuginator->last_frame_stats = debuginator->frame_stats;
+	DEBUGINATOR_memset(&debuginator->frame_stats, 0, sizeof(debuginator->frame_stats));
+
+	DEBUGINATOR_PROFILE_BEGIN(debuginator, DEBUGINATOR_ProfileUpdate);
 	debuginator->dt = dt;
 	debuginator->draw_timer += dt * 5;
+	debuginator__update_layout(debuginator);
 	if (debuginator->is_open && debuginator->openness < 1) {
 		debuginator->openness_timer += dt * 5;
 		if (debuginator->openness_timer > 1) {
@@ -3312,8 +5341,7 @@ void debuginator_update(struct TheDebuginator* debuginator, float dt) {
 	debuginator->scroll_current = (int)debuginator__lerp((float)debuginator->scroll_current, (float)debuginator->scroll_wanted, DEBUGINATOR_min(0.9f, dt * 10.0f));
 
 	// Ensure hot item is smoothly placed at a nice position
-	int distance_from_root_to_hot_item = 0;
-	debuginator__distance_to_hot_item(debuginator->root, debuginator->hot_item, debuginator->item_height, &distance_from_root_to_hot_item);
+	int distance_from_root_to_hot_item = debuginator__distance_to_item(debuginator, debuginator->hot_item);
 	float wanted_y = DEBUGINATOR_FILTER_HEIGHT + debuginator->size.y * debuginator->focus_height + debuginator->scroll_current;
 	float distance_to_wanted_y = wanted_y - distance_from_root_to_hot_item;
 	debuginator->current_height_offset = debuginator__lerp(debuginator->current_height_offset, distance_to_wanted_y, DEBUGINATOR_min(1, dt * 10));
@@ -3331,16 +5359,19 @@ void debuginator_update(struct TheDebuginator* debuginator, float dt) {
 
 	// Update "origin" position
 	debuginator->top_left = debuginator__vector2(debuginator->root_position.x + debuginator->size.x * debuginator->openness * debuginator->open_direction, 0);
+	debuginator__update_draw_animations(debuginator, dt);
+	debuginator__cache_draw_text(debuginator);
+	DEBUGINATOR_PROFILE_END(debuginator, DEBUGINATOR_ProfileUpdate);
 }
 
 
 static float debuginator__draw_item(struct TheDebuginator* debuginator, DebuginatorItem* item, DebuginatorVector2 offset, bool hot);
 static void debuginator__draw_hierarchy(struct TheDebuginator* debuginator, float dt, DebuginatorVector2 offset);
 static void debuginator__draw_sorted_filter(struct TheDebuginator* debuginator, float dt, DebuginatorVector2 offset);
-static void debuginator__draw_animations(struct TheDebuginator* debuginator, float dt);
-static void debuginator__draw_search_filter(struct TheDebuginator* debuginator, float dt);
-static void debuginator__draw_notifications(struct TheDebuginator* debuginator, float dt);
-static void debuginator__draw_tooltip(struct TheDebuginator* debuginator, float dt);
+static void debuginator__draw_animations(struct TheDebuginator* debuginator);
+static void debuginator__draw_search_filter(struct TheDebuginator* debuginator);
+static void debuginator__draw_notifications(struct TheDebuginator* debuginator);
+static void debuginator__draw_tooltip(struct TheDebuginator* debuginator);
 
 static void debuginator__draw_border(struct TheDebuginator* debuginator, DebuginatorVector2* position, DebuginatorVector2* size, float thickness, DebuginatorColor* color1, DebuginatorColor* color2) {
 	DebuginatorVector2 border_h_size = {size->x,  thickness};
@@ -3349,66 +5380,165 @@ static void debuginator__draw_border(struct TheDebuginator* debuginator, Debugin
 	DebuginatorVector2 border_b_pos = {position->x, position->y + size->y - thickness};
 	DebuginatorVector2 border_l_pos = {position->x, position->y + thickness};
 	DebuginatorVector2 border_r_pos = {position->x + size->x - thickness, position->y + thickness};
-	debuginator->draw_rect(&border_t_pos, &border_h_size, color1, debuginator->app_user_data);
-	debuginator->draw_rect(&border_b_pos, &border_h_size, color1, debuginator->app_user_data);
-	debuginator->draw_rect(&border_l_pos, &border_v_size, color1, debuginator->app_user_data);
-	debuginator->draw_rect(&border_r_pos, &border_v_size, color1, debuginator->app_user_data);
-	debuginator->draw_rect(&border_t_pos, &border_h_size, color2, debuginator->app_user_data);
-	debuginator->draw_rect(&border_b_pos, &border_h_size, color2, debuginator->app_user_data);
-	debuginator->draw_rect(&border_l_pos, &border_v_size, color2, debuginator->app_user_data);
-	debuginator->draw_rect(&border_r_pos, &border_v_size, color2, debuginator->app_user_data);
+	debuginator__draw_rect(debuginator, &border_t_pos, &border_h_size, color1);
+	debuginator__draw_rect(debuginator, &border_b_pos, &border_h_size, color1);
+	debuginator__draw_rect(debuginator, &border_l_pos, &border_v_size, color1);
+	debuginator__draw_rect(debuginator, &border_r_pos, &border_v_size, color1);
+	debuginator__draw_rect(debuginator, &border_t_pos, &border_h_size, color2);
+	debuginator__draw_rect(debuginator, &border_b_pos, &border_h_size, color2);
+	debuginator__draw_rect(debuginator, &border_l_pos, &border_v_size, color2);
+	debuginator__draw_rect(debuginator, &border_r_pos, &border_v_size, color2);
+}
+
+void debuginator_set_draw_command_buffer(struct TheDebuginator* debuginator, DebuginatorDrawCommandBuffer* buffer) {
+	debuginator->draw_command_buffer = buffer;
+	debuginator->draw_list_valid = false;
+}
+
+void debuginator_submit_draw_commands(struct TheDebuginator* debuginator, DebuginatorDrawCommandBuffer* buffer) {
+	for (int i = 0; i < buffer->command_count; i++) {
+		DebuginatorDrawCommand* command = &buffer->commands[i];
+		switch (command->type) {
+			case DEBUGINATOR_DrawCommandRect:
+				debuginator->draw_rect(&command->position, &command->size, &command->color, debuginator->app_user_data);
+				break;
+			case DEBUGINATOR_DrawCommandText:
+				debuginator->draw_text(buffer->strings + command->data.text.offset, &command->position, &command->color, &debuginator->theme.fonts[command->font], debuginator->app_user_data);
+				break;
+			case DEBUGINATOR_DrawCommandImage:
+				debuginator->draw_image(&command->position, &command->size, command->data.image, debuginator->app_user_data);
+				break;
+		}
+	}
 }
 
-void debuginator_draw(struct TheDebuginator* debuginator, float dt) {
-	// Always draw notifications
-	debuginator__draw_notifications(debuginator, dt);
+void debuginator_set_retained_drawing(struct TheDebuginator* debuginator, bool enabled) {
+	debuginator->retained_drawing = enabled;
+	debuginator->draw_list_valid = false;
+}
 
-	// Don't do anything if we're fully closed
-	if (!debuginator->is_open && debuginator->openness == 0) {
-		return;
-	}
+void debuginator_invalidate_draw_list(struct TheDebuginator* debuginator) {
+	debuginator__mark_dirty(debuginator);
+}
 
-	// Update theme opacity
-	DebuginatorTheme* source_theme = &debuginator->themes[debuginator->theme_index];
-	for (int i = 0; i < DEBUGINATOR_NumDrawTypes; i++) {
-		debuginator->theme.colors[i].a = (unsigned char)(source_theme->colors[i].a * debuginator->openness);
+static void debuginator__get_draw_state(struct TheDebuginator* debuginator, DebuginatorDrawState* state) {
+	DEBUGINATOR_memset(state, 0, sizeof(*state));
+	state->hot_item = debuginator->hot_item;
+	state->hot_mouse_item = debuginator->hot_mouse_item;
+	state->hot_index = debuginator->hot_item != NULL && !debuginator->hot_item->is_folder ? debuginator->hot_item->leaf.hot_index : 0;
+	state->generation = debuginator->draw_generation;
+	state->root_total_height = debuginator->root != NULL ? debuginator->root->total_height : 0;
+	state->scroll_current = debuginator->scroll_current;
+	state->current_height_offset = debuginator->current_height_offset;
+	state->openness = debuginator->openness;
+	state->top_left = debuginator->top_left;
+	state->size = debuginator->size;
+	state->screen_resolution = debuginator->screen_resolution;
+	state->mouse_cursor_pos = debuginator->mouse_cursor_pos;
+	state->item_height = debuginator->item_height;
+	state->quick_draw_size = debuginator->quick_draw_size;
+	state->theme_index = debuginator->theme_index;
+	state->draw_mode = debuginator->draw_mode;
+	state->is_open = debuginator->is_open;
+	state->filter_enabled = debuginator->filter_enabled;
+	state->notifications_enabled = debuginator->notifications_enabled;
+	state->open_direction = debuginator->open_direction;
+	state->filter_timer = debuginator->filter_timer;
+	state->tooltip_timer = debuginator->tooltip_timer;
+	DEBUGINATOR_memcpy(state->filter, debuginator->filter, sizeof(state->filter));
+}
+
+bool debuginator_needs_redraw(struct TheDebuginator* debuginator) {
+	if (!debuginator->draw_list_valid || debuginator->draw_list_animating) {
+		return true;
 	}
 
-	float lerp_t = (float)(DEBUGINATOR_sin(debuginator->draw_timer * 2) + 1) * 0.5f;
-	debuginator->theme.colors[DEBUGINATOR_ItemTitleActive].r = (unsigned char)debuginator__lerp((float)debuginator->theme.colors[DEBUGINATOR_ItemTitleActive1].r, (float)debuginator->theme.colors[DEBUGINATOR_ItemTitleActive2].r, lerp_t);
-	debuginator->theme.colors[DEBUGINATOR_ItemTitleActive].g = (unsigned char)debuginator__lerp((float)debuginator->theme.colors[DEBUGINATOR_ItemTitleActive1].g, (float)debuginator->theme.colors[DEBUGINATOR_ItemTitleActive2].g, lerp_t);
-	debuginator->theme.colors[DEBUGINATOR_ItemTitleActive].b = (unsigned char)debuginator__lerp((float)debuginator->theme.colors[DEBUGINATOR_ItemTitleActive1].b, (float)debuginator->theme.colors[DEBUGINATOR_ItemTitleActive2].b, lerp_t);
+	DebuginatorDrawState state;
+	debuginator__get_draw_state(debuginator, &state);
+	return DEBUGINATOR_memcmp(&state, &debuginator->draw_list_state, sizeof(state)) != 0;
+}
 
-	if (debuginator->hot_mouse_item == NULL) {
-		debuginator->theme.colors[DEBUGINATOR_LineHighlightMouse].a = (unsigned char)debuginator__lerp((float)debuginator->theme.colors[DEBUGINATOR_LineHighlightMouse].a, 0, 0.5f);
-	}
-	else {
-		debuginator->theme.colors[DEBUGINATOR_LineHighlightMouse].a = (unsigned char)debuginator__lerp((float)debuginator->theme.colors[DEBUGINATOR_LineHighlightMouse].a, (float)debuginator->theme.colors[DEBUGINATOR_LineHighlight].a - 50, 0.005f);
-	}
+static void debuginator__draw_frame(struct TheDebuginator* debuginator, float dt) {
+	// Always draw notifications
+	DEBUGINATOR_PROFILE_BEGIN(debuginator, DEBUGINATOR_ProfileDrawNotifications);
+	debuginator__draw_notifications(debuginator);
+	DEBUGINATOR_PROFILE_END(debuginator, DEBUGINATOR_ProfileDrawNotifications);
 
-	// Clear mouse hot item. It gets set appropriately in draw_item.
-	DebuginatorItem* old_hot_mouse_item = debuginator->hot_mouse_item;
-	debuginator->hot_mouse_item = NULL;
-	debuginator->hot_mouse_item_index = DEBUGINATOR_NO_HOT_INDEX;
+	// Don't do anything if we're fully closed
+	if (!debuginator->is_open && debuginator->openness == 0) {
+		return;
+	}
 
 	// Background
 	DebuginatorVector2 offset = debuginator->top_left;
-	debuginator->draw_rect(&offset, &debuginator->size, &debuginator->theme.colors[DEBUGINATOR_Background], debuginator->app_user_data);
+	debuginator__draw_rect(debuginator, &offset, &debuginator->size, &debuginator->theme.colors[DEBUGINATOR_Background]);
 
 	if (debuginator->draw_mode == DEBUGINATOR_DrawModeHierarchy) {
+		DEBUGINATOR_PROFILE_BEGIN(debuginator, DEBUGINATOR_ProfileDrawHierarchy);
 		debuginator__draw_hierarchy(debuginator, dt, offset);
-		debuginator__draw_animations(debuginator, dt);
+		DEBUGINATOR_PROFILE_END(debuginator, DEBUGINATOR_ProfileDrawHierarchy);
+		DEBUGINATOR_PROFILE_BEGIN(debuginator, DEBUGINATOR_ProfileDrawAnimations);
+		debuginator__draw_animations(debuginator);
+		DEBUGINATOR_PROFILE_END(debuginator, DEBUGINATOR_ProfileDrawAnimations);
 	}
 	else if (debuginator->draw_mode == DEBUGINATOR_DrawModeSortedFilter) {
 		debuginator__draw_sorted_filter(debuginator, dt, offset);
 	}
 
-	debuginator__draw_search_filter(debuginator, dt);
-	debuginator__draw_tooltip(debuginator, dt);
+	debuginator__draw_search_filter(debuginator);
+	DEBUGINATOR_PROFILE_BEGIN(debuginator, DEBUGINATOR_ProfileDrawTooltip);
+	debuginator__draw_tooltip(debuginator);
+	DEBUGINATOR_PROFILE_END(debuginator, DEBUGINATOR_ProfileDrawTooltip);
+}
 
-	if (old_hot_mouse_item != debuginator->hot_mouse_item && debuginator->hot_mouse_item != NULL) {
-		PLAYSOUND(DEBUGINATOR_SoundEventEnter);
+static void debuginator__draw(struct TheDebuginator* debuginator, float dt) {
+	DebuginatorDrawCommandBuffer* buffer = debuginator->draw_command_buffer;
+	if (buffer == NULL) {
+		debuginator__draw_frame(debuginator, dt);
+		return;
+	}
+
+	DebuginatorDrawState state;
+	debuginator__get_draw_state(debuginator, &state);
+	if (debuginator->retained_drawing
+		&& debuginator->draw_list_valid
+		&& !debuginator->draw_list_animating
+		&& DEBUGINATOR_memcmp(&state, &debuginator->draw_list_state, sizeof(state)) == 0) {
+		// Nothing has changed, so keep last frame's commands, except for the pulse.
+		// The mouse highlight fades in and out, and its color is copied into more than the
+		// highlight rects, so it's redrawn for as long as it moves instead of patched.
+		if (debuginator->theme.colors[DEBUGINATOR_LineHighlightMouse].a == debuginator->draw_list_mouse_highlight_alpha) {
+			DebuginatorColor pulse_color = debuginator->theme.colors[DEBUGINATOR_ItemTitleActive];
+			for (int i = 0; i < buffer->command_count; i++) {
+				DebuginatorDrawCommand* command = &buffer->commands[i];
+				if (command->flags & DEBUGINATOR_DRAW_COMMAND_PULSING) {
+					command->color.r = pulse_color.r;
+					command->color.g = pulse_color.g;
+					command->color.b = pulse_color.b;
+				}
+			}
+			return;
+		}
 	}
+
+	buffer->command_count = 0;
+	buffer->strings_size = 0;
+	buffer->overflowed = false;
+
+	// Things that animate set draw_list_animating while drawing. The search box's caret blinks
+	// for as long as it's shown, and the timers that fade things in are in the draw state.
+	debuginator->draw_list_animating = debuginator->animation_count > 0 || debuginator->filter_timer > 0;
+	debuginator__draw_frame(debuginator, dt);
+
+	debuginator->draw_list_state = state;
+	debuginator->draw_list_mouse_highlight_alpha = debuginator->theme.colors[DEBUGINATOR_LineHighlightMouse].a;
+	debuginator->draw_list_valid = !buffer->overflowed;
+}
+
+void debuginator_draw(struct TheDebuginator* debuginator, float dt) {
+	DEBUGINATOR_PROFILE_BEGIN(debuginator, DEBUGINATOR_ProfileDraw);
+	debuginator__draw(debuginator, dt);
+	DEBUGINATOR_PROFILE_END(debuginator, DEBUGINATOR_ProfileDraw);
 }
 
 static void debuginator__draw_hierarchy(struct TheDebuginator* debuginator, float dt, DebuginatorVector2 offset){
@@ -3417,8 +5547,10 @@ static void debuginator__draw_hierarchy(struct TheDebuginator* debuginator, floa
 
 	// Draw all items within the debuginator's draw area
 	offset.x += DEBUGINATOR_LEFT_MARGIN;
-	DebuginatorItem* item_to_draw = debuginator__first_visible_child(debuginator->root);
+	DebuginatorItem* item_to_draw = debuginator__skip_children_above(debuginator->root, &offset.y, 0);
 	while (item_to_draw && offset.y < -item_to_draw->total_height) {
+		++debuginator->frame_stats.items_visited;
+
 		// We'll start to draw off-screen which we don't want.
 		if (offset.y + item_to_draw->total_height < 0) {
 			// Whole item is off-screen, skip to sibling
@@ -3439,6 +5571,7 @@ static void debuginator__draw_hierarchy(struct TheDebuginator* debuginator, floa
 	// item_to_draw is now the first item (folder most likely) who is at least partly
 	// within the rendering area.
 	while (item_to_draw && offset.y < debuginator->size.y) {
+		++debuginator->frame_stats.items_visited;
 		debuginator__draw_item(debuginator, item_to_draw, offset, debuginator->hot_item == item_to_draw);
 		offset.y += item_to_draw->total_height;
 		while (item_to_draw && debuginator__next_visible_sibling(item_to_draw) == NULL) {
@@ -3454,34 +5587,20 @@ static void debuginator__draw_hierarchy(struct TheDebuginator* debuginator, floa
 	}
 }
 
-static void debuginator__draw_animations(struct TheDebuginator* debuginator, float dt) {
-	// Update animations
-	int running_animations = debuginator->animation_count; // Can be cleverer I guess
+static void debuginator__draw_animations(struct TheDebuginator* debuginator) {
+	// Moved along in debuginator__update_animations
 	for (int i = 0; i < debuginator->animation_count; i++) {
 		DebuginatorAnimation* animation = &debuginator->animations[i];
 		if (animation->time == animation->duration) {
-			--running_animations;
 			continue;
 		}
 
-		animation->time += dt;
-		if (animation->time > animation->duration) {
-			animation->time = animation->duration;
-		}
 		if (animation->type == DEBUGINATOR_ItemActivate) {
 			DebuginatorItem* anim_item = animation->data.item_activate.item;
 
-			int distance_from_root_to_item = 0;
-			if (anim_item->is_folder) {
-				debuginator__distance_to_hot_item(debuginator->root, anim_item, debuginator->item_height, &distance_from_root_to_item);
-			}
-			else {
-				// Ensure we don't take the hot index into account
-				bool old_is_expanded = anim_item->leaf.is_expanded;
-				anim_item->leaf.is_expanded = false;
-				debuginator__distance_to_hot_item(debuginator->root, anim_item, debuginator->item_height, &distance_from_root_to_item);
-				anim_item->leaf.is_expanded = old_is_expanded;
-			}
+			// Not taking the hot index into account, and without updating the layout
+			// since we're drawing.
+			int distance_from_root_to_item = debuginator__distance_to_item_uncached(debuginator, anim_item);
 
 			DebuginatorVector2 start_position = animation->data.item_activate.start_pos;
 			DebuginatorVector2 end_position;
@@ -3494,69 +5613,33 @@ static void debuginator__draw_animations(struct TheDebuginator* debuginator, flo
 				position.y = debuginator__ease_out(animation->time, start_position.y, end_position.y - start_position.y, animation->duration);
 				DebuginatorFont* font = &debuginator->theme.fonts[DEBUGINATOR_ItemTitle];
 				const char* text = anim_item->leaf.value_titles[animation->data.item_activate.value_index];
-				debuginator->draw_text(text, &position, &debuginator->theme.colors[DEBUGINATOR_ItemTitleActive], font, debuginator->app_user_data);
+				debuginator__draw_text(debuginator, text, &position, &debuginator->theme.colors[DEBUGINATOR_ItemTitleActive], font);
 			}
 		}
 	}
-
-	if (running_animations == 0) {
-		debuginator->animation_count = 0;
-	}
 }
 
-static void debuginator__draw_search_filter(struct TheDebuginator* debuginator, float dt) {
-	bool filter_hint_mode = !debuginator->filter_enabled && debuginator->current_height_offset > 100;
-	if (debuginator->filter_enabled) {
-		debuginator->filter_timer += dt * 5;
-		if (debuginator->filter_timer > 1) {
-			debuginator->filter_timer = 1;
-		}
-		if (filter_hint_mode && debuginator->filter_timer > 0.5f) {
-			debuginator->filter_timer = 0.5f;
-		}
-	}
-	else if (filter_hint_mode) {
-		if (debuginator->filter_timer > 0.5f) {
-			debuginator->filter_timer -= dt * 5;
-			if (debuginator->filter_timer < 0.5f) {
-				debuginator->filter_timer = 0.5f;
-			}
-		}
-		else {
-			debuginator->filter_timer += dt * 5;
-			if (debuginator->filter_timer > 0.5f) {
-				debuginator->filter_timer = 0.5f;
-			}
-		}
-	}
-	else {
-		debuginator->filter_timer -= dt * 5;
-		if (debuginator->filter_timer < 0) {
-			debuginator->filter_timer = 0;
-		}
-	}
-
+static void debuginator__draw_search_filter(struct TheDebuginator* debuginator) {
+	// Faded in and out, and placed, in debuginator__update_search_filter
 	if (debuginator->filter_timer <= 0) {
 		return;
 	}
 
+	bool filter_hint_mode = !debuginator->filter_enabled && debuginator->current_height_offset > 100;
 	float alpha = debuginator->filter_timer;
 	DebuginatorVector2 filter_pos = debuginator->filter_pos;
 	DebuginatorVector2 filter_size = debuginator->filter_size;
-
-	filter_pos = debuginator__vector2(debuginator->top_left.x + debuginator->size.x - 450, 25);
-	filter_size = debuginator__vector2(150 + (debuginator->size.x - 250) * debuginator->filter_timer, DEBUGINATOR_FILTER_HEIGHT);
 	DebuginatorColor filter_color = debuginator__color(50, 100, 50, (int)(200 * debuginator->filter_timer * alpha));
-	debuginator->draw_rect(&filter_pos, &filter_size, &filter_color, debuginator->app_user_data);
+	debuginator__draw_rect(debuginator, &filter_pos, &filter_size, &filter_color);
 
-	DebuginatorVector2 header_text_size = debuginator->text_size("Search: ", &debuginator->theme.fonts[DEBUGINATOR_ItemTitleActive], debuginator->app_user_data);
+	DebuginatorVector2 header_text_size = debuginator__text_size(debuginator, "Search: ", &debuginator->theme.fonts[DEBUGINATOR_ItemTitleActive]);
 	DebuginatorVector2 header_bg_size = debuginator__vector2(header_text_size.x + DEBUGINATOR_FILTER_HEIGHT / 2, filter_size.y);
-	debuginator->draw_rect(&filter_pos, &header_bg_size, &filter_color, debuginator->app_user_data);
+	debuginator__draw_rect(debuginator, &filter_pos, &header_bg_size, &filter_color);
 
 	DebuginatorVector2 header_pos = debuginator__vector2(filter_pos.x + DEBUGINATOR_FILTER_HEIGHT / 4, filter_pos.y + filter_size.y / 2);
 	DebuginatorColor header_color = debuginator->theme.colors[DEBUGINATOR_ItemTitleActive];
 	header_color.a = (unsigned char)(header_color.a * alpha);
-	debuginator->draw_text("Search: ", &header_pos, &header_color, &debuginator->theme.fonts[DEBUGINATOR_ItemTitleActive], debuginator->app_user_data);
+	debuginator__draw_text(debuginator, "Search: ", &header_pos, &header_color, &debuginator->theme.fonts[DEBUGINATOR_ItemTitleActive]);
 
 	DebuginatorVector2 text_pos = debuginator__vector2(filter_pos.x + header_bg_size.x + DEBUGINATOR_FILTER_HEIGHT / 4, header_pos.y);
 	if (DEBUGINATOR_strchr(debuginator->filter, ' ')) {
@@ -3566,19 +5649,19 @@ static void debuginator__draw_search_filter(struct TheDebuginator* debuginator,
 		char letter[2] = { 0 };
 		for (size_t i = 0; i < DEBUGINATOR_strlen(debuginator->filter); i++) {
 			letter[0] = debuginator->filter[i];
-			debuginator->draw_text(letter, &text_pos, &debuginator->theme.colors[DEBUGINATOR_ItemTitleActive], &debuginator->theme.fonts[DEBUGINATOR_ItemTitleActive], debuginator->app_user_data);
-			DebuginatorVector2 letter_text_size = debuginator->text_size(letter, &debuginator->theme.fonts[DEBUGINATOR_ItemTitleActive], debuginator->app_user_data);
+			debuginator__draw_text(debuginator, letter, &text_pos, &debuginator->theme.colors[DEBUGINATOR_ItemTitleActive], &debuginator->theme.fonts[DEBUGINATOR_ItemTitleActive]);
+			DebuginatorVector2 letter_text_size = debuginator__text_size(debuginator, letter, &debuginator->theme.fonts[DEBUGINATOR_ItemTitleActive]);
 			underline_size.x = letter_text_size.x;
 			if (letter[0] != ' ') {
 				DebuginatorVector2 underline_pos = debuginator__vector2(text_pos.x, text_pos.y);
-				debuginator->draw_rect(&underline_pos, &underline_size, &debuginator->theme.colors[DEBUGINATOR_ItemValueHot], debuginator->app_user_data);
+				debuginator__draw_rect(debuginator, &underline_pos, &underline_size, &debuginator->theme.colors[DEBUGINATOR_ItemValueHot]);
 			}
 			text_pos.x += letter_text_size.x;
 		}
 	}
 	else {
-		debuginator->draw_text(debuginator->filter, &text_pos, &debuginator->theme.colors[DEBUGINATOR_ItemTitleActive], &debuginator->theme.fonts[DEBUGINATOR_ItemTitleActive], debuginator->app_user_data);
-		DebuginatorVector2 filter_text_size = debuginator->text_size(debuginator->filter, &debuginator->theme.fonts[DEBUGINATOR_ItemTitleActive], debuginator->app_user_data);
+		debuginator__draw_text(debuginator, debuginator->filter, &text_pos, &debuginator->theme.colors[DEBUGINATOR_ItemTitleActive], &debuginator->theme.fonts[DEBUGINATOR_ItemTitleActive]);
+		DebuginatorVector2 filter_text_size = debuginator__text_size(debuginator, debuginator->filter, &debuginator->theme.fonts[DEBUGINATOR_ItemTitleActive]);
 		text_pos.x += filter_text_size.x;
 	}
 
@@ -3589,11 +5672,11 @@ static void debuginator__draw_search_filter(struct TheDebuginator* debuginator,
 		filter_color.g = 250;
 		filter_color.b = 150;
 		filter_color.a = alpha * DEBUGINATOR_sin(debuginator->draw_timer) < 0.5 ? 220u : 50u;
-		debuginator->draw_rect(&caret_pos, &caret_size, &filter_color, debuginator->app_user_data);
+		debuginator__draw_rect(debuginator, &caret_pos, &caret_size, &filter_color);
 	}
 	else if (filter_hint_mode) {
 		DebuginatorColor hint_color = header_color;
-		debuginator->draw_text("(backspace)", &text_pos, &hint_color, &debuginator->theme.fonts[DEBUGINATOR_ItemTitleActive], debuginator->app_user_data);
+		debuginator__draw_text(debuginator, "(backspace)", &text_pos, &hint_color, &debuginator->theme.fonts[DEBUGINATOR_ItemTitleActive]);
 	}
 
 	if (filter_pos.x <= debuginator->mouse_cursor_pos.x && debuginator->mouse_cursor_pos.x <= filter_pos.x + filter_size.x &&
@@ -3604,14 +5687,10 @@ static void debuginator__draw_search_filter(struct TheDebuginator* debuginator,
 		DebuginatorColor bg_color2 = debuginator->theme.colors[DEBUGINATOR_ItemTitleHot];
 		debuginator__draw_border(debuginator, &filter_pos, &filter_size, thickness, &bg_color1, &bg_color2);
 	}
-
-	debuginator->filter_pos = filter_pos;
-	debuginator->filter_size = filter_size;
 }
 
-void debuginator__draw_notifications(struct TheDebuginator* debuginator, float dt) {
+static void debuginator__draw_notifications(struct TheDebuginator* debuginator) {
 	if (!debuginator->notifications_enabled) {
-		debuginator->notification_count = 0;
 		return;
 	}
 
@@ -3619,21 +5698,24 @@ void debuginator__draw_notifications(struct TheDebuginator* debuginator, float d
 		return;
 	}
 
-	bool all_done = true;
+	if (debuginator->notification_count > 0) {
+		debuginator->draw_list_animating = true;
+	}
+
 	for (int i=0; i < debuginator->notification_count; ++i) {
 		float alpha = 240 * DEBUGINATOR_min(1, debuginator->notification_anims[i] * 2);
 		DebuginatorVector2 pos = debuginator__vector2(debuginator->notification_position.x, debuginator->notification_position.y + i * debuginator->item_height);
 		DebuginatorVector2 size = debuginator__vector2(DEBUGINATOR_NOTIFICATION_WIDTH, debuginator->item_height);
 		DebuginatorColor color = debuginator->theme.colors[DEBUGINATOR_Background];
 		color.a = (unsigned char)alpha;
-		debuginator->draw_rect(&pos, &size, &color, debuginator->app_user_data);
+		debuginator__draw_rect(debuginator, &pos, &size, &color);
 
 		pos.x += DEBUGINATOR_LEFT_MARGIN;
 		pos.y += debuginator->item_height / 2.0f;
 		color = debuginator->theme.colors[DEBUGINATOR_FolderTitle];
 		color.a = (unsigned char)alpha;
 		DebuginatorFont* font = &debuginator->theme.fonts[DEBUGINATOR_ItemTitleActive];
-		debuginator->draw_text(debuginator->notification_paths[i], &pos, &color, font, debuginator->app_user_data);
+		debuginator__draw_text(debuginator, debuginator->notification_paths[i], &pos, &color, font);
 
 		pos.x += DEBUGINATOR_NOTIFICATION_WIDTH - DEBUGINATOR_NOTIFICATION_VALUE_WIDTH - DEBUGINATOR_LEFT_MARGIN;
 		color = debuginator->theme.colors[DEBUGINATOR_ItemTitleOverridden];
@@ -3644,36 +5726,13 @@ void debuginator__draw_notifications(struct TheDebuginator* debuginator, float d
 			}
 		}
 		color.a = (unsigned char)alpha;
-		debuginator->draw_text(debuginator->notification_texts[i], &pos, &color, font, debuginator->app_user_data);
-
-		debuginator->notification_anims[i] += dt;
-		if (debuginator->notification_anims[i] < 2) {
-			all_done = false;
-		}
-	}
-
-	if (all_done) {
-		debuginator->notification_count = 0;
+		debuginator__draw_text(debuginator, debuginator->notification_texts[i], &pos, &color, font);
 	}
 }
 
-static void debuginator__draw_tooltip(struct TheDebuginator* debuginator, float dt) {
+static void debuginator__draw_tooltip(struct TheDebuginator* debuginator) {
+	// Faded in and out in debuginator__update_tooltip
 	DebuginatorItem* item = debuginator->hot_mouse_item;
-	if (item == NULL) {
-		debuginator->tooltip_timer = DEBUGINATOR_max(DEBUGINATOR_TOOLTIP_DELAY, debuginator->tooltip_timer - dt);
-	}
-	else if (item->is_folder || item->leaf.description[0] == '\0' ) {
-		if (debuginator->tooltip_timer >= 0) {
-			debuginator->tooltip_timer = DEBUGINATOR_max(0.f, debuginator->tooltip_timer - dt);
-		}
-		else {
-			debuginator->tooltip_timer = DEBUGINATOR_max(DEBUGINATOR_TOOLTIP_DELAY, debuginator->tooltip_timer - dt);
-		}
-	}
-	else {
-		debuginator->tooltip_timer = DEBUGINATOR_min(DEBUGINATOR_TOOLTIP_FADEIN, debuginator->tooltip_timer + dt);
-	}
-
 	if (debuginator->tooltip_timer <= 0) {
 		return;
 	}
@@ -3693,12 +5752,13 @@ static void debuginator__draw_tooltip(struct TheDebuginator* debuginator, float
 
 	int row_count = 0;
 	char description_line_to_draw[256];
-	int row_lengths[32];
+	int* row_lengths = NULL;
 	const char* description = "";
 	if (!item->is_folder) {
 		description = item->leaf.description;
-		float description_width = debuginator->size.x - DEBUGINATOR_LEFT_MARGIN * 2;
-		debuginator->word_wrap(description, &debuginator->theme.fonts[DEBUGINATOR_ItemDescription], description_width, &row_count, row_lengths, 32, debuginator->app_user_data);
+		DebuginatorWrapCacheEntry* wrapped = debuginator__find_wrapped_description(debuginator, item, debuginator__tooltip_width(debuginator));
+		row_count = wrapped != NULL ? wrapped->row_count : 0;
+		row_lengths = wrapped != NULL ? wrapped->row_lengths : NULL;
 	}
 
 	DebuginatorVector2 bg_size = debuginator__vector2(debuginator->size.x, row_count * debuginator->item_height + DEBUGINATOR_LEFT_MARGIN * 2);
@@ -3708,7 +5768,7 @@ static void debuginator__draw_tooltip(struct TheDebuginator* debuginator, float
 	}
 
 
-	debuginator->draw_rect(&bg_pos, &bg_size, &bg_color2, debuginator->app_user_data);
+	debuginator__draw_rect(debuginator, &bg_pos, &bg_size, &bg_color2);
 
 	float border_size = DEBUGINATOR_LEFT_MARGIN / 4.0f;
 	debuginator__draw_border(debuginator, &bg_pos, &bg_size, border_size, &bg_color1, &bg_color3);
@@ -3725,18 +5785,17 @@ static void debuginator__draw_tooltip(struct TheDebuginator* debuginator, float
 			++row_index;
 		}
 		DebuginatorVector2 description_pos = debuginator__vector2(text_pos.x, text_pos.y + i * debuginator->item_height + debuginator->item_height / 2.0f);
-		debuginator->draw_text(description_line_to_draw, &description_pos, &text_color, &debuginator->theme.fonts[DEBUGINATOR_ItemDescription], debuginator->app_user_data);
+		debuginator__draw_text(debuginator, description_line_to_draw, &description_pos, &text_color, &debuginator->theme.fonts[DEBUGINATOR_ItemDescription]);
 	}
 }
 
 static float debuginator__draw_item(struct TheDebuginator* debuginator, DebuginatorItem* item, DebuginatorVector2 offset, bool hot) {
+	++debuginator->frame_stats.items_drawn;
 	bool mouse_over =
 		debuginator->top_left.x <= debuginator->mouse_cursor_pos.x && debuginator->mouse_cursor_pos.x < debuginator->top_left.x + debuginator->size.x &&
 		offset.y <= debuginator->mouse_cursor_pos.y && debuginator->mouse_cursor_pos.y < offset.y + item->total_height;
 	hot = hot || mouse_over;
 
-	// Set hot mouse item here. Yes, in draw.. it's easiest!
-	debuginator->hot_mouse_item = mouse_over ? item : debuginator->hot_mouse_item;
 	float half_height = debuginator->item_height / 2.0f;
 	float quarter_height = debuginator->item_height / 4.0f;
 
@@ -3749,29 +5808,30 @@ static float debuginator__draw_item(struct TheDebuginator* debuginator, Debugina
 		if (mouse_over || debuginator->hot_item == item) {
 			DebuginatorVector2 highlight_pos = debuginator__vector2(debuginator->top_left.x, offset.y);
 			DebuginatorVector2 highlight_size = debuginator__vector2(debuginator->size.x, (float)debuginator->item_height);
-			debuginator->draw_rect(&highlight_pos, &highlight_size, &debuginator->theme.colors[mouse_over ? DEBUGINATOR_LineHighlightMouse : DEBUGINATOR_LineHighlight], debuginator->app_user_data);
+			debuginator__draw_rect(debuginator, &highlight_pos, &highlight_size, &debuginator->theme.colors[mouse_over ? DEBUGINATOR_LineHighlightMouse : DEBUGINATOR_LineHighlight]);
 		}
 
 		unsigned color_index = item == debuginator->hot_item ? DEBUGINATOR_ItemTitleActive : (hot ? DEBUGINATOR_ItemTitleHot : DEBUGINATOR_FolderTitle);
 		DebuginatorVector2 text_pos = debuginator__vector2(offset.x, offset.y + half_height);
-		debuginator->draw_text(item->title, &text_pos, &debuginator->theme.colors[color_index], &debuginator->theme.fonts[DEBUGINATOR_ItemTitle], debuginator->app_user_data);
+		debuginator__draw_text(debuginator, item->title, &text_pos, &debuginator->theme.colors[color_index], &debuginator->theme.fonts[DEBUGINATOR_ItemTitle]);
 		if (item->folder.is_collapsed) {
 			DebuginatorVector2 collapsed_box_pos1 = debuginator__vector2(offset.x - half_height - quarter_height / 2.0f, offset.y + half_height - quarter_height / 2.0f);
 			DebuginatorVector2 collapsed_box_size1 = debuginator__vector2(half_height, quarter_height);
 			DebuginatorVector2 collapsed_box_size2 = debuginator__vector2(quarter_height, quarter_height / 2.0f);
 			DebuginatorVector2 collapsed_box_pos2 = debuginator__vector2(collapsed_box_pos1.x + quarter_height / 4.0f, collapsed_box_pos1.y - collapsed_box_size2.y + quarter_height / 8);
-			debuginator->draw_rect(&collapsed_box_pos1, &collapsed_box_size1, &debuginator->theme.colors[color_index], debuginator->app_user_data);
-			debuginator->draw_rect(&collapsed_box_pos2, &collapsed_box_size2, &debuginator->theme.colors[color_index], debuginator->app_user_data);
+			debuginator__draw_rect(debuginator, &collapsed_box_pos1, &collapsed_box_size1, &debuginator->theme.colors[color_index]);
+			debuginator__draw_rect(debuginator, &collapsed_box_pos2, &collapsed_box_size2, &debuginator->theme.colors[color_index]);
 		}
 
 		offset.x += DEBUGINATOR_INDENT;
-		DebuginatorItem* child = debuginator__first_visible_child(item);
 		offset.y += debuginator->item_height;
+		DebuginatorItem* child = debuginator__skip_children_above(item, &offset.y, 0);
 		while (child) {
 			if (offset.y > debuginator->size.y) {
 				break;
 			}
 
+			++debuginator->frame_stats.items_visited;
 			if (offset.y + child->total_height > 0) {
 				debuginator__draw_item(debuginator, child, offset, debuginator->hot_item == child);
 			}
@@ -3780,16 +5840,16 @@ static float debuginator__draw_item(struct TheDebuginator* debuginator, Debugina
 		}
 	}
 	else {
-		if (item->leaf.is_expanded && mouse_over && debuginator->hot_mouse_item_index == DEBUGINATOR_NO_HOT_INDEX) {
+		if (item->leaf.is_expanded && mouse_over) {
 			DebuginatorVector2 highlight_pos = debuginator__vector2(debuginator->top_left.x, offset.y);
-			DebuginatorVector2 highlight_size = debuginator__vector2(debuginator->size.x, (float)debuginator->item_height * (1 + item->leaf.description_line_count));
-			debuginator->draw_rect(&highlight_pos, &highlight_size, &debuginator->theme.colors[DEBUGINATOR_LineHighlightMouse], debuginator->app_user_data);
+			DebuginatorVector2 highlight_size = debuginator__vector2(debuginator->size.x, (float)debuginator->item_height * (1 + DEBUGINATOR_max(0, item->leaf.description_line_count)));
+			debuginator__draw_rect(debuginator, &highlight_pos, &highlight_size, &debuginator->theme.colors[DEBUGINATOR_LineHighlightMouse]);
 		}
 
 		if (hot && (!item->leaf.is_expanded || item->leaf.num_values == 0)) {
 			DebuginatorVector2 highlight_pos = debuginator__vector2(debuginator->top_left.x, offset.y);
 			DebuginatorVector2 highlight_size = debuginator__vector2(debuginator->size.x, (float)debuginator->item_height);
-			debuginator->draw_rect(&highlight_pos, &highlight_size, &debuginator->theme.colors[mouse_over ? DEBUGINATOR_LineHighlightMouse : DEBUGINATOR_LineHighlight], debuginator->app_user_data);
+			debuginator__draw_rect(debuginator, &highlight_pos, &highlight_size, &debuginator->theme.colors[mouse_over ? DEBUGINATOR_LineHighlightMouse : DEBUGINATOR_LineHighlight]);
 		}
 
 		bool is_overriden = item->leaf.active_index != item->leaf.default_index && !debuginator->edit_types[(int)item->leaf.edit_type].forget_state;
@@ -3797,39 +5857,29 @@ static float debuginator__draw_item(struct TheDebuginator* debuginator, Debugina
 		unsigned color_index = hot ? DEBUGINATOR_ItemTitleActive : default_color_index;
 		DebuginatorFont* font = &debuginator->theme.fonts[DEBUGINATOR_ItemTitle];
 		DebuginatorVector2 text_pos = debuginator__vector2(offset.x, offset.y + half_height);
-		debuginator->draw_text(item->title, &text_pos, &debuginator->theme.colors[color_index], font, debuginator->app_user_data);
+		debuginator__draw_text(debuginator, item->title, &text_pos, &debuginator->theme.colors[color_index], font);
 
 		if (debuginator->edit_types[(int)item->leaf.edit_type].quick_draw != NULL) {
 			debuginator->edit_types[(int)item->leaf.edit_type].quick_draw(debuginator, item, &offset);
 		}
 
-		if (item->leaf.hot_key_index != DEBUGINATOR_NO_HOT_INDEX
-			&& (debuginator->hot_keys[item->leaf.hot_key_index].value_index == DEBUGINATOR_NO_HOT_INDEX || !item->leaf.is_expanded)) {
-			const char* key = debuginator->hot_keys[item->leaf.hot_key_index].key;
-			int hot_key_value_index = debuginator->hot_keys[item->leaf.hot_key_index].value_index;
-			char hot_key_text[DEBUGINATOR_MAX_PATH_LENGTH];
-			if (hot_key_value_index == DEBUGINATOR_NO_HOT_INDEX) {
-				DEBUGINATOR_sprintf_s(hot_key_text, DEBUGINATOR_MAX_PATH_LENGTH, "%s", key);
-			}
-			else {
-				DEBUGINATOR_sprintf_s(hot_key_text, DEBUGINATOR_MAX_PATH_LENGTH, "%s: %s", key, item->leaf.value_titles[hot_key_value_index]);
-			}
-
+		char hot_key_text[DEBUGINATOR_MAX_PATH_LENGTH];
+		if (debuginator__hot_key_label(debuginator, item, hot_key_text)) {
 			if (debuginator->open_direction == 1) {
 				DebuginatorVector2 key_rect_pos = debuginator__vector2(debuginator->top_left.x + debuginator->size.x, offset.y);
-				DebuginatorVector2 key_rect_size = debuginator__vector2(debuginator->text_size(hot_key_text, font, debuginator->app_user_data).x + 20, (float)debuginator->item_height);
-				debuginator->draw_rect(&key_rect_pos, &key_rect_size, &debuginator->theme.colors[DEBUGINATOR_Background], debuginator->app_user_data);
+				DebuginatorVector2 key_rect_size = debuginator__vector2(debuginator__text_size(debuginator, hot_key_text, font).x + 20, (float)debuginator->item_height);
+				debuginator__draw_rect(debuginator, &key_rect_pos, &key_rect_size, &debuginator->theme.colors[DEBUGINATOR_Background]);
 
 				DebuginatorVector2 key_text_pos = debuginator__vector2(debuginator->top_left.x + debuginator->size.x + 10, offset.y + half_height);
-				debuginator->draw_text(hot_key_text, &key_text_pos, &debuginator->theme.colors[DEBUGINATOR_ItemTitleOverridden], font, debuginator->app_user_data);
+				debuginator__draw_text(debuginator, hot_key_text, &key_text_pos, &debuginator->theme.colors[DEBUGINATOR_ItemTitleOverridden], font);
 			}
 			else {
-				DebuginatorVector2 key_rect_size = debuginator__vector2(debuginator->text_size(hot_key_text, font, debuginator->app_user_data).x + 20, (float)debuginator->item_height);
+				DebuginatorVector2 key_rect_size = debuginator__vector2(debuginator__text_size(debuginator, hot_key_text, font).x + 20, (float)debuginator->item_height);
 				DebuginatorVector2 key_rect_pos = debuginator__vector2(debuginator->top_left.x - key_rect_size.x, offset.y);
-				debuginator->draw_rect(&key_rect_pos, &key_rect_size, &debuginator->theme.colors[DEBUGINATOR_Background], debuginator->app_user_data);
+				debuginator__draw_rect(debuginator, &key_rect_pos, &key_rect_size, &debuginator->theme.colors[DEBUGINATOR_Background]);
 
 				DebuginatorVector2 key_text_pos = debuginator__vector2(key_rect_pos.x + 10, offset.y + half_height);
-				debuginator->draw_text(hot_key_text, &key_text_pos, &debuginator->theme.colors[DEBUGINATOR_ItemTitleOverridden], font, debuginator->app_user_data);
+				debuginator__draw_text(debuginator, hot_key_text, &key_text_pos, &debuginator->theme.colors[DEBUGINATOR_ItemTitleOverridden], font);
 			}
 		}
 
@@ -3837,15 +5887,16 @@ static float debuginator__draw_item(struct TheDebuginator* debuginator, Debugina
 			offset.x += DEBUGINATOR_INDENT;
 
 			const char* description = item->leaf.description;
-			float description_width = debuginator->size.x - 50 + debuginator->top_left.x - offset.x;
 			char description_line_to_draw[256];
-			int description_height = 0;
-			int row_lengths[32];
-			int row_count = 0;
-			debuginator->word_wrap(description, &debuginator->theme.fonts[DEBUGINATOR_ItemDescription], description_width, &row_count, row_lengths, 32, debuginator->app_user_data);
+			DebuginatorWrapCacheEntry* wrapped = debuginator__find_wrapped_description(debuginator, item, debuginator__description_width(debuginator, item));
+			if (wrapped == NULL) {
+				// Expanded after the update. Leaves its rows empty until the next one.
+				offset.y += debuginator->item_height * DEBUGINATOR_max(0, item->leaf.description_line_count);
+			}
+
 			size_t row_index = 0;
-			for (int i = 0; i < row_count; i++) {
-				int row_index_end = row_index + row_lengths[i];
+			for (int i = 0; wrapped != NULL && i < wrapped->row_count; i++) {
+				int row_index_end = row_index + wrapped->row_lengths[i];
 				const char* description_line = description + row_index;
 				DEBUGINATOR_strncpy_s(description_line_to_draw, 256u, description_line, DEBUGINATOR_min(row_index_end - row_index, 256u));
 				row_index = row_index_end;
@@ -3853,14 +5904,10 @@ static float debuginator__draw_item(struct TheDebuginator* debuginator, Debugina
 					++row_index;
 				}
 				offset.y += debuginator->item_height;
-				description_height += debuginator->item_height;
 				DebuginatorVector2 description_pos = debuginator__vector2(offset.x, offset.y + half_height);
-				debuginator->draw_text(description_line_to_draw, &description_pos, &debuginator->theme.colors[DEBUGINATOR_ItemDescription], &debuginator->theme.fonts[DEBUGINATOR_ItemDescription], debuginator->app_user_data);
+				debuginator__draw_text(debuginator, description_line_to_draw, &description_pos, &debuginator->theme.colors[DEBUGINATOR_ItemDescription], &debuginator->theme.fonts[DEBUGINATOR_ItemDescription]);
 			}
 
-			// Feels kinda ugly to do this here but... works for now.
-			debuginator__set_total_height(item, debuginator->item_height + description_height + debuginator->item_height * (item->leaf.num_values));
-
 			debuginator->edit_types[(int)item->leaf.edit_type].expanded_draw(debuginator, item, &offset);
 		}
 	}
@@ -3872,9 +5919,11 @@ static void debuginator__draw_sorted_filter(struct TheDebuginator* debuginator,
 	DEBUGINATOR_UNUSED(dt);
 	DebuginatorSortedItem* sorted_item = debuginator->best_sorted_item;
 	while (sorted_item && sorted_item->score > 0) {
+		++debuginator->frame_stats.items_visited;
+		++debuginator->frame_stats.items_drawn;
 		DebuginatorItem* item = sorted_item->item;
 		DebuginatorVector2 text_pos = debuginator__vector2(offset.x, offset.y + debuginator->item_height / 2.0f);
-		debuginator->draw_text(item->title, &text_pos, &debuginator->theme.colors[DEBUGINATOR_ItemDescription], &debuginator->theme.fonts[DEBUGINATOR_ItemDescription], debuginator->app_user_data);
+		debuginator__draw_text(debuginator, item->title, &text_pos, &debuginator->theme.colors[DEBUGINATOR_ItemDescription], &debuginator->theme.fonts[DEBUGINATOR_ItemDescription]);
 		offset.y += debuginator->item_height;
 		sorted_item = sorted_item->next;
 	}
@@ -3934,10 +5983,79 @@ void debuginator_log_item(struct TheDebuginator* debuginator, DebuginatorItem* i
 }
 
 
+void debuginator_set_item_changed_listener(struct TheDebuginator* debuginator, DebuginatorOnItemChangedCallback listener, void* userdata) {
+	debuginator->item_changed_listener = listener;
+	debuginator->item_changed_listener_userdata = userdata;
+}
+
+static void debuginator__call_item_callback(struct TheDebuginator* debuginator, DebuginatorItem* item) {
+	void* value = item->leaf.values;
+	const char* value_title = NULL;
+	if (item->leaf.num_values > 0) {
+		value = ((char*)item->leaf.values) + item->leaf.active_index * item->leaf.array_element_size;
+		value_title = item->leaf.value_titles[item->leaf.active_index];
+	}
+
+	++debuginator->frame_stats.item_callbacks;
+	DEBUGINATOR_PROFILE_BEGIN_ITEM(debuginator, DEBUGINATOR_ProfileItemCallbacks, item);
+	item->leaf.on_item_changed_callback(item, value, value_title, debuginator->app_user_data);
+	DEBUGINATOR_PROFILE_END_ITEM(debuginator, DEBUGINATOR_ProfileItemCallbacks, item);
+}
+
+// Calls it right away unless callbacks are put off.
+static void debuginator__item_changed(struct TheDebuginator* debuginator, DebuginatorItem* item) {
+	DebuginatorCallbackBuffer* buffer = debuginator->callback_buffer;
+	if (buffer == NULL) {
+		debuginator__call_item_callback(debuginator, item);
+		return;
+	}
+
+	if (item->is_callback_pending) {
+		return;
+	}
+
+	if (buffer->count == buffer->capacity) {
+		buffer->overflowed = true;
+		debuginator__call_item_callback(debuginator, item);
+		return;
+	}
+
+	item->is_callback_pending = true;
+	buffer->items[buffer->count++] = item;
+}
+
+void debuginator_set_callback_buffer(struct TheDebuginator* debuginator, DebuginatorCallbackBuffer* buffer) {
+	debuginator_run_callbacks(debuginator);
+	debuginator->callback_buffer = buffer;
+}
+
+int debuginator_run_callbacks(struct TheDebuginator* debuginator) {
+	DebuginatorCallbackBuffer* buffer = debuginator->callback_buffer;
+	if (buffer == NULL) {
+		return 0;
+	}
+
+	// Callbacks, like presets', can change more items, which are added to the end and run too.
+	int num_callbacks = 0;
+	for (; num_callbacks < buffer->count; ++num_callbacks) {
+		DebuginatorItem* item = buffer->items[num_callbacks];
+		item->is_callback_pending = false;
+		debuginator__call_item_callback(debuginator, item);
+	}
+
+	buffer->count = 0;
+	return num_callbacks;
+}
+
 void debuginator_activate(struct TheDebuginator* debuginator, DebuginatorItem* item, bool animate) {
+	debuginator__mark_dirty(debuginator);
 	item->leaf.draw_t = 0;
 	if (item->leaf.num_values <= 0) {
 		// "Action" items doesn't have a list of values, they just get triggered
+		if (debuginator->item_changed_listener != NULL) {
+			debuginator->item_changed_listener(item, item->leaf.values, NULL, debuginator->item_changed_listener_userdata);
+		}
+
 		if (item->leaf.on_item_changed_callback != NULL) {
 			// void* value = item->leaf.num_values == DEBUGINATOR_CUSTOM_VALUE_STATE_COUNT ? item->leaf.values : NULL;
 			debuginator_log_item(debuginator, item);
@@ -3949,7 +6067,7 @@ void debuginator_activate(struct TheDebuginator* debuginator, DebuginatorItem* i
 				DEBUGINATOR_strcpy_s(debuginator->notification_texts[debuginator->notification_count], DEBUGINATOR_MAX_NOTIFICATION_TEXT, "Triggered");
 				debuginator->notification_count++;
 			}
-			item->leaf.on_item_changed_callback(item, item->leaf.values, NULL, debuginator->app_user_data);
+			debuginator__item_changed(debuginator, item);
 		}
 		return;
 	}
@@ -3973,15 +6091,19 @@ void debuginator_activate(struct TheDebuginator* debuginator, DebuginatorItem* i
 				parent = parent->parent;
 			}
 
-			int y_dist_to_root = 0;
-			debuginator__distance_to_hot_item(debuginator->root, item, debuginator->item_height, &y_dist_to_root);
+			int y_dist_to_root = debuginator__distance_to_item(debuginator, item);
 			animation->data.item_activate.start_pos.y = y_dist_to_root + debuginator->current_height_offset - debuginator->item_height / 2;
 			if (item->leaf.is_expanded) {
-				animation->data.item_activate.start_pos.y += debuginator->item_height * item->leaf.description_line_count;
+				animation->data.item_activate.start_pos.y += debuginator->item_height * DEBUGINATOR_max(0, item->leaf.description_line_count);
 			}
 		}
 	}
 
+	void* value = ((char*)item->leaf.values) + hot_index * item->leaf.array_element_size;
+	if (debuginator->item_changed_listener != NULL) {
+		debuginator->item_changed_listener(item, value, item->leaf.value_titles[hot_index], debuginator->item_changed_listener_userdata);
+	}
+
 	if (item->leaf.on_item_changed_callback == NULL) {
 		return;
 	}
@@ -3990,8 +6112,7 @@ void debuginator_activate(struct TheDebuginator* debuginator, DebuginatorItem* i
 		debuginator__add_notification(debuginator, item);
 	}
 
-	void* value = ((char*)item->leaf.values) + hot_index * item->leaf.array_element_size;
-	item->leaf.on_item_changed_callback(item, value, item->leaf.value_titles[hot_index], debuginator->app_user_data);
+	debuginator__item_changed(debuginator, item);
 }
 
 bool debuginator_is_collapsed(DebuginatorItem* item) {
@@ -4012,6 +6133,7 @@ static bool debuginator__is_parent_recursive(DebuginatorItem* item, DebuginatorI
 }
 
 void debuginator_set_collapsed(struct TheDebuginator* debuginator, DebuginatorItem* item, bool collapsed) {
+	debuginator__mark_dirty(debuginator);
 	if (!item->is_folder) {
 		return;
 	}
@@ -4021,8 +6143,9 @@ void debuginator_set_collapsed(struct TheDebuginator* debuginator, DebuginatorIt
 	}
 
 	item->folder.is_collapsed = collapsed;
+	debuginator__layout_changed(debuginator, item->parent);
+	debuginator__invalidate_layout(debuginator, item);
 	if (collapsed) {
-		debuginator__set_total_height(item, debuginator->item_height);
 		if (debuginator__is_parent_recursive(debuginator->hot_item, item)) {
 			DebuginatorItem* temp_item = item;
 			while (temp_item->folder.is_collapsed) {
@@ -4036,15 +6159,6 @@ void debuginator_set_collapsed(struct TheDebuginator* debuginator, DebuginatorIt
 			}
 		}
 	}
-	else {
-		int height = debuginator->item_height;
-		DebuginatorItem* child = debuginator__first_visible_child(item);
-		while (child != NULL) {
-			height += child->total_height;
-			child = debuginator__next_visible_sibling(child);
-		}
-		debuginator__set_total_height(item, height);
-	}
 }
 
 static void debuginator__collapse_recursive(struct TheDebuginator* debuginator, DebuginatorItem *item, int collapse_depth, int depth) {
@@ -4197,6 +6311,7 @@ void debuginator_move_to_prev_leaf(struct TheDebuginator* debuginator, bool long
 }
 
 void debuginator_move_to_child(struct TheDebuginator* debuginator, bool toggle_and_activate) {
+	debuginator__mark_dirty(debuginator);
 	DebuginatorItem* hot_item = debuginator->hot_item;
 	DebuginatorItem* hot_item_new = debuginator->hot_item;
 
@@ -4213,7 +6328,7 @@ void debuginator_move_to_child(struct TheDebuginator* debuginator, bool toggle_a
 		}
 		else {
 			hot_item->leaf.is_expanded = true;
-			debuginator__set_total_height(hot_item, debuginator->item_height * (hot_item->leaf.num_values) + debuginator->item_height); // for description, HACK! :(
+			debuginator__invalidate_layout(debuginator, hot_item);
 		}
 	}
 	else {
@@ -4237,11 +6352,12 @@ void debuginator_move_to_child(struct TheDebuginator* debuginator, bool toggle_a
 }
 
 void debuginator_move_to_parent(struct TheDebuginator* debuginator) {
+	debuginator__mark_dirty(debuginator);
 	DebuginatorItem* hot_item = debuginator->hot_item;
 	DebuginatorItem* hot_item_new = debuginator->hot_item;
 	if (!hot_item->is_folder && hot_item->leaf.is_expanded) {
 		hot_item->leaf.is_expanded = false;
-		debuginator__set_total_height(hot_item, debuginator->item_height);
+		debuginator__invalidate_layout(debuginator, hot_item);
 	}
 	else if (hot_item->parent != debuginator->root) {
 		hot_item_new = debuginator->hot_item->parent;
@@ -4257,7 +6373,7 @@ void debuginator_move_to_root(struct TheDebuginator* debuginator) {
 	DebuginatorItem* hot_item = debuginator->hot_item;
 	if (!hot_item->is_folder && hot_item->leaf.is_expanded) {
 		hot_item->leaf.is_expanded = false;
-		debuginator__set_total_height(hot_item, debuginator->item_height);
+		debuginator__invalidate_layout(debuginator, hot_item);
 	}
 
 	// We're now in the root, select the first child
@@ -4274,15 +6390,59 @@ void debuginator_move_to_root(struct TheDebuginator* debuginator) {
 void debuginator_copy_1byte(DebuginatorItem* item, void* value, const char* value_title, void* app_userdata) {
 	(void)value_title;
 	(void)app_userdata;
-	DEBUGINATOR_memcpy(item->user_data, value, 1);
+	if (item->user_data != NULL) {
+		DEBUGINATOR_memcpy(item->user_data, value, 1);
+	}
+}
+
+// Shared by every bool item, in every Debuginator, so that staged ones can be moved.
+static bool debuginator__bool_values[2] = { false, true };
+static const char* debuginator__bool_titles[2] = { "False", "True" };
+
+void debuginator_publish_value(DebuginatorItem* item, void* value, const char* value_title, void* app_userdata) {
+	(void)value_title;
+	(void)app_userdata;
+	if (item->user_data == NULL || value == NULL) {
+		return;
+	}
+
+	// Copied whole, so a reader gets either all of the old value or all of the new one.
+	unsigned long long bits = 0;
+	int size = item->leaf.array_element_size < (int)sizeof(bits) ? item->leaf.array_element_size : (int)sizeof(bits);
+	DEBUGINATOR_memcpy(&bits, value, (size_t)size);
+	DEBUGINATOR_atomic_store64(&((DebuginatorPublishedValue*)item->user_data)->bits, bits);
+}
+
+void debuginator_read_value(const DebuginatorPublishedValue* published, void* value, int size) {
+	unsigned long long bits = DEBUGINATOR_atomic_load64(&published->bits);
+	DEBUGINATOR_assert(size <= (int)sizeof(bits));
+	DEBUGINATOR_memcpy(value, &bits, (size_t)size);
+}
+
+bool debuginator_read_bool(const DebuginatorPublishedValue* published) {
+	bool value;
+	debuginator_read_value(published, &value, sizeof(value));
+	return value;
+}
+
+int debuginator_read_int(const DebuginatorPublishedValue* published) {
+	int value;
+	debuginator_read_value(published, &value, sizeof(value));
+	return value;
+}
+
+float debuginator_read_float(const DebuginatorPublishedValue* published) {
+	float value;
+	debuginator_read_value(published, &value, sizeof(value));
+	return value;
 }
 
 DebuginatorItem* debuginator_create_bool_item(struct TheDebuginator* debuginator, const char* path, const char* description, void* user_data) {
-	bool value_before_creation = *(bool*)user_data;
-	DEBUGINATOR_static_assert(sizeof(debuginator->bool_values[0]) == 1);
+	bool value_before_creation = user_data != NULL && *(bool*)user_data;
+	DEBUGINATOR_static_assert(sizeof(debuginator__bool_values[0]) == 1);
 	DebuginatorItem* item = debuginator_create_array_item(debuginator, NULL, path,
 		description, debuginator_copy_1byte, user_data,
-		debuginator->bool_titles, debuginator->bool_values, 2, sizeof(debuginator->bool_values[0]));
+		debuginator__bool_titles, debuginator__bool_values, 2, sizeof(debuginator__bool_values[0]));
 	item->leaf.edit_type = DEBUGINATOR_EditTypeBoolean;
 
 	if (value_before_creation == true) {
@@ -4299,11 +6459,11 @@ DebuginatorItem* debuginator_create_bool_item(struct TheDebuginator* debuginator
 }
 
 DebuginatorItem* debuginator_create_bool_item_with_callback(struct TheDebuginator* debuginator, const char* path, const char* description, void* user_data, DebuginatorOnItemChangedCallback callback) {
-	bool value_before_creation = *(bool*)user_data;
-	DEBUGINATOR_static_assert(sizeof(debuginator->bool_values[0]) == 1);
+	bool value_before_creation = user_data != NULL && *(bool*)user_data;
+	DEBUGINATOR_static_assert(sizeof(debuginator__bool_values[0]) == 1);
 	DebuginatorItem* item = debuginator_create_array_item(debuginator, NULL, path,
 		description, callback, user_data,
-		debuginator->bool_titles, debuginator->bool_values, 2, sizeof(debuginator->bool_values[0]));
+		debuginator__bool_titles, debuginator__bool_values, 2, sizeof(debuginator__bool_values[0]));
 	item->leaf.edit_type = DEBUGINATOR_EditTypeBoolean;
 
 	if (value_before_creation == true) {
@@ -4346,6 +6506,11 @@ static void debuginator__activate_preset(DebuginatorItem* item, void* value, con
 	item->leaf.active_index = 0;
 }
 
+DebuginatorItem* debuginator_create_published_bool_item(struct TheDebuginator* debuginator, const char* path, const char* description, DebuginatorPublishedValue* published) {
+	// The bool is the first byte, and only this thread writes to it.
+	return debuginator_create_bool_item_with_callback(debuginator, path, description, published, debuginator_publish_value);
+}
+
 DebuginatorItem* debuginator_create_preset_item(struct TheDebuginator* debuginator, const char* path, const char** paths, const char** value_titles, int** value_indices, int num_paths) {
 	(void)value_indices; // TODO
 
@@ -28,6 +28,11 @@ In *ONE* source file, put:
 Depending on if its in a binary that has actual access to the debuginator,
 also #define DEBUGINATOR_QUEUE_CAN_PROCEES
 
+To share a queue between processes, also #define DEBUGINATOR_QUEUE_SHARED_MEMORY
+(On Linux, link with -lrt. It uses shm_open, ftruncate and mmap, which aren't in plain
+C99, so with -std=c99 also #define _POSIX_C_SOURCE 200112L before including anything,
+or build with -std=gnu99.)
+
 Other source files should just include the_debuginator_queue.h
 
 ## Notes
@@ -67,28 +72,159 @@ extern "C" {
 #endif
 #endif
 
-#define DEBUGINATOR_QUEUE_MAX_PATH_LENGTH 128
-#define DEBUGINATOR_QUEUE_MAX_DESCRIPTION_LENGTH 512
-
 typedef enum DebuginatorQueueItemTypes {
-  DEBUGINATOR_QUEUE_CreateItem,
+  DEBUGINATOR_QUEUE_CreateItem, // Bool item
+  DEBUGINATOR_QUEUE_CreateArrayItem,
+  DEBUGINATOR_QUEUE_CreateNumberRangeFloatItem,
+  DEBUGINATOR_QUEUE_CreateColorPickerItem,
+  DEBUGINATOR_QUEUE_CreatePresetItem,
+  DEBUGINATOR_QUEUE_RemoveItem,
+  DEBUGINATOR_QUEUE_SetDefaultValue,
+  DEBUGINATOR_QUEUE_LoadItem,
+  DEBUGINATOR_QUEUE_AssignHotKey,
+  DEBUGINATOR_QUEUE_UnassignHotKey,
   DEBUGINATOR_QUEUE_NumItemTypes
 } DebuginatorQueueItemTypes;
 
+// Strings are copied into the queue, right after the operation's data, and are referred to by
+// where they are in the record. Other pointers, like an array item's values and value titles,
+// are passed on as they are and need to live as long as the item, just like when creating it
+// directly.
+typedef struct {
+  unsigned int offset; // From the start of the record, it's zero terminated
+  unsigned int length; // Not counting the terminator
+} DebuginatorQueueString;
+
 typedef struct {
-  char                             path[DEBUGINATOR_QUEUE_MAX_PATH_LENGTH];
-  char                             description[DEBUGINATOR_QUEUE_MAX_DESCRIPTION_LENGTH];
+  DebuginatorQueueString           path;
+  DebuginatorQueueString           description;
   void*                            userdata;
   DebuginatorOnItemChangedCallback callback;
 } DebuginatorQueue_CreateItemData;
 
+typedef struct {
+  DebuginatorQueueString           path;
+  DebuginatorQueueString           description;
+  void*                            userdata;
+  DebuginatorOnItemChangedCallback callback;
+  const char**                     value_titles;
+  void*                            values;
+  int                              num_values;
+  int                              value_size;
+} DebuginatorQueue_CreateArrayItemData;
+
+typedef struct {
+  DebuginatorQueueString path;
+  DebuginatorQueueString description;
+  float*                 userdata; // Its value when processed is the default
+  float                  range_min;
+  float                  range_max;
+} DebuginatorQueue_CreateNumberRangeFloatItemData;
+
+typedef struct {
+  DebuginatorQueueString           path;
+  DebuginatorQueueString           description;
+  void*                            userdata;
+  DebuginatorOnItemChangedCallback callback;
+  DebuginatorColor                 start_color;
+} DebuginatorQueue_CreateColorPickerItemData;
+
+typedef struct {
+  DebuginatorQueueString path;
+  const char**           paths;
+  const char**           value_titles;
+  int                    num_paths;
+} DebuginatorQueue_CreatePresetItemData;
+
+typedef struct {
+  DebuginatorQueueString path;
+} DebuginatorQueue_RemoveItemData;
+
+// For setting default values and loading settings.
+typedef struct {
+  DebuginatorQueueString path;
+  DebuginatorQueueString value_title;
+  bool                   has_value_title;
+  int                    value_index;
+} DebuginatorQueue_SetValueData;
+
+typedef struct {
+  DebuginatorQueueString key;
+  DebuginatorQueueString path;
+  DebuginatorQueueString value_title;
+  bool                   has_value_title;
+  int                    value_index;
+} DebuginatorQueue_HotKeyData;
+
+// A record in the queue's data. Only as much of the union as the type needs is there, followed
+// by the strings. Records are aligned to DEBUGINATOR_QUEUE_RECORD_ALIGNMENT bytes.
 typedef struct DebuginatorQueueItem {
   DebuginatorQueueItemTypes type;
+  unsigned int              size; // Of the whole record, including the strings
   union {
-    DebuginatorQueue_CreateItemData create_item;
+    DebuginatorQueue_CreateItemData                 create_item;
+    DebuginatorQueue_CreateArrayItemData            create_array_item;
+    DebuginatorQueue_CreateNumberRangeFloatItemData create_numberrange_float_item;
+    DebuginatorQueue_CreateColorPickerItemData      create_colorpicker_item;
+    DebuginatorQueue_CreatePresetItemData           create_preset_item;
+    DebuginatorQueue_RemoveItemData                 remove_item;
+    DebuginatorQueue_SetValueData                   set_value;
+    DebuginatorQueue_HotKeyData                     hot_key;
   } data;
 } DebuginatorQueueItem;
 
+#define DEBUGINATOR_QUEUE_RECORD_ALIGNMENT 8
+
+// The shared state of a ring queue, which its data follows. It only has offsets, no pointers.
+// The producers' and the consumer's cursors are on their own cache lines.
+typedef struct DebuginatorQueueRing {
+  volatile unsigned int reserved; // Producers reserve space by moving this forward
+  unsigned char         reserved_padding[60];
+  volatile unsigned int read; // The consumer frees space by moving this forward
+  unsigned int          capacity; // Bytes of data, a power of two
+  volatile unsigned int dropped;  // Operations that didn't fit
+  volatile unsigned int magic;    // Set last, when the ring is ready to be shared
+  unsigned char         read_padding[48];
+} DebuginatorQueueRing;
+
+#define DEBUGINATOR_QUEUE_SHARED_MAGIC 0xdeb0ca11u
+
+#ifndef DEBUGINATOR_QUEUE_STUCK_DRAINS
+#define DEBUGINATOR_QUEUE_STUCK_DRAINS 600
+#endif
+#define DEBUGINATOR_QUEUE_MAX_SHARED_NAME_LENGTH 64
+
+#define DEBUGINATOR_QUEUE_CHANGE_VALUE_SIZE 16
+
+// An item was activated.
+typedef struct DebuginatorQueueChangeEvent {
+  unsigned int  item_id;     // debuginator_queue_path_id of the item's path
+  int           value_index; // The new active_index, or -1 for action items
+  double        time;        // From The Debuginator's config.get_time, 0 without it
+  unsigned int  value_size;  // The first bytes of the new value are in value, up to 16 of them
+  unsigned char value[DEBUGINATOR_QUEUE_CHANGE_VALUE_SIZE];
+} DebuginatorQueueChangeEvent;
+
+typedef struct DebuginatorQueueChangeSlot {
+  volatile unsigned int       sequence; // The event's number plus one, 0 while it's being written
+  unsigned int                padding;
+  DebuginatorQueueChangeEvent event;
+} DebuginatorQueueChangeSlot;
+
+// The shared state of a change queue, which its slots follow. Like a ring, it has no pointers.
+typedef struct DebuginatorQueueChanges {
+  volatile unsigned int written;  // How many events there have been
+  unsigned int          capacity; // Slots, a power of two
+  volatile unsigned int magic;    // Set last, when it's ready to be shared
+  unsigned char         padding[52];
+} DebuginatorQueueChanges;
+
+// Each reader of a change queue has one of these, and reads at its own pace.
+typedef struct DebuginatorQueueChangeReader {
+  unsigned int read; // The next event
+  int          lost; // Events that were overwritten before they could be read
+} DebuginatorQueueChangeReader;
+
 typedef struct TheDebuginatorQueue TheDebuginatorQueue;
 
 typedef void* ( *DebuginatorQueueAllocateFunc )( void* userdata, int bytes );
@@ -96,33 +232,192 @@ typedef void ( *DebuginatorQueueDellocateFunc )( void* userdata, void* ptr );
 typedef void ( *DebuginatorQueueItemCleanupFunc )( TheDebuginatorQueue*  queue,
                                                    DebuginatorQueueItem* item );
 
+typedef struct DebuginatorQueueBuffer {
+  unsigned char* data;
+  int            size;     // Bytes used by records
+  int            capacity; // Bytes
+} DebuginatorQueueBuffer;
+
 typedef struct TheDebuginatorQueue {
   void*                           userdata;
-  DebuginatorQueueItem*           items;
-  int                             num_items;
-  int                             capacity;
+  DebuginatorQueueBuffer          buffers[2]; // Only double buffered queues use the second one
   DebuginatorQueueAllocateFunc    allocate;
   DebuginatorQueueDellocateFunc   deallocate;
   DebuginatorQueueItemCleanupFunc cleanup_funcs[DEBUGINATOR_QUEUE_NumItemTypes];
+  DebuginatorQueueRing*           ring; // Only for ring queues
+  bool                            double_buffered;
+
+  // For shared queues, the ring is in shared memory. The owner is the process that created it.
+  void* shared_memory;
+  int   shared_bytes;
+  bool  shared_owner;
+  void* shared_handle; // On Windows, the file mapping
+  char  shared_name[DEBUGINATOR_QUEUE_MAX_SHARED_NAME_LENGTH];
+
+  // Only for change queues. The Debuginator is only set in the one that it publishes to.
+  DebuginatorQueueChanges* changes;
+  struct TheDebuginator*   debuginator;
+
+  // For double buffered queues. The lowest bit is which buffer is the back one, and the next
+  // two are set while the producer is writing to the first and the second buffer.
+  volatile unsigned int swap_state;
+
+  // For shared queues, where draining last stopped at a record that wasn't committed, and how
+  // many drains in a row it's stopped there.
+  unsigned int stuck_read;
+  int          stuck_drains;
 } TheDebuginatorQueue;
 
 TheDebuginatorQueue* debuginator_queue_create( int                           initial_size,
                                                DebuginatorQueueAllocateFunc  allocate_func,
                                                DebuginatorQueueDellocateFunc deallocate_func,
                                                void*                         userdata );
+void debuginator_queue_destroy( TheDebuginatorQueue* queue );
 
+// Everything that changes the menu can be recorded into a queue, and then applied in one go
+// with debuginator_queue_process, on the thread that owns The Debuginator. Typically once per
+// frame, followed by debuginator_queue_clear. Operations are applied in the order they were
+// recorded. A queue from debuginator_queue_create grows as needed, and is for one thread at a
+// time. initial_size is in bytes.
 unsigned char* debuginator_queue_data( TheDebuginatorQueue* queue, int* out_size );
 void           debuginator_queue_clear( TheDebuginatorQueue* queue );
-void debuginator_queue_process( const unsigned char* data, int size, TheDebuginator* debuginator );
-void debuginator_queue_create_bool_item( TheDebuginatorQueue* queue,
+void           debuginator_queue_process( const unsigned char*   data,
+                                          int                    size,
+                                          struct TheDebuginator* debuginator );
+
+// A ring queue has a fixed size, and any number of threads can record into it at the same time
+// without locks. The thread that owns The Debuginator applies what's been recorded so far with
+// debuginator_queue_drain, which returns how many operations it applied. If the ring is full,
+// recording returns false and the operation is dropped. capacity is in bytes and is rounded up
+// to a power of two.
+TheDebuginatorQueue* debuginator_queue_create_ring( int                           capacity,
+                                                    DebuginatorQueueAllocateFunc  allocate_func,
+                                                    DebuginatorQueueDellocateFunc deallocate_func,
+                                                    void*                         userdata );
+int debuginator_queue_drain( TheDebuginatorQueue* queue, struct TheDebuginator* debuginator );
+int debuginator_queue_dropped( TheDebuginatorQueue* queue );
+
+// A double buffered queue has a back buffer that one thread records into, and a front buffer
+// that the thread that owns The Debuginator processes. Once per frame, debuginator_queue_swap
+// turns what's been recorded into the front buffer and returns it, ready for
+// debuginator_queue_process, and the producer carries on in the other, now cleared, buffer.
+// The producer never waits, and the swap only waits for an operation that's being recorded
+// right then. With several producers, give each of them a queue.
+TheDebuginatorQueue* debuginator_queue_create_double_buffered( int                           initial_size,
+                                                               DebuginatorQueueAllocateFunc  allocate_func,
+                                                               DebuginatorQueueDellocateFunc deallocate_func,
+                                                               void*                         userdata );
+unsigned char* debuginator_queue_swap( TheDebuginatorQueue* queue, int* out_size );
+
+// A shared queue is a ring queue in named shared memory, so that other processes, like tools
+// and servers, can record into it. The process that owns The Debuginator creates it and drains
+// it like any ring queue, and the others open it with the same name, a plain identifier. Only
+// what's in the records gets across, so the other processes can't pass pointers: userdata and
+// callbacks are ignored, and the kinds of items that need pointers, array, number range, color
+// picker and preset items, are dropped. Bool items created like that keep track of their state
+// themselves. Both return NULL if it fails, or if DEBUGINATOR_QUEUE_SHARED_MEMORY isn't
+// defined. Destroying the owner's queue removes the shared memory, but not until the others
+// have destroyed theirs.
+// If another process dies halfway through recording an operation, draining would wait for it
+// forever. So after DEBUGINATOR_QUEUE_STUCK_DRAINS drains it's skipped and counted as dropped,
+// if the process got as far as reserving it. One that's merely that slow can then write into
+// space that's been handed out again, but everything from other processes is checked before
+// it's applied, so at worst that's more dropped operations.
+TheDebuginatorQueue* debuginator_queue_create_shared( const char*                   name,
+                                                      int                           capacity,
+                                                      DebuginatorQueueAllocateFunc  allocate_func,
+                                                      DebuginatorQueueDellocateFunc deallocate_func,
+                                                      void*                         userdata );
+TheDebuginatorQueue* debuginator_queue_open_shared( const char*                   name,
+                                                    DebuginatorQueueAllocateFunc  allocate_func,
+                                                    DebuginatorQueueDellocateFunc deallocate_func,
+                                                    void*                         userdata );
+
+// A change queue goes the other way. The Debuginator publishes an event to it whenever an item
+// is activated, from debuginator_activate, instead of other threads depending on item callbacks
+// that run on its thread. Any number of readers, on any threads, read the events in batches
+// with debuginator_queue_read_changes, each with a DebuginatorQueueChangeReader of its own
+// that starts at the next event. Publishing never waits for readers: capacity is the number of
+// events kept, rounded up to a power of two, and a reader that falls further behind than that
+// loses the oldest ones. It uses The Debuginator's item changed listener, so there can only be
+// one change queue per Debuginator. Creating it needs DEBUGINATOR_QUEUE_CAN_PROCEES.
+// The shared versions put it in named shared memory, for readers in other processes, like
+// debuginator_queue_create_shared.
+TheDebuginatorQueue* debuginator_queue_create_changes( struct TheDebuginator*        debuginator,
+                                                       int                           capacity,
+                                                       DebuginatorQueueAllocateFunc  allocate_func,
+                                                       DebuginatorQueueDellocateFunc deallocate_func,
+                                                       void*                         userdata );
+TheDebuginatorQueue* debuginator_queue_create_shared_changes( struct TheDebuginator*        debuginator,
+                                                              const char*                   name,
+                                                              int                           capacity,
+                                                              DebuginatorQueueAllocateFunc  allocate_func,
+                                                              DebuginatorQueueDellocateFunc deallocate_func,
+                                                              void*                         userdata );
+TheDebuginatorQueue* debuginator_queue_open_shared_changes( const char*                   name,
+                                                            DebuginatorQueueAllocateFunc  allocate_func,
+                                                            DebuginatorQueueDellocateFunc deallocate_func,
+                                                            void*                         userdata );
+void debuginator_queue_init_change_reader( TheDebuginatorQueue* queue, DebuginatorQueueChangeReader* reader );
+int  debuginator_queue_read_changes( TheDebuginatorQueue*          queue,
+                                     DebuginatorQueueChangeReader* reader,
+                                     DebuginatorQueueChangeEvent*  events,
+                                     int                           max_events );
+
+// A hash of the path, to tell which item a change event is for.
+unsigned int debuginator_queue_path_id( const char* path );
+
+bool debuginator_queue_create_bool_item( TheDebuginatorQueue* queue,
                                          const char*          path,
                                          const char*          description,
                                          void*                userdata );
-void debuginator_queue_create_bool_item_with_callback( TheDebuginatorQueue*             queue,
+bool debuginator_queue_create_bool_item_with_callback( TheDebuginatorQueue*             queue,
                                                        const char*                      path,
                                                        const char*                      description,
                                                        void*                            userdata,
                                                        DebuginatorOnItemChangedCallback callback );
+bool debuginator_queue_create_array_item( TheDebuginatorQueue*             queue,
+                                          const char*                      path,
+                                          const char*                      description,
+                                          DebuginatorOnItemChangedCallback callback,
+                                          void*                            userdata,
+                                          const char**                     value_titles,
+                                          void*                            values,
+                                          int                              num_values,
+                                          int                              value_size );
+bool debuginator_queue_create_numberrange_float_item( TheDebuginatorQueue* queue,
+                                                     const char*          path,
+                                                     const char*          description,
+                                                     float*               userdata,
+                                                     float                range_min,
+                                                     float                range_max );
+bool debuginator_queue_create_colorpicker_item( TheDebuginatorQueue*             queue,
+                                                const char*                      path,
+                                                const char*                      description,
+                                                DebuginatorOnItemChangedCallback callback,
+                                                void*                            userdata,
+                                                DebuginatorColor*                start_color );
+bool debuginator_queue_create_preset_item( TheDebuginatorQueue* queue,
+                                           const char*          path,
+                                           const char**         paths,
+                                           const char**         value_titles,
+                                           int                  num_paths );
+
+// Removes the item, and its children if it's a folder.
+bool debuginator_queue_remove_item_by_path( TheDebuginatorQueue* queue, const char* path );
+
+// value_title can be NULL, then value_index is used.
+bool debuginator_queue_set_default_value( TheDebuginatorQueue* queue,
+                                          const char*          path,
+                                          const char*          value_title,
+                                          int                  value_index );
+bool debuginator_queue_load_item( TheDebuginatorQueue* queue, const char* key, const char* value );
+bool debuginator_queue_assign_hot_key( TheDebuginatorQueue* queue,
+                                       const char*          key,
+                                       const char*          path,
+                                       int                  value_index,
+                                       const char*          optional_value_title );
+bool debuginator_queue_unassign_hot_key( TheDebuginatorQueue* queue, const char* key );
 
 #ifdef __cplusplus
 }
@@ -132,7 +427,7 @@ void debuginator_queue_create_bool_item_with_callback( TheDebuginatorQueue*
 
 #ifndef DEBUGINATOR_QUEUE_assert
 #include <assert.h>
-#define DEBUGINATOR_QUEUE_assert assert;
+#define DEBUGINATOR_QUEUE_assert assert
 #endif
 
 #ifndef DEBUGINATOR_QUEUE_memcpy
@@ -140,84 +435,522 @@ void debuginator_queue_create_bool_item_with_callback( TheDebuginatorQueue*
 #define DEBUGINATOR_QUEUE_memcpy memcpy
 #endif
 
-#ifndef DEBUGINATOR_QUEUE_strcpy_s
+#include <stddef.h>
+
+#ifdef DEBUGINATOR_QUEUE_SHARED_MEMORY
+#ifdef _WIN32
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#include <windows.h>
+#else
+#if defined( __STRICT_ANSI__ ) && !defined( __APPLE__ ) && !defined( _GNU_SOURCE ) && \
+  !defined( _DEFAULT_SOURCE ) && !defined( _XOPEN_SOURCE ) &&                           \
+  ( !defined( _POSIX_C_SOURCE ) || _POSIX_C_SOURCE < 200112L )
+#error "Shared queues need POSIX: #define _POSIX_C_SOURCE 200112L before including anything, or use -std=gnu99"
+#endif
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+#include <stdio.h>
+#endif
+
+#ifndef DEBUGINATOR_QUEUE_strlen
 #include <string.h>
-#define DEBUGINATOR_QUEUE_strcpy_s strcpy_s
+#define DEBUGINATOR_QUEUE_strlen strlen
 #endif
 
+#ifndef DEBUGINATOR_QUEUE_memset
+#include <string.h>
+#define DEBUGINATOR_QUEUE_memset memset
+#endif
+
+// For ring queues. Loads acquire, stores release, and the others are full barriers.
+#ifndef DEBUGINATOR_QUEUE_atomic_load
+#if defined( _MSC_VER ) && !defined( __clang__ )
+#include <intrin.h>
+#define DEBUGINATOR_QUEUE_atomic_load( ptr ) \
+  ( (unsigned int)_InterlockedOr( (volatile long*)( ptr ), 0 ) )
+#define DEBUGINATOR_QUEUE_atomic_store( ptr, value ) \
+  _InterlockedExchange( (volatile long*)( ptr ), (long)( value ) )
+#define DEBUGINATOR_QUEUE_atomic_compare_exchange( ptr, expected, desired )                 \
+  ( _InterlockedCompareExchange( (volatile long*)( ptr ), (long)( desired ), (long)( expected ) ) == \
+    (long)( expected ) )
+#define DEBUGINATOR_QUEUE_atomic_add( ptr, value ) \
+  _InterlockedExchangeAdd( (volatile long*)( ptr ), (long)( value ) )
+// The loads and stores above are interlocked, so only the compiler needs to be stopped.
+#define DEBUGINATOR_QUEUE_atomic_fence() _ReadWriteBarrier()
+#else
+#define DEBUGINATOR_QUEUE_atomic_load( ptr ) __atomic_load_n( ( ptr ), __ATOMIC_ACQUIRE )
+#define DEBUGINATOR_QUEUE_atomic_store( ptr, value ) \
+  __atomic_store_n( ( ptr ), ( value ), __ATOMIC_RELEASE )
+#define DEBUGINATOR_QUEUE_atomic_compare_exchange( ptr, expected, desired ) \
+  __sync_bool_compare_and_swap( ( ptr ), ( expected ), ( desired ) )
+#define DEBUGINATOR_QUEUE_atomic_add( ptr, value ) __sync_fetch_and_add( ( ptr ), ( value ) )
+#define DEBUGINATOR_QUEUE_atomic_fence() __atomic_thread_fence( __ATOMIC_SEQ_CST )
+#endif
+#endif
+
+// In a ring queue, every operation has a header. A producer sets committed last, once the
+// operation is written, and the consumer only goes as far as the first one that isn't. If a
+// record doesn't fit before the end of the ring, the space up to it is filled with padding.
+typedef struct DebuginatorQueueRingRecord {
+  volatile unsigned int size; // Including the header. Set right after it's reserved.
+  volatile unsigned int committed;
+} DebuginatorQueueRingRecord;
+
+#define DEBUGINATOR_QUEUE_RING_RECORD 1
+#define DEBUGINATOR_QUEUE_RING_PADDING 2
+
+#define DEBUGINATOR_QUEUE_SWAP_BACK_MASK 1u
+#define DEBUGINATOR_QUEUE_SWAP_WRITING( buffer_index ) ( 2u << ( buffer_index ) )
+
 static void
-debuginator_queue__ensure_capacity( TheDebuginatorQueue* queue ) {
-  if ( queue->capacity + 1 == queue->num_items ) {
-    int   bytes = sizeof( DebuginatorQueueItem ) * queue->num_items * 2;
-    void* items = queue->allocate( queue->userdata, bytes );
-    DEBUGINATOR_QUEUE_memcpy( items, queue->items, bytes );
-    queue->deallocate( queue->userdata, queue->items );
-    queue->items    = (DebuginatorQueueItem*)items;
-    queue->capacity = queue->num_items * 2;
-  }
-}
-
-// static const char*
-// debuginator_queue__copy_string( TheDebuginatorQueue* queue, const char* str ) {
-//   int   bytes  = strlen( str );
-//   void* buffer = queue->allocate( queue->userdata, bytes );
-//   DEBUGINATOR_QUEUE_memcpy( buffer, str, bytes );
-//   return (const char*)buffer;
-// }
+debuginator_queue__ensure_capacity( TheDebuginatorQueue* queue, DebuginatorQueueBuffer* buffer, int bytes ) {
+  if ( buffer->size + bytes <= buffer->capacity ) {
+    return;
+  }
+
+  int capacity = buffer->capacity > 0 ? buffer->capacity * 2 : 1024;
+  while ( capacity < buffer->size + bytes ) {
+    capacity *= 2;
+  }
+
+  void* data = queue->allocate( queue->userdata, capacity );
+  DEBUGINATOR_QUEUE_memcpy( data, buffer->data, (size_t)buffer->size );
+  queue->deallocate( queue->userdata, buffer->data );
+  buffer->data     = (unsigned char*)data;
+  buffer->capacity = capacity;
+}
+
+// Marks the back buffer as being written to, so that a swap waits for it, and returns it.
+static DebuginatorQueueBuffer*
+debuginator_queue__begin_write( TheDebuginatorQueue* queue ) {
+  if ( !queue->double_buffered ) {
+    return &queue->buffers[0];
+  }
+
+  for ( ;; ) {
+    unsigned int state        = DEBUGINATOR_QUEUE_atomic_load( &queue->swap_state );
+    unsigned int buffer_index = state & DEBUGINATOR_QUEUE_SWAP_BACK_MASK;
+    if ( DEBUGINATOR_QUEUE_atomic_compare_exchange(
+           &queue->swap_state, state, state | DEBUGINATOR_QUEUE_SWAP_WRITING( buffer_index ) ) ) {
+      return &queue->buffers[buffer_index];
+    }
+  }
+}
+
+// There's only one producer, so only one of the writing bits is set, and swapping only changes
+// the back bit.
+static void
+debuginator_queue__end_write( TheDebuginatorQueue* queue ) {
+  if ( queue->double_buffered ) {
+    unsigned int writing = DEBUGINATOR_QUEUE_atomic_load( &queue->swap_state ) &
+                           ( DEBUGINATOR_QUEUE_SWAP_WRITING( 0 ) | DEBUGINATOR_QUEUE_SWAP_WRITING( 1 ) );
+    DEBUGINATOR_QUEUE_atomic_add( &queue->swap_state, 0u - writing );
+  }
+}
+
+static unsigned char*
+debuginator_queue__ring_data( DebuginatorQueueRing* ring ) {
+  return (unsigned char*)( ring + 1 );
+}
+
+// Returns NULL if it doesn't fit.
+static void*
+debuginator_queue__ring_reserve( DebuginatorQueueRing* ring, unsigned int bytes ) {
+  unsigned int size =
+    ( sizeof( DebuginatorQueueRingRecord ) + bytes + DEBUGINATOR_QUEUE_RECORD_ALIGNMENT - 1 ) &
+    ~( DEBUGINATOR_QUEUE_RECORD_ALIGNMENT - 1u );
+  unsigned int mask = ring->capacity - 1;
+  unsigned int reserved;
+  unsigned int padding;
+  for ( ;; ) {
+    // read first. The consumer never gets past reserved, so reserved - read can't wrap, while
+    // the other way around, records could be committed and read in between.
+    unsigned int read = DEBUGINATOR_QUEUE_atomic_load( &ring->read );
+    reserved          = DEBUGINATOR_QUEUE_atomic_load( &ring->reserved );
+    unsigned int left_before_end = ring->capacity - ( reserved & mask );
+    padding                      = left_before_end < size ? left_before_end : 0;
+    if ( size > ring->capacity || reserved - read + padding + size > ring->capacity ) {
+      DEBUGINATOR_QUEUE_atomic_add( &ring->dropped, 1 );
+      return NULL;
+    }
+
+    if ( DEBUGINATOR_QUEUE_atomic_compare_exchange(
+           &ring->reserved, reserved, reserved + padding + size ) ) {
+      break;
+    }
+  }
+
+  unsigned char* data = debuginator_queue__ring_data( ring );
+  if ( padding > 0 ) {
+    DebuginatorQueueRingRecord* padding_record =
+      (DebuginatorQueueRingRecord*)( data + ( reserved & mask ) );
+    DEBUGINATOR_QUEUE_atomic_store( &padding_record->size, padding );
+    DEBUGINATOR_QUEUE_atomic_store( &padding_record->committed, DEBUGINATOR_QUEUE_RING_PADDING );
+    reserved += padding;
+  }
+
+  DebuginatorQueueRingRecord* record = (DebuginatorQueueRingRecord*)( data + ( reserved & mask ) );
+  DEBUGINATOR_QUEUE_atomic_store( &record->size, size );
+  return record + 1;
+}
+
+// Where the strings start in a record with the given data.
+#define DEBUGINATOR_QUEUE__STRINGS_OFFSET( data_type ) \
+  ( (unsigned int)( offsetof( DebuginatorQueueItem, data ) + sizeof( data_type ) ) )
+
+// bytes is the size of the record before it's aligned. Returns NULL if a ring queue is full.
+// Otherwise call debuginator_queue__commit when it's written.
+static DebuginatorQueueItem*
+debuginator_queue__push( TheDebuginatorQueue* queue, DebuginatorQueueItemTypes type, unsigned int bytes ) {
+  unsigned int size =
+    ( bytes + DEBUGINATOR_QUEUE_RECORD_ALIGNMENT - 1 ) & ~( DEBUGINATOR_QUEUE_RECORD_ALIGNMENT - 1u );
+  DebuginatorQueueItem* item;
+  if ( queue->ring != NULL ) {
+    DEBUGINATOR_QUEUE_assert( queue->shared_bytes == 0 || type == DEBUGINATOR_QUEUE_CreateItem ||
+                              type >= DEBUGINATOR_QUEUE_RemoveItem );
+    item = (DebuginatorQueueItem*)debuginator_queue__ring_reserve( queue->ring, size );
+    if ( item == NULL ) {
+      return NULL;
+    }
+  }
+  else {
+    DebuginatorQueueBuffer* buffer = debuginator_queue__begin_write( queue );
+    debuginator_queue__ensure_capacity( queue, buffer, (int)size );
+    item = (DebuginatorQueueItem*)( buffer->data + buffer->size );
+    buffer->size += (int)size;
+  }
+
+  item->type = type;
+  item->size = size;
+  return item;
+}
+
+static void
+debuginator_queue__commit( TheDebuginatorQueue* queue, DebuginatorQueueItem* item ) {
+  if ( queue->ring != NULL ) {
+    DebuginatorQueueRingRecord* record = (DebuginatorQueueRingRecord*)item - 1;
+    DEBUGINATOR_QUEUE_atomic_store( &record->committed, DEBUGINATOR_QUEUE_RING_RECORD );
+  }
+  else {
+    debuginator_queue__end_write( queue );
+  }
+}
+
+// Optional strings, like descriptions, can be NULL. They're recorded as empty.
+static unsigned int
+debuginator_queue__string_length( const char* string ) {
+  return string != NULL ? (unsigned int)DEBUGINATOR_QUEUE_strlen( string ) : 0;
+}
+
+// Copies the string to offset in the record, and moves offset past it.
+static void
+debuginator_queue__write_string( DebuginatorQueueItem*   item,
+                                 unsigned int*           offset,
+                                 DebuginatorQueueString* string,
+                                 const char*             src,
+                                 unsigned int            length ) {
+  char* dest = (char*)item + *offset;
+  if ( length > 0 ) {
+    DEBUGINATOR_QUEUE_memcpy( dest, src, length );
+  }
+  dest[length]   = '\0';
+  string->offset = *offset;
+  string->length = length;
+  *offset += length + 1;
+}
 
 void
 debuginator_queue_clear( TheDebuginatorQueue* queue ) {
-  // for ( int i_item = 0; i_item < queue->num_items; ++i_item ) {
-  //   DebuginatorQueueItem* item = &queue->items[i_item];
-  //   queue->cleanup_funcs[item->type]( queue, item );
-  // }
-  queue->num_items = 0;
+  DEBUGINATOR_QUEUE_assert( !queue->double_buffered );
+  queue->buffers[0].size = 0;
 }
 
 unsigned char*
 debuginator_queue_data( TheDebuginatorQueue* queue, int* out_size ) {
-  *out_size = queue->num_items * sizeof( DebuginatorQueueItem );
-  return (unsigned char*)queue->items;
+  DEBUGINATOR_QUEUE_assert( queue->ring == NULL && !queue->double_buffered );
+  *out_size = queue->buffers[0].size;
+  return queue->buffers[0].data;
 }
 
-void
+unsigned char*
+debuginator_queue_swap( TheDebuginatorQueue* queue, int* out_size ) {
+  DEBUGINATOR_QUEUE_assert( queue->double_buffered );
+
+  // The front buffer has been processed, and the producer doesn't touch it, so it can be
+  // cleared before it becomes the back buffer.
+  unsigned int state      = DEBUGINATOR_QUEUE_atomic_load( &queue->swap_state );
+  unsigned int back_index = state & DEBUGINATOR_QUEUE_SWAP_BACK_MASK;
+  queue->buffers[back_index ^ 1].size = 0;
+  while ( !DEBUGINATOR_QUEUE_atomic_compare_exchange(
+    &queue->swap_state, state, state ^ DEBUGINATOR_QUEUE_SWAP_BACK_MASK ) ) {
+    state = DEBUGINATOR_QUEUE_atomic_load( &queue->swap_state );
+  }
+
+  // An operation that was started before the swap goes into the old back buffer.
+  while ( DEBUGINATOR_QUEUE_atomic_load( &queue->swap_state ) &
+          DEBUGINATOR_QUEUE_SWAP_WRITING( back_index ) ) {
+  }
+
+  *out_size = queue->buffers[back_index].size;
+  return queue->buffers[back_index].data;
+}
+
+bool
 debuginator_queue_create_bool_item( TheDebuginatorQueue* queue,
                                     const char*          path,
                                     const char*          description,
                                     void*                userdata ) {
-
-  debuginator_queue__ensure_capacity( queue );
-
-  DebuginatorQueue_CreateItemData data;
-  DEBUGINATOR_QUEUE_strcpy_s( data.path, DEBUGINATOR_QUEUE_MAX_PATH_LENGTH, path );
-  DEBUGINATOR_QUEUE_strcpy_s(
-    data.description, DEBUGINATOR_QUEUE_MAX_DESCRIPTION_LENGTH, description );
-  data.userdata = userdata;
-
-  DebuginatorQueueItem* item = &queue->items[queue->num_items++];
-  item->type                 = DEBUGINATOR_QUEUE_CreateItem;
-  item->data.create_item     = data;
+  return debuginator_queue_create_bool_item_with_callback( queue, path, description, userdata, NULL );
 }
 
-void
+bool
 debuginator_queue_create_bool_item_with_callback( TheDebuginatorQueue*             queue,
                                                   const char*                      path,
                                                   const char*                      description,
                                                   void*                            userdata,
                                                   DebuginatorOnItemChangedCallback callback ) {
 
-  debuginator_queue__ensure_capacity( queue );
+  unsigned int          path_length        = debuginator_queue__string_length( path );
+  unsigned int          description_length = debuginator_queue__string_length( description );
+  unsigned int          offset = DEBUGINATOR_QUEUE__STRINGS_OFFSET( DebuginatorQueue_CreateItemData );
+  DebuginatorQueueItem* item   = debuginator_queue__push(
+    queue, DEBUGINATOR_QUEUE_CreateItem, offset + path_length + description_length + 2 );
+  if ( item == NULL ) {
+    return false;
+  }
+
+  DebuginatorQueue_CreateItemData* data = &item->data.create_item;
+  debuginator_queue__write_string( item, &offset, &data->path, path, path_length );
+  debuginator_queue__write_string( item, &offset, &data->description, description, description_length );
+  data->userdata = userdata;
+  data->callback = callback;
+  debuginator_queue__commit( queue, item );
+  return true;
+}
+
+bool
+debuginator_queue_create_array_item( TheDebuginatorQueue*             queue,
+                                     const char*                      path,
+                                     const char*                      description,
+                                     DebuginatorOnItemChangedCallback callback,
+                                     void*                            userdata,
+                                     const char**                     value_titles,
+                                     void*                            values,
+                                     int                              num_values,
+                                     int                              value_size ) {
 
-  DebuginatorQueue_CreateItemData data;
-  DEBUGINATOR_QUEUE_strcpy_s( data.path, DEBUGINATOR_QUEUE_MAX_PATH_LENGTH, path );
-  DEBUGINATOR_QUEUE_strcpy_s(
-    data.description, DEBUGINATOR_QUEUE_MAX_DESCRIPTION_LENGTH, description );
-  data.userdata = userdata;
-  data.callback = callback;
+  unsigned int          path_length        = debuginator_queue__string_length( path );
+  unsigned int          description_length = debuginator_queue__string_length( description );
+  unsigned int          offset = DEBUGINATOR_QUEUE__STRINGS_OFFSET( DebuginatorQueue_CreateArrayItemData );
+  DebuginatorQueueItem* item   = debuginator_queue__push(
+    queue, DEBUGINATOR_QUEUE_CreateArrayItem, offset + path_length + description_length + 2 );
+  if ( item == NULL ) {
+    return false;
+  }
 
-  DebuginatorQueueItem* item = &queue->items[queue->num_items++];
-  item->type                 = DEBUGINATOR_QUEUE_CreateItem;
-  item->data.create_item     = data;
+  DebuginatorQueue_CreateArrayItemData* data = &item->data.create_array_item;
+  debuginator_queue__write_string( item, &offset, &data->path, path, path_length );
+  debuginator_queue__write_string( item, &offset, &data->description, description, description_length );
+  data->userdata     = userdata;
+  data->callback     = callback;
+  data->value_titles = value_titles;
+  data->values       = values;
+  data->num_values   = num_values;
+  data->value_size   = value_size;
+  debuginator_queue__commit( queue, item );
+  return true;
+}
+
+bool
+debuginator_queue_create_numberrange_float_item( TheDebuginatorQueue* queue,
+                                                const char*          path,
+                                                const char*          description,
+                                                float*               userdata,
+                                                float                range_min,
+                                                float                range_max ) {
+
+  unsigned int path_length        = debuginator_queue__string_length( path );
+  unsigned int description_length = debuginator_queue__string_length( description );
+  unsigned int offset =
+    DEBUGINATOR_QUEUE__STRINGS_OFFSET( DebuginatorQueue_CreateNumberRangeFloatItemData );
+  DebuginatorQueueItem* item = debuginator_queue__push( queue,
+                                                        DEBUGINATOR_QUEUE_CreateNumberRangeFloatItem,
+                                                        offset + path_length + description_length + 2 );
+  if ( item == NULL ) {
+    return false;
+  }
+
+  DebuginatorQueue_CreateNumberRangeFloatItemData* data = &item->data.create_numberrange_float_item;
+  debuginator_queue__write_string( item, &offset, &data->path, path, path_length );
+  debuginator_queue__write_string( item, &offset, &data->description, description, description_length );
+  data->userdata  = userdata;
+  data->range_min = range_min;
+  data->range_max = range_max;
+  debuginator_queue__commit( queue, item );
+  return true;
+}
+
+bool
+debuginator_queue_create_colorpicker_item( TheDebuginatorQueue*             queue,
+                                           const char*                      path,
+                                           const char*                      description,
+                                           DebuginatorOnItemChangedCallback callback,
+                                           void*                            userdata,
+                                           DebuginatorColor*                start_color ) {
+
+  unsigned int path_length        = debuginator_queue__string_length( path );
+  unsigned int description_length = debuginator_queue__string_length( description );
+  unsigned int offset = DEBUGINATOR_QUEUE__STRINGS_OFFSET( DebuginatorQueue_CreateColorPickerItemData );
+  DebuginatorQueueItem* item = debuginator_queue__push(
+    queue, DEBUGINATOR_QUEUE_CreateColorPickerItem, offset + path_length + description_length + 2 );
+  if ( item == NULL ) {
+    return false;
+  }
+
+  DebuginatorQueue_CreateColorPickerItemData* data = &item->data.create_colorpicker_item;
+  debuginator_queue__write_string( item, &offset, &data->path, path, path_length );
+  debuginator_queue__write_string( item, &offset, &data->description, description, description_length );
+  data->userdata    = userdata;
+  data->callback    = callback;
+  data->start_color = *start_color;
+  debuginator_queue__commit( queue, item );
+  return true;
+}
+
+bool
+debuginator_queue_create_preset_item( TheDebuginatorQueue* queue,
+                                      const char*          path,
+                                      const char**         paths,
+                                      const char**         value_titles,
+                                      int                  num_paths ) {
+
+  unsigned int          path_length = debuginator_queue__string_length( path );
+  unsigned int          offset = DEBUGINATOR_QUEUE__STRINGS_OFFSET( DebuginatorQueue_CreatePresetItemData );
+  DebuginatorQueueItem* item   = debuginator_queue__push(
+    queue, DEBUGINATOR_QUEUE_CreatePresetItem, offset + path_length + 1 );
+  if ( item == NULL ) {
+    return false;
+  }
+
+  DebuginatorQueue_CreatePresetItemData* data = &item->data.create_preset_item;
+  debuginator_queue__write_string( item, &offset, &data->path, path, path_length );
+  data->paths        = paths;
+  data->value_titles = value_titles;
+  data->num_paths    = num_paths;
+  debuginator_queue__commit( queue, item );
+  return true;
+}
+
+bool
+debuginator_queue_remove_item_by_path( TheDebuginatorQueue* queue, const char* path ) {
+  unsigned int          path_length = debuginator_queue__string_length( path );
+  unsigned int          offset = DEBUGINATOR_QUEUE__STRINGS_OFFSET( DebuginatorQueue_RemoveItemData );
+  DebuginatorQueueItem* item =
+    debuginator_queue__push( queue, DEBUGINATOR_QUEUE_RemoveItem, offset + path_length + 1 );
+  if ( item == NULL ) {
+    return false;
+  }
+
+  debuginator_queue__write_string( item, &offset, &item->data.remove_item.path, path, path_length );
+  debuginator_queue__commit( queue, item );
+  return true;
+}
+
+bool
+debuginator_queue_set_default_value( TheDebuginatorQueue* queue,
+                                     const char*          path,
+                                     const char*          value_title,
+                                     int                  value_index ) {
+
+  unsigned int          path_length        = debuginator_queue__string_length( path );
+  unsigned int          value_title_length = debuginator_queue__string_length( value_title );
+  unsigned int          offset = DEBUGINATOR_QUEUE__STRINGS_OFFSET( DebuginatorQueue_SetValueData );
+  DebuginatorQueueItem* item   = debuginator_queue__push(
+    queue, DEBUGINATOR_QUEUE_SetDefaultValue, offset + path_length + value_title_length + 2 );
+  if ( item == NULL ) {
+    return false;
+  }
+
+  DebuginatorQueue_SetValueData* data = &item->data.set_value;
+  debuginator_queue__write_string( item, &offset, &data->path, path, path_length );
+  debuginator_queue__write_string( item, &offset, &data->value_title, value_title, value_title_length );
+  data->has_value_title = value_title != NULL;
+  data->value_index     = value_index;
+  debuginator_queue__commit( queue, item );
+  return true;
+}
+
+bool
+debuginator_queue_load_item( TheDebuginatorQueue* queue, const char* key, const char* value ) {
+  unsigned int          key_length   = debuginator_queue__string_length( key );
+  unsigned int          value_length = debuginator_queue__string_length( value );
+  unsigned int          offset       = DEBUGINATOR_QUEUE__STRINGS_OFFSET( DebuginatorQueue_SetValueData );
+  DebuginatorQueueItem* item         = debuginator_queue__push(
+    queue, DEBUGINATOR_QUEUE_LoadItem, offset + key_length + value_length + 2 );
+  if ( item == NULL ) {
+    return false;
+  }
+
+  DebuginatorQueue_SetValueData* data = &item->data.set_value;
+  debuginator_queue__write_string( item, &offset, &data->path, key, key_length );
+  debuginator_queue__write_string( item, &offset, &data->value_title, value, value_length );
+  data->has_value_title = true;
+  data->value_index     = 0;
+  debuginator_queue__commit( queue, item );
+  return true;
+}
+
+bool
+debuginator_queue_assign_hot_key( TheDebuginatorQueue* queue,
+                                  const char*          key,
+                                  const char*          path,
+                                  int                  value_index,
+                                  const char*          optional_value_title ) {
+
+  unsigned int          key_length         = debuginator_queue__string_length( key );
+  unsigned int          path_length        = debuginator_queue__string_length( path );
+  unsigned int          value_title_length = debuginator_queue__string_length( optional_value_title );
+  unsigned int          offset = DEBUGINATOR_QUEUE__STRINGS_OFFSET( DebuginatorQueue_HotKeyData );
+  DebuginatorQueueItem* item   = debuginator_queue__push(
+    queue, DEBUGINATOR_QUEUE_AssignHotKey, offset + key_length + path_length + value_title_length + 3 );
+  if ( item == NULL ) {
+    return false;
+  }
+
+  DebuginatorQueue_HotKeyData* data = &item->data.hot_key;
+  debuginator_queue__write_string( item, &offset, &data->key, key, key_length );
+  debuginator_queue__write_string( item, &offset, &data->path, path, path_length );
+  debuginator_queue__write_string(
+    item, &offset, &data->value_title, optional_value_title, value_title_length );
+  data->has_value_title = optional_value_title != NULL;
+  data->value_index     = value_index;
+  debuginator_queue__commit( queue, item );
+  return true;
+}
+
+bool
+debuginator_queue_unassign_hot_key( TheDebuginatorQueue* queue, const char* key ) {
+  unsigned int          key_length = debuginator_queue__string_length( key );
+  unsigned int          offset     = DEBUGINATOR_QUEUE__STRINGS_OFFSET( DebuginatorQueue_HotKeyData );
+  DebuginatorQueueItem* item       = debuginator_queue__push(
+    queue, DEBUGINATOR_QUEUE_UnassignHotKey, offset + key_length + 3 );
+  if ( item == NULL ) {
+    return false;
+  }
+
+  DebuginatorQueue_HotKeyData* data = &item->data.hot_key;
+  debuginator_queue__write_string( item, &offset, &data->key, key, key_length );
+  debuginator_queue__write_string( item, &offset, &data->path, NULL, 0 );
+  debuginator_queue__write_string( item, &offset, &data->value_title, NULL, 0 );
+  data->has_value_title = false;
+  data->value_index     = 0;
+  debuginator_queue__commit( queue, item );
+  return true;
 }
 
 // void
@@ -230,42 +963,252 @@ debuginator_queue_create_bool_item_with_callback( TheDebuginatorQueue*
 //   queue->deallocate( queue->userdata, (void*)item->data );
 // }
 
+#ifdef DEBUGINATOR_QUEUE_CAN_PROCEES
+static const char*
+debuginator_queue__string( const DebuginatorQueueItem* item, DebuginatorQueueString string ) {
+  return (const char*)item + string.offset;
+}
+
+static void
+debuginator_queue__process_item( const DebuginatorQueueItem* item, struct TheDebuginator* debuginator ) {
+  switch ( item->type ) {
+  case DEBUGINATOR_QUEUE_CreateItem: {
+    //   debuginator_create_array_item(debuginator, NULL, item->data.create_item.path,
+    // description, item->data.create_item.callback,  item->data.create_item.userdata,
+    // debuginator->bool_titles, debuginator->bool_values, 2,
+    // sizeof(debuginator->bool_values[0]));
+    const DebuginatorQueue_CreateItemData* create = &item->data.create_item;
+    if ( create->callback == NULL ) {
+      debuginator_create_bool_item( debuginator,
+                                    debuginator_queue__string( item, create->path ),
+                                    debuginator_queue__string( item, create->description ),
+                                    create->userdata );
+    }
+    else {
+      debuginator_create_bool_item_with_callback( debuginator,
+                                                  debuginator_queue__string( item, create->path ),
+                                                  debuginator_queue__string( item, create->description ),
+                                                  create->userdata,
+                                                  create->callback );
+    }
+  } break;
+  case DEBUGINATOR_QUEUE_CreateArrayItem: {
+    const DebuginatorQueue_CreateArrayItemData* create = &item->data.create_array_item;
+    debuginator_create_array_item( debuginator,
+                                   NULL,
+                                   debuginator_queue__string( item, create->path ),
+                                   debuginator_queue__string( item, create->description ),
+                                   create->callback,
+                                   create->userdata,
+                                   create->value_titles,
+                                   create->values,
+                                   create->num_values,
+                                   create->value_size );
+  } break;
+  case DEBUGINATOR_QUEUE_CreateNumberRangeFloatItem: {
+    const DebuginatorQueue_CreateNumberRangeFloatItemData* create =
+      &item->data.create_numberrange_float_item;
+    debuginator_create_numberrange_float_item( debuginator,
+                                               debuginator_queue__string( item, create->path ),
+                                               debuginator_queue__string( item, create->description ),
+                                               create->userdata,
+                                               create->range_min,
+                                               create->range_max );
+  } break;
+  case DEBUGINATOR_QUEUE_CreateColorPickerItem: {
+    const DebuginatorQueue_CreateColorPickerItemData* create = &item->data.create_colorpicker_item;
+    DebuginatorColor start_color = create->start_color;
+    debuginator_create_colorpicker_item( debuginator,
+                                         debuginator_queue__string( item, create->path ),
+                                         debuginator_queue__string( item, create->description ),
+                                         create->callback,
+                                         create->userdata,
+                                         &start_color );
+  } break;
+  case DEBUGINATOR_QUEUE_CreatePresetItem: {
+    const DebuginatorQueue_CreatePresetItemData* create = &item->data.create_preset_item;
+    debuginator_create_preset_item( debuginator,
+                                    debuginator_queue__string( item, create->path ),
+                                    create->paths,
+                                    create->value_titles,
+                                    NULL,
+                                    create->num_paths );
+  } break;
+  case DEBUGINATOR_QUEUE_RemoveItem:
+    debuginator_remove_item_by_path( debuginator,
+                                     debuginator_queue__string( item, item->data.remove_item.path ) );
+    break;
+  case DEBUGINATOR_QUEUE_SetDefaultValue: {
+    const DebuginatorQueue_SetValueData* set_value = &item->data.set_value;
+    debuginator_set_default_value(
+      debuginator,
+      debuginator_queue__string( item, set_value->path ),
+      set_value->has_value_title ? debuginator_queue__string( item, set_value->value_title ) : NULL,
+      set_value->value_index );
+  } break;
+  case DEBUGINATOR_QUEUE_LoadItem:
+    debuginator_load_item( debuginator,
+                           debuginator_queue__string( item, item->data.set_value.path ),
+                           debuginator_queue__string( item, item->data.set_value.value_title ) );
+    break;
+  case DEBUGINATOR_QUEUE_AssignHotKey: {
+    const DebuginatorQueue_HotKeyData* hot_key = &item->data.hot_key;
+    debuginator_assign_hot_key(
+      debuginator,
+      debuginator_queue__string( item, hot_key->key ),
+      debuginator_queue__string( item, hot_key->path ),
+      hot_key->value_index,
+      hot_key->has_value_title ? debuginator_queue__string( item, hot_key->value_title ) : NULL );
+  } break;
+  case DEBUGINATOR_QUEUE_UnassignHotKey:
+    debuginator_unassign_hot_key( debuginator, debuginator_queue__string( item, item->data.hot_key.key ) );
+    break;
+  default:
+    break;
+  }
+}
+#endif
+
 void
-debuginator_queue_process( const unsigned char* data, int size, TheDebuginator* debuginator ) {
-  (void)( data, size, debuginator );
+debuginator_queue_process( const unsigned char*   data,
+                           int                    size,
+                           struct TheDebuginator* debuginator ) {
+  (void)data;
+  (void)size;
+  (void)debuginator;
+#ifdef DEBUGINATOR_QUEUE_CAN_PROCEES
+  debuginator_profile_begin( debuginator, DEBUGINATOR_ProfileQueueProcess );
+  const unsigned char* data_end = data + size;
+  const unsigned char* record   = data;
+  while ( record < data_end ) {
+    const DebuginatorQueueItem* item = (const DebuginatorQueueItem*)record;
+    DEBUGINATOR_QUEUE_assert( item->size >= sizeof( item->type ) + sizeof( item->size ) );
+    debuginator_queue__process_item( item, debuginator );
+    record += item->size;
+  }
+
+  DEBUGINATOR_QUEUE_assert( record == data_end );
+  debuginator_profile_end( debuginator, DEBUGINATOR_ProfileQueueProcess );
+#endif
+}
+
+#ifdef DEBUGINATOR_QUEUE_CAN_PROCEES
+static bool
+debuginator_queue__valid_string( const DebuginatorQueueItem* item, DebuginatorQueueString string ) {
+  return string.offset >= offsetof( DebuginatorQueueItem, data ) && string.offset < item->size &&
+         string.length < item->size - string.offset &&
+         ( (const char*)item )[string.offset + string.length] == '\0';
+}
+
+// A record from another process can only be trusted as far as it can be checked. Returns false
+// if it shouldn't be processed.
+static bool
+debuginator_queue__sanitize_shared_item( DebuginatorQueueItem* item, unsigned int bytes ) {
+  if ( item->size > bytes ) {
+    return false;
+  }
+
+  switch ( item->type ) {
+  case DEBUGINATOR_QUEUE_CreateItem:
+    item->data.create_item.userdata = NULL;
+    item->data.create_item.callback = NULL;
+    return debuginator_queue__valid_string( item, item->data.create_item.path ) &&
+           debuginator_queue__valid_string( item, item->data.create_item.description );
+  case DEBUGINATOR_QUEUE_RemoveItem:
+    return debuginator_queue__valid_string( item, item->data.remove_item.path );
+  case DEBUGINATOR_QUEUE_SetDefaultValue:
+  case DEBUGINATOR_QUEUE_LoadItem:
+    return debuginator_queue__valid_string( item, item->data.set_value.path ) &&
+           debuginator_queue__valid_string( item, item->data.set_value.value_title );
+  case DEBUGINATOR_QUEUE_AssignHotKey:
+  case DEBUGINATOR_QUEUE_UnassignHotKey:
+    return debuginator_queue__valid_string( item, item->data.hot_key.key ) &&
+           debuginator_queue__valid_string( item, item->data.hot_key.path ) &&
+           debuginator_queue__valid_string( item, item->data.hot_key.value_title );
+  default:
+    return false;
+  }
+}
+
+// Whether a shared queue's uncommitted record has held up draining for long enough that the
+// process writing it has probably died. Then it's skipped like padding. Without its size,
+// there's no telling where the next one starts.
+static bool
+debuginator_queue__ring_record_is_stuck( TheDebuginatorQueue*        queue,
+                                         DebuginatorQueueRingRecord* record,
+                                         unsigned int                read ) {
+  if ( queue->shared_bytes == 0 || DEBUGINATOR_QUEUE_atomic_load( &record->size ) == 0 ) {
+    return false;
+  }
+
+  if ( queue->stuck_read != read ) {
+    queue->stuck_read   = read;
+    queue->stuck_drains = 0;
+  }
+
+  return ++queue->stuck_drains >= DEBUGINATOR_QUEUE_STUCK_DRAINS;
+}
+#endif
+
+int
+debuginator_queue_drain( TheDebuginatorQueue* queue, struct TheDebuginator* debuginator ) {
+  (void)queue;
+  (void)debuginator;
+  int num_processed = 0;
 #ifdef DEBUGINATOR_QUEUE_CAN_PROCEES
-  const void*                 data_end = data + size;
-  const DebuginatorQueueItem* item     = (DebuginatorQueueItem*)(unsigned long long)data;
-  while ( item < data_end ) {
-    switch ( item->type ) {
-    case DEBUGINATOR_QUEUE_CreateItem: {
-      //   debuginator_create_array_item(debuginator, NULL, item->data.create_item.path,
-      // description, item->data.create_item.callback,  item->data.create_item.userdata,
-      // debuginator->bool_titles, debuginator->bool_values, 2,
-      // sizeof(debuginator->bool_values[0]));
-      if ( item->data.create_item.callback == NULL ) {
-        debuginator_create_bool_item( debuginator,
-                                      item->data.create_item.path,
-                                      item->data.create_item.description,
-                                      item->data.create_item.userdata );
+  DebuginatorQueueRing* ring = queue->ring;
+  DEBUGINATOR_QUEUE_assert( ring != NULL );
+  debuginator_profile_begin( debuginator, DEBUGINATOR_ProfileQueueProcess );
+  unsigned char* data     = debuginator_queue__ring_data( ring );
+  unsigned int   mask     = ring->capacity - 1;
+  unsigned int   read     = ring->read;
+  unsigned int   reserved = DEBUGINATOR_QUEUE_atomic_load( &ring->reserved );
+  while ( read != reserved ) {
+    DebuginatorQueueRingRecord* record    = (DebuginatorQueueRingRecord*)( data + ( read & mask ) );
+    unsigned int                committed = DEBUGINATOR_QUEUE_atomic_load( &record->committed );
+    if ( committed == 0 && !debuginator_queue__ring_record_is_stuck( queue, record, read ) ) {
+      // Still being written, it and everything after it waits for the next drain.
+      break;
+    }
+
+    unsigned int size = record->size;
+    if ( size < sizeof( *record ) || size % DEBUGINATOR_QUEUE_RECORD_ALIGNMENT != 0 ||
+         size > ring->capacity - ( read & mask ) ) {
+      // Only possible if another process wrote garbage. There's no way to tell where the next
+      // record starts, so this is as far as it goes.
+      break;
+    }
+
+    if ( committed == DEBUGINATOR_QUEUE_RING_RECORD ) {
+      DebuginatorQueueItem* item = (DebuginatorQueueItem*)( record + 1 );
+      if ( queue->shared_bytes == 0 ||
+           debuginator_queue__sanitize_shared_item( item, size - (unsigned int)sizeof( *record ) ) ) {
+        debuginator_queue__process_item( item, debuginator );
+        ++num_processed;
       }
       else {
-        debuginator_create_bool_item_with_callback( debuginator,
-                                                    item->data.create_item.path,
-                                                    item->data.create_item.description,
-                                                    item->data.create_item.userdata,
-                                                    item->data.create_item.callback );
+        DEBUGINATOR_QUEUE_atomic_add( &ring->dropped, 1 );
       }
-    } break;
-    default:
-      break;
+    }
+    else if ( committed == 0 ) {
+      // Stuck, and skipped.
+      DEBUGINATOR_QUEUE_atomic_add( &ring->dropped, 1 );
     }
 
-    item++;
+    // Any part of it can be a header the next time around, so it has to be cleared.
+    DEBUGINATOR_QUEUE_memset( record, 0, size );
+    read += size;
   }
 
-  DEBUGINATOR_QUEUE_assert( item == data_end );
+  DEBUGINATOR_QUEUE_atomic_store( &ring->read, read );
+  debuginator_profile_end( debuginator, DEBUGINATOR_ProfileQueueProcess );
 #endif
+  return num_processed;
+}
+
+int
+debuginator_queue_dropped( TheDebuginatorQueue* queue ) {
+  return queue->ring != NULL ? (int)DEBUGINATOR_QUEUE_atomic_load( &queue->ring->dropped ) : 0;
 }
 
 TheDebuginatorQueue*
@@ -275,16 +1218,14 @@ debuginator_queue_create( int                           initial_size,
                           void*                         userdata ) {
 
   int                  buffer_bytes = sizeof( TheDebuginatorQueue );
-  int                  item_bytes   = sizeof( DebuginatorQueueItem ) * initial_size;
   void*                queue_buffer = allocate_func( userdata, buffer_bytes );
-  void*                item_buffer  = allocate_func( userdata, item_bytes );
   TheDebuginatorQueue* queue        = (TheDebuginatorQueue*)queue_buffer;
-  queue->num_items                  = 0;
-  queue->capacity                   = initial_size;
+  DEBUGINATOR_QUEUE_memset( queue, 0, sizeof( *queue ) );
+  queue->buffers[0].data            = (unsigned char*)allocate_func( userdata, initial_size );
+  queue->buffers[0].capacity        = initial_size;
   queue->userdata                   = userdata;
   queue->allocate                   = allocate_func;
   queue->deallocate                 = deallocate_func;
-  queue->items                      = (DebuginatorQueueItem*)item_buffer;
 
   // queue->cleanup_funcs[DEBUGINATOR_QUEUE_CreateItem] =
   // debuginator_queue__create_bool_item_cleanup;
@@ -292,6 +1233,454 @@ debuginator_queue_create( int                           initial_size,
   return queue;
 }
 
+static unsigned int
+debuginator_queue__power_of_two( int at_least, unsigned int minimum ) {
+  unsigned int result = minimum;
+  while ( result < (unsigned int)at_least ) {
+    result *= 2;
+  }
+  return result;
+}
+
+TheDebuginatorQueue*
+debuginator_queue_create_ring( int                           capacity,
+                               DebuginatorQueueAllocateFunc  allocate_func,
+                               DebuginatorQueueDellocateFunc deallocate_func,
+                               void*                         userdata ) {
+
+  unsigned int ring_capacity = debuginator_queue__power_of_two( capacity, 64 );
+  int          ring_bytes    = (int)( sizeof( DebuginatorQueueRing ) + ring_capacity );
+  void* ring_buffer = allocate_func( userdata, ring_bytes );
+  DEBUGINATOR_QUEUE_memset( ring_buffer, 0, (size_t)ring_bytes );
+  DebuginatorQueueRing* ring = (DebuginatorQueueRing*)ring_buffer;
+  ring->capacity             = ring_capacity;
+
+  TheDebuginatorQueue* queue = debuginator_queue_create( 0, allocate_func, deallocate_func, userdata );
+  queue->ring                = ring;
+  return queue;
+}
+
+TheDebuginatorQueue*
+debuginator_queue_create_double_buffered( int                           initial_size,
+                                          DebuginatorQueueAllocateFunc  allocate_func,
+                                          DebuginatorQueueDellocateFunc deallocate_func,
+                                          void*                         userdata ) {
+
+  TheDebuginatorQueue* queue =
+    debuginator_queue_create( initial_size, allocate_func, deallocate_func, userdata );
+  queue->buffers[1].data     = (unsigned char*)allocate_func( userdata, initial_size );
+  queue->buffers[1].capacity = initial_size;
+  queue->double_buffered     = true;
+  return queue;
+}
+
+#ifdef DEBUGINATOR_QUEUE_SHARED_MEMORY
+// Maps the named shared memory, creating it if bytes isn't 0. On Windows it also returns the
+// file mapping, which has to be kept open.
+static void*
+debuginator_queue__map_shared( const char* name, int bytes, int* out_bytes, void** out_handle ) {
+  *out_handle = NULL;
+#ifdef _WIN32
+  char   object_name[DEBUGINATOR_QUEUE_MAX_SHARED_NAME_LENGTH + 16];
+  HANDLE mapping;
+  snprintf( object_name, sizeof( object_name ), "Local\\%s", name );
+  if ( bytes > 0 ) {
+    mapping = CreateFileMappingA( INVALID_HANDLE_VALUE, NULL, PAGE_READWRITE, 0, (DWORD)bytes, object_name );
+  }
+  else {
+    mapping = OpenFileMappingA( FILE_MAP_ALL_ACCESS, FALSE, object_name );
+  }
+
+  if ( mapping == NULL ) {
+    return NULL;
+  }
+
+  void* memory = MapViewOfFile( mapping, FILE_MAP_ALL_ACCESS, 0, 0, 0 );
+  MEMORY_BASIC_INFORMATION info;
+  if ( memory == NULL || VirtualQuery( memory, &info, sizeof( info ) ) == 0 ) {
+    if ( memory != NULL ) {
+      UnmapViewOfFile( memory );
+    }
+    CloseHandle( mapping );
+    return NULL;
+  }
+
+  *out_bytes  = (int)info.RegionSize;
+  *out_handle = mapping;
+  return memory;
+#else
+  char object_name[DEBUGINATOR_QUEUE_MAX_SHARED_NAME_LENGTH + 1];
+  snprintf( object_name, sizeof( object_name ), "/%s", name );
+  bool create = bytes > 0;
+  int  fd;
+  if ( create ) {
+    // Left behind if the last owner crashed.
+    shm_unlink( object_name );
+    fd = shm_open( object_name, O_CREAT | O_EXCL | O_RDWR, 0600 );
+    if ( fd >= 0 && ftruncate( fd, bytes ) != 0 ) {
+      close( fd );
+      shm_unlink( object_name );
+      return NULL;
+    }
+  }
+  else {
+    fd = shm_open( object_name, O_RDWR, 0 );
+    struct stat info;
+    if ( fd >= 0 && fstat( fd, &info ) != 0 ) {
+      close( fd );
+      return NULL;
+    }
+    bytes = fd >= 0 ? (int)info.st_size : 0;
+  }
+
+  if ( fd < 0 ) {
+    return NULL;
+  }
+
+  void* memory = mmap( NULL, (size_t)bytes, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0 );
+  close( fd );
+  if ( memory == MAP_FAILED ) {
+    if ( create ) {
+      shm_unlink( object_name );
+    }
+    return NULL;
+  }
+
+  *out_bytes = bytes;
+  return memory;
+#endif
+}
+
+static void
+debuginator_queue__unmap_shared( TheDebuginatorQueue* queue ) {
+#ifdef _WIN32
+  UnmapViewOfFile( queue->shared_memory );
+  CloseHandle( (HANDLE)queue->shared_handle );
+#else
+  munmap( queue->shared_memory, (size_t)queue->shared_bytes );
+  if ( queue->shared_owner ) {
+    char object_name[DEBUGINATOR_QUEUE_MAX_SHARED_NAME_LENGTH + 1];
+    snprintf( object_name, sizeof( object_name ), "/%s", queue->shared_name );
+    shm_unlink( object_name );
+  }
+#endif
+}
+#endif
+
+#ifdef DEBUGINATOR_QUEUE_SHARED_MEMORY
+// Makes a queue for the named shared memory, creating it if bytes isn't 0. Returns NULL if it
+// can't.
+static TheDebuginatorQueue*
+debuginator_queue__create_mapped( const char*                   name,
+                                  int                           bytes,
+                                  DebuginatorQueueAllocateFunc  allocate_func,
+                                  DebuginatorQueueDellocateFunc deallocate_func,
+                                  void*                         userdata ) {
+  if ( DEBUGINATOR_QUEUE_strlen( name ) >= DEBUGINATOR_QUEUE_MAX_SHARED_NAME_LENGTH ) {
+    return NULL;
+  }
+
+  int   shared_bytes  = 0;
+  void* shared_handle = NULL;
+  void* memory        = debuginator_queue__map_shared( name, bytes, &shared_bytes, &shared_handle );
+  if ( memory == NULL ) {
+    return NULL;
+  }
+
+  TheDebuginatorQueue* queue = debuginator_queue_create( 0, allocate_func, deallocate_func, userdata );
+  queue->shared_memory       = memory;
+  queue->shared_bytes        = shared_bytes;
+  queue->shared_owner        = bytes > 0;
+  queue->shared_handle       = shared_handle;
+  DEBUGINATOR_QUEUE_memcpy( queue->shared_name, name, DEBUGINATOR_QUEUE_strlen( name ) + 1 );
+  return queue;
+}
+#endif
+
+TheDebuginatorQueue*
+debuginator_queue_create_shared( const char*                   name,
+                                 int                           capacity,
+                                 DebuginatorQueueAllocateFunc  allocate_func,
+                                 DebuginatorQueueDellocateFunc deallocate_func,
+                                 void*                         userdata ) {
+  (void)name;
+  (void)capacity;
+  (void)allocate_func;
+  (void)deallocate_func;
+  (void)userdata;
+#ifdef DEBUGINATOR_QUEUE_SHARED_MEMORY
+  unsigned int         ring_capacity = debuginator_queue__power_of_two( capacity, 64 );
+  TheDebuginatorQueue* queue         = debuginator_queue__create_mapped(
+    name, (int)( sizeof( DebuginatorQueueRing ) + ring_capacity ), allocate_func, deallocate_func, userdata );
+  if ( queue == NULL ) {
+    return NULL;
+  }
+
+  // New shared memory is zeroed.
+  DebuginatorQueueRing* ring = (DebuginatorQueueRing*)queue->shared_memory;
+  ring->capacity             = ring_capacity;
+  DEBUGINATOR_QUEUE_atomic_store( &ring->magic, DEBUGINATOR_QUEUE_SHARED_MAGIC );
+  queue->ring = ring;
+  return queue;
+#else
+  return NULL;
+#endif
+}
+
+TheDebuginatorQueue*
+debuginator_queue_open_shared( const char*                   name,
+                               DebuginatorQueueAllocateFunc  allocate_func,
+                               DebuginatorQueueDellocateFunc deallocate_func,
+                               void*                         userdata ) {
+  (void)name;
+  (void)allocate_func;
+  (void)deallocate_func;
+  (void)userdata;
+#ifdef DEBUGINATOR_QUEUE_SHARED_MEMORY
+  TheDebuginatorQueue* queue =
+    debuginator_queue__create_mapped( name, 0, allocate_func, deallocate_func, userdata );
+  if ( queue == NULL ) {
+    return NULL;
+  }
+
+  // Not ready yet, or not a queue at all.
+  DebuginatorQueueRing* ring = (DebuginatorQueueRing*)queue->shared_memory;
+  if ( queue->shared_bytes < (int)sizeof( DebuginatorQueueRing ) ||
+       DEBUGINATOR_QUEUE_atomic_load( &ring->magic ) != DEBUGINATOR_QUEUE_SHARED_MAGIC ||
+       ring->capacity == 0 || ( ring->capacity & ( ring->capacity - 1 ) ) != 0 ||
+       sizeof( DebuginatorQueueRing ) + ring->capacity > (unsigned int)queue->shared_bytes ) {
+    debuginator_queue_destroy( queue );
+    return NULL;
+  }
+
+  queue->ring = ring;
+  return queue;
+#else
+  return NULL;
+#endif
+}
+
+unsigned int
+debuginator_queue_path_id( const char* path ) {
+  // FNV-1a
+  unsigned int hash = 2166136261u;
+  for ( const char* c = path; *c != '\0'; ++c ) {
+    hash ^= (unsigned char)*c;
+    hash *= 16777619u;
+  }
+  return hash;
+}
+
+static DebuginatorQueueChangeSlot*
+debuginator_queue__change_slots( DebuginatorQueueChanges* changes ) {
+  return (DebuginatorQueueChangeSlot*)( changes + 1 );
+}
+
+#ifdef DEBUGINATOR_QUEUE_CAN_PROCEES
+// The item changed listener. Only called on The Debuginator's thread, so there's only one
+// writer.
+static void
+debuginator_queue__publish_change( DebuginatorItem* item, void* value, const char* value_title, void* userdata ) {
+  TheDebuginatorQueue*     queue       = (TheDebuginatorQueue*)userdata;
+  struct TheDebuginator*   debuginator = queue->debuginator;
+  DebuginatorQueueChanges* changes     = queue->changes;
+
+  char path[512];
+  int  path_length = (int)sizeof( path ) - 1;
+  debuginator_get_path( debuginator, item, path, &path_length );
+
+  // The slot's sequence is cleared while it's written, so that a reader can tell if it read
+  // half of it.
+  unsigned int                written = changes->written;
+  DebuginatorQueueChangeSlot* slot =
+    &debuginator_queue__change_slots( changes )[written & ( changes->capacity - 1 )];
+  DEBUGINATOR_QUEUE_atomic_store( &slot->sequence, 0 );
+  DEBUGINATOR_QUEUE_atomic_fence();
+
+  DebuginatorQueueChangeEvent* event = &slot->event;
+  event->item_id = path_length < (int)sizeof( path ) ? debuginator_queue_path_id( path ) : 0;
+  event->time = debuginator->get_time != NULL ? debuginator->get_time( debuginator->app_user_data ) : 0;
+  event->value_index = value_title != NULL ? (int)item->leaf.active_index : -1;
+  event->value_size  = 0;
+  if ( value_title != NULL && value != NULL ) {
+    event->value_size = (unsigned int)item->leaf.array_element_size;
+    if ( event->value_size > DEBUGINATOR_QUEUE_CHANGE_VALUE_SIZE ) {
+      event->value_size = DEBUGINATOR_QUEUE_CHANGE_VALUE_SIZE;
+    }
+    DEBUGINATOR_QUEUE_memcpy( event->value, value, event->value_size );
+  }
+
+  DEBUGINATOR_QUEUE_atomic_store( &slot->sequence, written + 1 );
+  DEBUGINATOR_QUEUE_atomic_store( &changes->written, written + 1 );
+}
+
+static void
+debuginator_queue__start_publishing( TheDebuginatorQueue*     queue,
+                                     struct TheDebuginator*   debuginator,
+                                     DebuginatorQueueChanges* changes,
+                                     unsigned int             capacity ) {
+  changes->capacity = capacity;
+  DEBUGINATOR_QUEUE_atomic_store( &changes->magic, DEBUGINATOR_QUEUE_SHARED_MAGIC );
+  queue->changes     = changes;
+  queue->debuginator = debuginator;
+  debuginator_set_item_changed_listener( debuginator, debuginator_queue__publish_change, queue );
+}
+#endif
+
+TheDebuginatorQueue*
+debuginator_queue_create_changes( struct TheDebuginator*        debuginator,
+                                  int                           capacity,
+                                  DebuginatorQueueAllocateFunc  allocate_func,
+                                  DebuginatorQueueDellocateFunc deallocate_func,
+                                  void*                         userdata ) {
+  (void)debuginator;
+  (void)capacity;
+  (void)allocate_func;
+  (void)deallocate_func;
+  (void)userdata;
+#ifdef DEBUGINATOR_QUEUE_CAN_PROCEES
+  unsigned int num_slots = debuginator_queue__power_of_two( capacity, 16 );
+  int bytes = (int)( sizeof( DebuginatorQueueChanges ) + num_slots * sizeof( DebuginatorQueueChangeSlot ) );
+  DebuginatorQueueChanges* changes = (DebuginatorQueueChanges*)allocate_func( userdata, bytes );
+  DEBUGINATOR_QUEUE_memset( changes, 0, (size_t)bytes );
+
+  TheDebuginatorQueue* queue = debuginator_queue_create( 0, allocate_func, deallocate_func, userdata );
+  debuginator_queue__start_publishing( queue, debuginator, changes, num_slots );
+  return queue;
+#else
+  return NULL;
+#endif
+}
+
+TheDebuginatorQueue*
+debuginator_queue_create_shared_changes( struct TheDebuginator*        debuginator,
+                                         const char*                   name,
+                                         int                           capacity,
+                                         DebuginatorQueueAllocateFunc  allocate_func,
+                                         DebuginatorQueueDellocateFunc deallocate_func,
+                                         void*                         userdata ) {
+  (void)debuginator;
+  (void)name;
+  (void)capacity;
+  (void)allocate_func;
+  (void)deallocate_func;
+  (void)userdata;
+#if defined( DEBUGINATOR_QUEUE_SHARED_MEMORY ) && defined( DEBUGINATOR_QUEUE_CAN_PROCEES )
+  unsigned int num_slots = debuginator_queue__power_of_two( capacity, 16 );
+  int bytes = (int)( sizeof( DebuginatorQueueChanges ) + num_slots * sizeof( DebuginatorQueueChangeSlot ) );
+  TheDebuginatorQueue* queue =
+    debuginator_queue__create_mapped( name, bytes, allocate_func, deallocate_func, userdata );
+  if ( queue == NULL ) {
+    return NULL;
+  }
+
+  debuginator_queue__start_publishing(
+    queue, debuginator, (DebuginatorQueueChanges*)queue->shared_memory, num_slots );
+  return queue;
+#else
+  return NULL;
+#endif
+}
+
+TheDebuginatorQueue*
+debuginator_queue_open_shared_changes( const char*                   name,
+                                       DebuginatorQueueAllocateFunc  allocate_func,
+                                       DebuginatorQueueDellocateFunc deallocate_func,
+                                       void*                         userdata ) {
+  (void)name;
+  (void)allocate_func;
+  (void)deallocate_func;
+  (void)userdata;
+#ifdef DEBUGINATOR_QUEUE_SHARED_MEMORY
+  TheDebuginatorQueue* queue =
+    debuginator_queue__create_mapped( name, 0, allocate_func, deallocate_func, userdata );
+  if ( queue == NULL ) {
+    return NULL;
+  }
+
+  DebuginatorQueueChanges* changes = (DebuginatorQueueChanges*)queue->shared_memory;
+  if ( queue->shared_bytes < (int)sizeof( DebuginatorQueueChanges ) ||
+       DEBUGINATOR_QUEUE_atomic_load( &changes->magic ) != DEBUGINATOR_QUEUE_SHARED_MAGIC ||
+       changes->capacity == 0 || ( changes->capacity & ( changes->capacity - 1 ) ) != 0 ||
+       sizeof( DebuginatorQueueChanges ) + changes->capacity * sizeof( DebuginatorQueueChangeSlot ) >
+         (unsigned int)queue->shared_bytes ) {
+    debuginator_queue_destroy( queue );
+    return NULL;
+  }
+
+  queue->changes = changes;
+  return queue;
+#else
+  return NULL;
+#endif
+}
+
+void
+debuginator_queue_init_change_reader( TheDebuginatorQueue* queue, DebuginatorQueueChangeReader* reader ) {
+  reader->read = DEBUGINATOR_QUEUE_atomic_load( &queue->changes->written );
+  reader->lost = 0;
+}
+
+int
+debuginator_queue_read_changes( TheDebuginatorQueue*          queue,
+                                DebuginatorQueueChangeReader* reader,
+                                DebuginatorQueueChangeEvent*  events,
+                                int                           max_events ) {
+  DebuginatorQueueChanges*    changes = queue->changes;
+  DebuginatorQueueChangeSlot* slots   = debuginator_queue__change_slots( changes );
+  unsigned int                written = DEBUGINATOR_QUEUE_atomic_load( &changes->written );
+  if ( written - reader->read > changes->capacity ) {
+    reader->lost += (int)( written - reader->read - changes->capacity );
+    reader->read = written - changes->capacity;
+  }
+
+  int num_events = 0;
+  while ( reader->read != written && num_events < max_events ) {
+    DebuginatorQueueChangeSlot* slot     = &slots[reader->read & ( changes->capacity - 1 )];
+    unsigned int                sequence = DEBUGINATOR_QUEUE_atomic_load( &slot->sequence );
+    events[num_events]                   = slot->event;
+    DEBUGINATOR_QUEUE_atomic_fence();
+
+    // If it changed, it was overwritten while it was being copied.
+    if ( sequence == reader->read + 1 && DEBUGINATOR_QUEUE_atomic_load( &slot->sequence ) == sequence ) {
+      ++num_events;
+    }
+    else {
+      ++reader->lost;
+    }
+
+    ++reader->read;
+  }
+
+  return num_events;
+}
+
+void
+debuginator_queue_destroy( TheDebuginatorQueue* queue ) {
+  if ( queue->shared_bytes > 0 ) {
+#ifdef DEBUGINATOR_QUEUE_SHARED_MEMORY
+    debuginator_queue__unmap_shared( queue );
+#endif
+  }
+  else if ( queue->ring != NULL ) {
+    queue->deallocate( queue->userdata, queue->ring );
+  }
+  else if ( queue->changes != NULL ) {
+    queue->deallocate( queue->userdata, queue->changes );
+  }
+
+#ifdef DEBUGINATOR_QUEUE_CAN_PROCEES
+  if ( queue->debuginator != NULL && queue->debuginator->item_changed_listener_userdata == queue ) {
+    debuginator_set_item_changed_listener( queue->debuginator, NULL, NULL );
+  }
+#endif
+  queue->deallocate( queue->userdata, queue->buffers[0].data );
+  if ( queue->buffers[1].data != NULL ) {
+    queue->deallocate( queue->userdata, queue->buffers[1].data );
+  }
+  queue->deallocate( queue->userdata, queue );
+}
+
 #endif // DEBUGINATOR_QUEUE_IMPLEMENTATION
 
 #ifndef DEBUGINATOR_ENABLE_WARNINGS
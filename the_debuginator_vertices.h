@@ -0,0 +1,273 @@
+/*
+the_debuginator_vertices.h - v0.01 - public domain - Anders Elfgren @srekel, 2018
+
+# THE DEBUGINATOR VERTICES
+
+Turns a frame's draw commands into one vertex and index buffer, so the whole menu can be
+drawn with a single draw call and a single texture.
+
+See github for latest version: https://github.com/Srekel/the-debuginator
+
+## Usage
+
+In *ONE* source file, put:
+
+```C
+#define DEBUGINATOR_VERTICES_IMPLEMENTATION
+
+#include "the_debuginator.h"
+#include "the_debuginator_vertices.h"
+```
+
+Other source files should just include the_debuginator_vertices.h
+
+Give The Debuginator a draw command buffer (see debuginator_set_draw_command_buffer), and
+after debuginator_draw, call debuginator_vertices_build with it. You provide the glyph metrics
+of your font texture, in the style of stb_truetype's baked characters, and a texel in it
+that's opaque white, which the rects use.
+
+Every rect and glyph becomes a quad of four vertices and six indices, in the order they
+were drawn. Vertices are in screen space, y down, same as the draw callbacks.
+
+Images can't share the texture, so they're left alone. Draw them yourself with
+debuginator_vertices_image_count and the command buffer, after the vertices.
+
+debuginator_vertices_text_size measures text with the same glyphs, which is handy for
+TheDebuginatorConfig's text_size callback.
+
+## License
+
+Basically Public Domain / MIT.
+See end of file for license information.
+
+*/
+
+#ifndef INCLUDE_THE_DEBUGINATOR_VERTICES_H
+#define INCLUDE_THE_DEBUGINATOR_VERTICES_H
+
+#include "the_debuginator.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef struct DebuginatorGlyph {
+	float advance;
+	float x0, y0, x1, y1; // Relative to the pen position on the baseline, y down
+	float u0, v0, u1, v1;
+} DebuginatorGlyph;
+
+typedef struct DebuginatorGlyphFont {
+	const DebuginatorGlyph* glyphs;
+	int first_char;
+	int num_glyphs;     // Characters outside of the range are skipped
+	float ascent;       // From the top of a line to the baseline
+	float line_height;
+} DebuginatorGlyphFont;
+
+typedef struct DebuginatorVertexFonts {
+	// Indexed by DebuginatorDrawType, like the theme's fonts. Text drawn with a NULL font
+	// is skipped.
+	const DebuginatorGlyphFont* fonts[DEBUGINATOR_NumDrawTypes];
+	float white_u;
+	float white_v;
+} DebuginatorVertexFonts;
+
+typedef struct DebuginatorVertex {
+	float x;
+	float y;
+	float u;
+	float v;
+	DebuginatorColor color;
+} DebuginatorVertex;
+
+// Owned by the application. Cleared by debuginator_vertices_build. If it runs out of space
+// the rest of the frame is dropped and overflowed is set.
+typedef struct DebuginatorVertexBuffer {
+	DebuginatorVertex* vertices;
+	int vertices_capacity;
+	int vertex_count;
+
+	unsigned int* indices;
+	int indices_capacity;
+	int index_count;
+
+	bool overflowed;
+} DebuginatorVertexBuffer;
+
+// Returns false if the vertex buffer overflowed.
+bool debuginator_vertices_build(const DebuginatorDrawCommandBuffer* commands, const DebuginatorVertexFonts* fonts, DebuginatorVertexBuffer* buffer);
+
+// The number of image commands, which debuginator_vertices_build skips.
+int debuginator_vertices_image_count(const DebuginatorDrawCommandBuffer* commands);
+
+// Width of the text, and the font's line height.
+DebuginatorVector2 debuginator_vertices_text_size(const DebuginatorGlyphFont* font, const char* text);
+
+#ifdef __cplusplus
+}
+#endif
+
+#ifdef DEBUGINATOR_VERTICES_IMPLEMENTATION
+
+#include <stddef.h>
+
+static bool debuginator_vertices__push_quad(DebuginatorVertexBuffer* buffer, float x0, float y0, float x1, float y1, float u0, float v0, float u1, float v1, DebuginatorColor color) {
+	if (buffer->vertex_count + 4 > buffer->vertices_capacity || buffer->index_count + 6 > buffer->indices_capacity) {
+		buffer->overflowed = true;
+		return false;
+	}
+
+	DebuginatorVertex* vertex = &buffer->vertices[buffer->vertex_count];
+	vertex[0].x = x0; vertex[0].y = y0; vertex[0].u = u0; vertex[0].v = v0; vertex[0].color = color;
+	vertex[1].x = x1; vertex[1].y = y0; vertex[1].u = u1; vertex[1].v = v0; vertex[1].color = color;
+	vertex[2].x = x1; vertex[2].y = y1; vertex[2].u = u1; vertex[2].v = v1; vertex[2].color = color;
+	vertex[3].x = x0; vertex[3].y = y1; vertex[3].u = u0; vertex[3].v = v1; vertex[3].color = color;
+
+	unsigned int first = (unsigned int)buffer->vertex_count;
+	unsigned int* index = &buffer->indices[buffer->index_count];
+	index[0] = first;
+	index[1] = first + 1;
+	index[2] = first + 2;
+	index[3] = first;
+	index[4] = first + 2;
+	index[5] = first + 3;
+
+	buffer->vertex_count += 4;
+	buffer->index_count += 6;
+	return true;
+}
+
+static const DebuginatorGlyph* debuginator_vertices__glyph(const DebuginatorGlyphFont* font, char c) {
+	int glyph_index = (int)(unsigned char)c - font->first_char;
+	if (glyph_index < 0 || glyph_index >= font->num_glyphs) {
+		return NULL;
+	}
+
+	return &font->glyphs[glyph_index];
+}
+
+// Text is positioned like with the draw_text callback: x is where it starts and y is the
+// middle of the line.
+static bool debuginator_vertices__push_text(DebuginatorVertexBuffer* buffer, const DebuginatorGlyphFont* font, const char* text, DebuginatorVector2 position, DebuginatorColor color) {
+	float pen_x = position.x;
+	float baseline = position.y - font->line_height / 2 + font->ascent;
+	for (const char* c = text; *c != '\0'; ++c) {
+		const DebuginatorGlyph* glyph = debuginator_vertices__glyph(font, *c);
+		if (glyph == NULL) {
+			continue;
+		}
+
+		// Spaces and such have no quad.
+		if (glyph->x1 > glyph->x0 && glyph->y1 > glyph->y0) {
+			if (!debuginator_vertices__push_quad(buffer,
+				pen_x + glyph->x0, baseline + glyph->y0, pen_x + glyph->x1, baseline + glyph->y1,
+				glyph->u0, glyph->v0, glyph->u1, glyph->v1, color)) {
+				return false;
+			}
+		}
+
+		pen_x += glyph->advance;
+	}
+
+	return true;
+}
+
+bool debuginator_vertices_build(const DebuginatorDrawCommandBuffer* commands, const DebuginatorVertexFonts* fonts, DebuginatorVertexBuffer* buffer) {
+	buffer->vertex_count = 0;
+	buffer->index_count = 0;
+	buffer->overflowed = false;
+
+	for (int i = 0; i < commands->command_count; i++) {
+		const DebuginatorDrawCommand* command = &commands->commands[i];
+		switch (command->type) {
+			case DEBUGINATOR_DrawCommandRect:
+				debuginator_vertices__push_quad(buffer,
+					command->position.x, command->position.y,
+					command->position.x + command->size.x, command->position.y + command->size.y,
+					fonts->white_u, fonts->white_v, fonts->white_u, fonts->white_v, command->color);
+				break;
+			case DEBUGINATOR_DrawCommandText: {
+				const DebuginatorGlyphFont* font = fonts->fonts[command->font];
+				if (font != NULL) {
+					debuginator_vertices__push_text(buffer, font, commands->strings + command->data.text.offset, command->position, command->color);
+				}
+			} break;
+			case DEBUGINATOR_DrawCommandImage:
+				break;
+		}
+
+		if (buffer->overflowed) {
+			return false;
+		}
+	}
+
+	return true;
+}
+
+int debuginator_vertices_image_count(const DebuginatorDrawCommandBuffer* commands) {
+	int count = 0;
+	for (int i = 0; i < commands->command_count; i++) {
+		count += commands->commands[i].type == DEBUGINATOR_DrawCommandImage ? 1 : 0;
+	}
+	return count;
+}
+
+DebuginatorVector2 debuginator_vertices_text_size(const DebuginatorGlyphFont* font, const char* text) {
+	DebuginatorVector2 size;
+	size.x = 0;
+	size.y = font->line_height;
+	for (const char* c = text; *c != '\0'; ++c) {
+		const DebuginatorGlyph* glyph = debuginator_vertices__glyph(font, *c);
+		if (glyph != NULL) {
+			size.x += glyph->advance;
+		}
+	}
+	return size;
+}
+
+#endif // DEBUGINATOR_VERTICES_IMPLEMENTATION
+
+#endif // INCLUDE_THE_DEBUGINATOR_VERTICES_H
+
+/*
+------------------------------------------------------------------------------
+This software is available under 2 licenses -- choose whichever you prefer.
+------------------------------------------------------------------------------
+ALTERNATIVE A - MIT License
+Copyright (c) 2017 Anders Elfgren
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to
+use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+of the Software, and to permit persons to whom the Software is furnished to do
+so, subject to the following conditions:
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+------------------------------------------------------------------------------
+ALTERNATIVE B - Public Domain (www.unlicense.org)
+This is free and unencumbered software released into the public domain.
+Anyone is free to copy, modify, publish, use, compile, sell, or distribute this
+software, either in source code form or as a compiled binary, for any purpose,
+commercial or non-commercial, and by any means.
+In jurisdictions that recognize copyright laws, the author or authors of this
+software dedicate any and all copyright interest in the software to the public
+domain. We make this dedication for the benefit of the public at large and to
+the detriment of our heirs and successors. We intend this dedication to be an
+overt act of relinquishment in perpetuity of all present and future rights to
+this software under copyright law.
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN
+ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+------------------------------------------------------------------------------
+*/